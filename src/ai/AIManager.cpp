@@ -4,29 +4,223 @@
 #include "../entities/Player.h"
 #include "../collisions/CollisionManager.h"
 #include "../core/Logger.h"
+#include "../core/ThreadPool.h"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
 
 namespace ai {
 
 AIManager::AIManager(const CoordinationConfig& config)
     : coordinationConfig_(config)
+    , navGridReady_(false)
+    , pathCache_(config.pathCache)
+    , pathQueue_(config.pathQueue)
+    , perceptionBatch_(config.perceptionBatch)
+    , perceptionMemory_(config.perceptionMemory)
+    , visibilityTableFromCache_(false)
+    , soundPropagation_(config.soundPropagation)
+    , agentGrid_(config.agentGrid)
+    , lodScheduler_(config.lod)
+    , lodFocus_(nullptr)
+    , player_(nullptr)
+    , playerPinned_(false)
+    , playerId_(0)
+    , playerScanCount_(static_cast<std::size_t>(-1))
+    , blackboard_(config.blackboard)
+    , coordinationTime_(0.0f)
     , coordinationUpdateTimer_(0.0f)
+    , agentProfiler_(config.profiler)
     , performanceUpdateTimer_(0.0f)
+    , fixedStepClock_(config.deterministic)
+    , stateHash_(StateHash::kOffsetBasis)
 {
+    pathQueue_.setConfig(pathQueueConfig());
+    pathQueue_.setPathCache(config.enablePathCache ? &pathCache_ : nullptr);
+    configureThreadPool();
 }
 
 AIManager::~AIManager() = default;
 
+void AIManager::configureThreadPool() {
+    std::size_t workers = coordinationConfig_.workerThreads < 0
+        ? core::ThreadPool::defaultWorkerCount()
+        : static_cast<std::size_t>(coordinationConfig_.workerThreads);
+    if (threadPool_ && threadPool_->workerCount() == workers) return;
+    
+    threadPool_.reset(workers > 0 ? new core::ThreadPool(workers) : nullptr);
+    perceptionBatch_.setThreadPool(threadPool_.get());
+    enemyPipeline_.setThreadPool(threadPool_.get());
+    if (workers > 0) {
+        core::Logger::instance().info("[AI] AIManager using " + std::to_string(workers) + " worker threads");
+    }
+}
+
+void AIManager::setCoordinationConfig(const CoordinationConfig& config) {
+    coordinationConfig_ = config;
+    pathQueue_.setConfig(pathQueueConfig());
+    pathCache_.setConfig(config.pathCache);
+    pathQueue_.setPathCache(config.enablePathCache ? &pathCache_ : nullptr);
+    perceptionBatch_ = PerceptionBatch(config.perceptionBatch);
+    if (agents_.empty()) {
+        // Ring size is fixed while agents hold blocks
+        perceptionMemory_ = PerceptionMemory(config.perceptionMemory);
+    }
+    lodScheduler_.setConfig(config.lod);
+    agentGrid_.setConfig(config.agentGrid);
+    soundPropagation_.setConfig(config.soundPropagation);
+    blackboard_.setConfig(config.blackboard);
+    agentProfiler_.setConfig(config.profiler);
+    fixedStepClock_.setConfig(config.deterministic);
+    perceptionBatch_.setVisibilityTable(visibilityTable_.empty() ? nullptr : &visibilityTable_);
+    perceptionBatch_.setThreadPool(threadPool_.get());
+    configureThreadPool();
+    for (auto& agent : agents_) {
+        attachNavigation(agent.get());
+    }
+}
+
+PathRequestQueueConfig AIManager::pathQueueConfig() const {
+    PathRequestQueueConfig config = coordinationConfig_.pathQueue;
+    if (coordinationConfig_.deterministic.enabled) {
+        // A wall-clock budget searches a different amount every run
+        config.frameBudgetMicroseconds = std::numeric_limits<int>::max();
+        if (config.maxExpansionsPerFrame <= 0) {
+            config.maxExpansionsPerFrame = std::max(coordinationConfig_.deterministic.pathExpansionsPerStep, 1);
+        }
+    }
+    return config;
+}
+
+void AIManager::rebuildNavGrid(const collisions::CollisionManager* collisionManager, const NavGridConfig& config) {
+    navGrid_.rebuild(collisionManager, config);
+    navGridReady_ = !navGrid_.empty();
+    pathQueue_.setNavGrid(navGridReady_ ? &navGrid_ : nullptr);
+    soundPropagation_.setGrid(navGridReady_ ? &navGrid_ : nullptr);
+    
+    for (auto& agent : agents_) {
+        attachNavigation(agent.get());
+    }
+}
+
+void AIManager::buildNavMesh(const collisions::CollisionManager* collisionManager, const NavMeshConfig& config) {
+    navMesh_.build(collisionManager, config);
+    for (auto& agent : agents_) {
+        attachNavigation(agent.get());
+    }
+}
+
+bool AIManager::loadNavMesh(const std::string& path) {
+    bool loaded = navMesh_.loadFromFile(path);
+    for (auto& agent : agents_) {
+        attachNavigation(agent.get());
+    }
+    return loaded;
+}
+
+bool AIManager::loadBehaviorTree(const std::string& name, const std::string& path) {
+    BehaviorTree tree;
+    if (!tree.loadFromFile(path)) return false;
+    installBehaviorTree(name, std::move(tree));
+    return true;
+}
+
+bool AIManager::loadBehaviorTreeFromString(const std::string& name, const std::string& data) {
+    BehaviorTree tree;
+    if (!tree.loadFromString(data)) return false;
+    installBehaviorTree(name, std::move(tree));
+    return true;
+}
+
+const BehaviorTree* AIManager::getBehaviorTree(const std::string& name) const {
+    auto it = behaviorTrees_.find(name);
+    return it != behaviorTrees_.end() ? it->second.get() : nullptr;
+}
+
+void AIManager::installBehaviorTree(const std::string& name, BehaviorTree&& tree) {
+    // Reloads keep the tree's address, agents only get a fresh blackboard
+    auto& slot = behaviorTrees_[name];
+    if (!slot) slot = std::make_unique<BehaviorTree>();
+    *slot = std::move(tree);
+    for (auto& agent : agents_) {
+        if (agent->getConfig().behaviorTree == name) {
+            attachBehaviorTree(agent.get());
+        }
+    }
+    core::Logger::instance().info("[AI] Behavior tree '" + name + "' ready (" +
+                                  std::to_string(slot->nodeCount()) + " nodes)");
+}
+
+void AIManager::buildVisibilityTable(const collisions::CollisionManager* collisionManager,
+                                     const VisibilityTableConfig& config, const std::string& cachePath) {
+    bool loaded = false;
+    if (!cachePath.empty() && visibilityTable_.loadFromFile(cachePath)) {
+        loaded = visibilityTable_.isCurrent(collisionManager, config);
+        if (!loaded) {
+            core::Logger::instance().info("[AI] VisibilityTable cache is stale, rebuilding");
+        }
+    }
+    if (!loaded) {
+        // Baked from the wall shapes, so only cells a wall covers completely prove Hidden
+        visibilityTable_ = VisibilityTable(config);
+        visibilityTable_.build(collisionManager);
+        if (!cachePath.empty()) {
+            visibilityTable_.saveToFile(cachePath);
+        }
+    }
+    visibilityTableFromCache_ = loaded;
+
+    const VisibilityTable* table = visibilityTable_.empty() ? nullptr : &visibilityTable_;
+    perceptionBatch_.setVisibilityTable(table);
+    for (auto& agent : agents_) {
+        attachNavigation(agent.get());
+    }
+    enemyPipeline_.setVisibilityTable(table);
+}
+
+const SoundPropagation* AIManager::activeSoundPropagation() const {
+    return coordinationConfig_.propagateSound && soundPropagation_.ready() ? &soundPropagation_ : nullptr;
+}
+
+void AIManager::attachNavigation(AIAgent* agent) {
+    if (!agent) return;
+    bool useQueue = coordinationConfig_.asyncPathfinding && navGridReady_;
+    agent->setPathRequestQueue(useQueue ? &pathQueue_ : nullptr);
+    agent->setNavGrid(navGridReady_ ? &navGrid_ : nullptr);
+    agent->setNavMesh(navMesh_.empty() ? nullptr : &navMesh_);
+    agent->setVisibilityTable(visibilityTable_.empty() ? nullptr : &visibilityTable_);
+    agent->setSoundPropagation(activeSoundPropagation());
+}
+
+void AIManager::attachBehaviorTree(AIAgent* agent) {
+    const std::string& name = agent->getConfig().behaviorTree;
+    if (name.empty()) return;
+    const BehaviorTree* tree = getBehaviorTree(name);
+    if (!tree) {
+        core::Logger::instance().warning("[AI] Behavior tree '" + name + "' not loaded, using profile rules");
+    }
+    agent->setBehaviorTree(tree);
+}
+
 void AIManager::addAgent(entities::Entity* entity, const AIAgentConfig& agentConfig) {
     if (!entity) return;
     
     // Remove existing agent if present
     removeAgent(entity);
     
-    // Create new agent
+    // Create new agent; its alerts go through the manager's broadcast grid
     auto agent = std::make_unique<AIAgent>(entity, agentConfig);
-    agents_[entity] = std::move(agent);
+    attachNavigation(agent.get());
+    attachBehaviorTree(agent.get());
+    agent->setPerceptionMemory(&perceptionMemory_);
+    agent->setTargetIndex(&targetIndex_);
+    agent->seedRandom(coordinationConfig_.deterministic.seed ^ (entity->id() * 0x9E3779B9u));
+    agent->setAlertCallback([this](const sf::Vector2f& position, float radius, entities::Entity* source) {
+        alertAgentsInRadius(position, radius, source);
+    });
+    agentIndex_[entity] = agents_.size();
+    agents_.push_back(std::move(agent));
     
     // Update active agents list
     updateActiveAgentsList();
@@ -38,9 +232,17 @@ void AIManager::addAgent(entities::Entity* entity, const AIAgentConfig& agentCon
 }
 
 void AIManager::removeAgent(entities::Entity* entity) {
-    auto it = agents_.find(entity);
-    if (it != agents_.end()) {
-        agents_.erase(it);
+    auto it = agentIndex_.find(entity);
+    if (it != agentIndex_.end()) {
+        // Keep insertion order so update and broadcast order stay deterministic
+        std::size_t index = it->second;
+        lodScheduler_.forget(agents_[index].get());
+        agentIndex_.erase(it);
+        blackboard_.releaseFlank(entity->id());
+        agents_.erase(agents_.begin() + static_cast<std::ptrdiff_t>(index));
+        for (std::size_t i = index; i < agents_.size(); ++i) {
+            agentIndex_[agents_[i]->getEntity()] = i;
+        }
         updateActiveAgentsList();
         
         // Update performance metrics immediately for testing consistency
@@ -51,14 +253,19 @@ void AIManager::removeAgent(entities::Entity* entity) {
 }
 
 AIAgent* AIManager::getAgent(entities::Entity* entity) {
-    auto it = agents_.find(entity);
-    return it != agents_.end() ? it->second.get() : nullptr;
+    auto it = agentIndex_.find(entity);
+    return it != agentIndex_.end() ? agents_[it->second].get() : nullptr;
 }
 
 void AIManager::clearAllAgents() {
     agents_.clear();
+    agentIndex_.clear();
     activeAgents_.clear();
-    legacyEnemies_.clear();
+    enemyPipeline_.clear();
+    playerScanCount_ = static_cast<std::size_t>(-1);
+    lodScheduler_.clear();
+    agentGrid_.invalidate();
+    blackboard_.clear();
     
     // Update performance metrics immediately for testing consistency
     updatePerformanceMetrics();
@@ -67,51 +274,201 @@ void AIManager::clearAllAgents() {
 }
 
 void AIManager::addEnemyPointer(Enemy* enemy) {
-    if (enemy && std::find(legacyEnemies_.begin(), legacyEnemies_.end(), enemy) == legacyEnemies_.end()) {
-        legacyEnemies_.push_back(enemy);
-    }
+    enemyPipeline_.addEnemyPointer(enemy);
 }
 
 void AIManager::removeEnemyPointer(Enemy* enemy) {
-    auto it = std::find(legacyEnemies_.begin(), legacyEnemies_.end(), enemy);
-    if (it != legacyEnemies_.end()) {
-        legacyEnemies_.erase(it);
+    enemyPipeline_.removeEnemyPointer(enemy);
+}
+
+void AIManager::setPlayer(entities::Player* player) {
+    player_ = player;
+    playerPinned_ = player != nullptr;
+    playerScanCount_ = static_cast<std::size_t>(-1);
+}
+
+entities::Player* AIManager::cachedPlayer(entities::EntityManager* entityManager) {
+    if (playerPinned_ || !entityManager) return player_;
+    // Still registered under its id: the cached pointer is valid
+    if (player_ && entityManager->getEntity(playerId_) == player_) return player_;
+    // The type lookup dynamic_casts every entity: without a player only repeat
+    // it when the population changes
+    std::size_t count = entityManager->count();
+    if (player_ || count != playerScanCount_) {
+        auto players = entityManager->getEntitiesOfType<entities::Player>();
+        player_ = players.empty() ? nullptr : players[0];
+        playerId_ = player_ ? player_->id() : 0;
+        playerScanCount_ = count;
     }
+    return player_;
 }
 
 void AIManager::updateAll(float deltaTime, entities::EntityManager* entityManager, 
                          collisions::CollisionManager* collisionManager) {
+    if (!coordinationConfig_.deterministic.enabled) {
+        runTick(deltaTime, entityManager, collisionManager);
+        return;
+    }
     
+    int ticks = fixedStepClock_.advance(deltaTime);
+    for (int tick = 0; tick < ticks; ++tick) {
+        runTick(fixedStepClock_.step(), entityManager, collisionManager);
+        recordStateHash();
+    }
+}
+
+void AIManager::recordStateHash() {
+    // Agents in insertion order, the same order every tick updates them in
+    StateHash hash;
+    std::uint64_t step = stateHashes_.empty() ? 1 : stateHashes_.back().step + 1;
+    hash.add(step);
+    for (const auto& agent : agents_) {
+        agent->hashState(hash);
+    }
+    // Then the enemy pipeline, in registration order
+    for (const Enemy* enemy : enemyPipeline_.enemies()) {
+        enemy->hashState(hash);
+    }
+    hash.add(blackboard_.latestVersion());
+    hash.add(pathQueue_.getStats().pending);
+    stateHash_ = hash.value();
+    
+    std::size_t history = coordinationConfig_.deterministic.hashHistory;
+    if (history == 0) {
+        stateHashes_.clear();
+        stateHashes_.push_back({step, stateHash_});
+        return;
+    }
+    stateHashes_.push_back({step, stateHash_});
+    if (stateHashes_.size() > history) {
+        // Drop the older half at once so trimming stays amortized
+        stateHashes_.erase(stateHashes_.begin(),
+                           stateHashes_.begin() + static_cast<std::ptrdiff_t>(stateHashes_.size() / 2));
+    }
+}
+
+void AIManager::runTick(float deltaTime, entities::EntityManager* entityManager,
+                        collisions::CollisionManager* collisionManager) {
     auto startTime = std::chrono::high_resolution_clock::now();
+    // Stage timer: milliseconds since the previous lap
+    auto lapStart = startTime;
+    auto lap = [&lapStart]() {
+        auto now = std::chrono::high_resolution_clock::now();
+        float ms = std::chrono::duration_cast<std::chrono::microseconds>(now - lapStart).count() / 1000.0f;
+        lapStart = now;
+        return ms;
+    };
+    
+    // Entities moved outside EntityManager::updateAll (player input, scripted
+    // moves) since the last tick: refresh the perception grid once per tick
+    if (entityManager) {
+        entityManager->invalidateSpatialIndex();
+    }
+    
+    // Age sound fields before this tick's perception samples them
+    soundPropagation_.update(deltaTime);
+    coordinationTime_ += deltaTime;
+    blackboard_.setTime(coordinationTime_);
     
     // Update coordination system
     if (coordinationConfig_.enableCoordination) {
         updateCoordination(deltaTime);
     }
     
-    // Update all AI agents
-    for (auto* agent : activeAgents_) {
-        if (agent) {
-            agent->update(deltaTime, entityManager, collisionManager);
+    // LOD: pick this frame's full, low-detail and skipped agents
+    entities::Player* player = cachedPlayer(entityManager);
+    const entities::Entity* focusEntity = lodFocus_ ? lodFocus_ : player;
+    sf::Vector2f focusPosition = focusEntity ? focusEntity->position() : sf::Vector2f(0.f, 0.f);
+    const auto& lodTasks = lodScheduler_.schedule(activeAgents_, focusEntity ? &focusPosition : nullptr, deltaTime);
+    
+    fullUpdateAgents_.clear();
+    for (const auto& task : lodTasks) {
+        if (task.kind == LODScheduler::UpdateKind::Full) fullUpdateAgents_.push_back(task.agent);
+    }
+    lap();  // Coordination and scheduling only count towards the total
+    
+    // Perception for all fully updated agents in one sweep; each consumes its ring slot
+    if (coordinationConfig_.batchedPerception && entityManager) {
+        perceptionBatch_.setSoundPropagation(activeSoundPropagation());
+        perceptionBatch_.run(fullUpdateAgents_, entityManager, collisionManager);
+        for (std::size_t i = 0; i < fullUpdateAgents_.size(); ++i) {
+            fullUpdateAgents_[i]->ingestPerception(perceptionBatch_, i);
         }
     }
+    performanceMetrics_.perceptionTime = lap();
     
-            // Update legacy enemies for backward compatibility
-    for (auto* enemy : legacyEnemies_) {
-        if (enemy && enemy->isActive()) {
-            // Assuming enemy has an update method that takes player position
-            // This maintains backward compatibility
-            if (entityManager) {
-                auto players = entityManager->getEntitiesOfType<entities::Player>();
-                if (!players.empty()) {
-                    enemy->update(deltaTime, players[0]->position());
-                } else {
-                    enemy->update(deltaTime);
-                }
-            } else {
-                enemy->update(deltaTime);
+    // Think phase: perception and decisions only read the world and write
+    // each agent's own intent, so full updates run in parallel. The spatial
+    // index is rebuilt up front so concurrent radius queries never mutate it.
+    if (entityManager) {
+        entityManager->updateSpatialIndex();
+    }
+    auto thinkRange = [this, &lodTasks, entityManager, collisionManager](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& task = lodTasks[i];
+            if (task.kind == LODScheduler::UpdateKind::Full) {
+                task.agent->think(task.deltaTime, entityManager, collisionManager);
             }
         }
+    };
+    if (threadPool_) {
+        threadPool_->parallelFor(lodTasks.size(), thinkRange);
+    } else {
+        thinkRange(0, lodTasks.size());
+    }
+    
+    // Commit phase, serial: decisions are applied in task order (state changes,
+    // alerts), then each state's behavior runs as one batch (path queries touch
+    // the shared queue, cache and navmesh) and all movement requests are
+    // integrated together. Low-detail ticks only contribute their movement.
+    stateBuckets_.clear();
+    for (const auto& task : lodTasks) {
+        switch (task.kind) {
+            case LODScheduler::UpdateKind::Full:
+                if (task.agent->applyDecision(task.deltaTime)) {
+                    stateBuckets_.add(task.agent, task.deltaTime);
+                }
+                break;
+            case LODScheduler::UpdateKind::LowDetail:
+                task.agent->executeLowDetail(task.deltaTime);
+                stateBuckets_.addMover(task.agent, task.deltaTime);
+                break;
+            case LODScheduler::UpdateKind::Skip:
+                break;
+        }
+    }
+    performanceMetrics_.decisionTime = lap();
+    stateBuckets_.executeStates(collisionManager);
+    performanceMetrics_.behaviorTime = lap();
+    stateBuckets_.integrateMovement();
+    
+    // Positions are final for this frame: refresh the broadcast grid
+    agentGrid_.rebuild(activeAgents_);
+    performanceMetrics_.movementTime = lap();
+    
+    // Rank this frame's agent ticks; kept out of the stage timings
+    agentProfiler_.recordFrame(fullUpdateAgents_);
+    lap();
+    
+    const LODScheduler::Stats& lodStats = lodScheduler_.getStats();
+    performanceMetrics_.lodFullUpdates = lodStats.fullUpdates;
+    performanceMetrics_.lodLowDetailUpdates = lodStats.lowDetailUpdates;
+    performanceMetrics_.lodSkippedUpdates = lodStats.skipped;
+    
+    // Run queued path searches within the frame budget; results are collected next tick
+    pathQueue_.process();
+    performanceMetrics_.pathfindingTime = lap();
+    performanceMetrics_.pendingPathRequests = pathQueue_.getStats().pending;
+    performanceMetrics_.pathQueueTime = pathQueue_.getStats().lastFrameMicroseconds / 1000.0f;
+    const PathCache::Stats& cacheStats = pathCache_.getStats();
+    performanceMetrics_.pathCacheHits = cacheStats.hits + cacheStats.partialHits;
+    performanceMetrics_.pathCacheMisses = cacheStats.misses;
+    
+    // Legacy enemies: the whole sense -> decide -> plan -> commit pipeline, once
+    if (!enemyPipeline_.enemies().empty()) {
+        enemyPipeline_.setPlayer(player);
+        enemyPipeline_.update(deltaTime, collisionManager);
+        performanceMetrics_.enemyPipelineTime = enemyPipeline_.getPipelineStats().totalTime;
     }
     
     // Update performance metrics
@@ -132,21 +489,74 @@ void AIManager::updateCoordination(float deltaTime) {
     if (coordinationUpdateTimer_ >= coordinationConfig_.coordinationUpdateInterval) {
         coordinationUpdateTimer_ = 0.0f;
         
-        // Update shared target information
+        // Publish targets; reports that barely moved are not changes
         if (coordinationConfig_.shareTargetInformation) {
             for (auto* agent : activeAgents_) {
                 if (!agent) continue;
                 
                 auto* primaryTarget = agent->getPrimaryTarget();
                 if (primaryTarget) {
-                    shareTargetInformation(primaryTarget, primaryTarget->position());
+                    blackboard_.postTargetPosition(primaryTarget, primaryTarget->position(), agent->getEntity()->id());
+                }
+            }
+        }
+        
+        // Drop stale targets and alert zones, then hand out what changed
+        blackboard_.expire();
+        deliverBlackboardChanges();
+        
+        const TeamBlackboard::Stats& boardStats = blackboard_.getStats();
+        performanceMetrics_.blackboardWrites = boardStats.writes;
+        performanceMetrics_.blackboardDeliveries = boardStats.delivered;
+    }
+}
+
+void AIManager::deliverBlackboardChanges() {
+    // Agents whose subscribed slots did not change since their cursor cost one comparison
+    const TeamBlackboard::Mask targetMask = TeamBlackboard::maskOf(TeamBlackboard::Slot::TargetPosition);
+    const float radiusSq = coordinationConfig_.alertRadius * coordinationConfig_.alertRadius;
+    // An agent is checked against standing targets when it crosses into a new
+    // cell, so it hears of one within a quarter radius of coming into range
+    const float cellSize = std::max(coordinationConfig_.alertRadius * 0.25f, 1.0f);
+    bool standingCollected = false;
+    for (auto* agent : activeAgents_) {
+        TeamBlackboard::Mask mask = agent->getConfig().blackboardSubscriptions;
+        TeamBlackboard::Version cursor = agent->getBlackboardCursor();
+        sf::Vector2f position = agent->getEntityPosition();
+        if (blackboard_.latestVersion(mask) > cursor) {
+            agent->setBlackboardCursor(blackboard_.changesSince(cursor, mask, blackboardChanges_));
+            for (const auto* entry : blackboardChanges_) {
+                if (entry->slot != TeamBlackboard::Slot::TargetPosition || !entry->active) continue;
+                if (!entry->entity || entry->entity == agent->getEntity()) continue;
+                sf::Vector2f offset = entry->position - position;
+                if (offset.x * offset.x + offset.y * offset.y <= radiusSq) {
+                    agent->addTarget(entry->entity, Priority::MEDIUM);
                 }
             }
         }
         
-        // Clean up old alerts
-        if (recentAlerts_.size() > 10) {
-            recentAlerts_.erase(recentAlerts_.begin(), recentAlerts_.begin() + 5);
+        // A target that stays put is never a change again, so an agent that
+        // walks up to it later would not hear of it
+        sf::Vector2i cell(static_cast<int>(std::floor(position.x / cellSize)),
+                          static_cast<int>(std::floor(position.y / cellSize)));
+        if (cell == agent->getBlackboardCell()) continue;
+        agent->setBlackboardCell(cell);
+        if (!(mask & targetMask)) continue;
+        if (!standingCollected) {
+            blackboard_.collect(TeamBlackboard::Slot::TargetPosition, standingTargets_);
+            standingCollected = true;
+        }
+        for (const auto* entry : standingTargets_) {
+            // Newer entries went through the change list above
+            if (entry->version > cursor || !entry->entity || entry->entity == agent->getEntity()) continue;
+            if (agent->getAllTargets().contains(entry->entity) || agent->droppedAfter(entry->entity, entry->version)) {
+                continue;
+            }
+            sf::Vector2f offset = entry->position - position;
+            if (offset.x * offset.x + offset.y * offset.y <= radiusSq) {
+                agent->addTarget(entry->entity, Priority::MEDIUM);
+                ++performanceMetrics_.blackboardHandoffs;
+            }
         }
     }
 }
@@ -154,27 +564,31 @@ void AIManager::updateCoordination(float deltaTime) {
 void AIManager::updateActiveAgentsList() {
     activeAgents_.clear();
     
-    for (auto& pair : agents_) {
-        if (pair.second && pair.first && pair.first->isActive()) {
-            activeAgents_.push_back(pair.second.get());
+    for (auto& agent : agents_) {
+        if (agent && agent->getEntity() && agent->getEntity()->isActive()) {
+            activeAgents_.push_back(agent.get());
         }
     }
+    agentGrid_.invalidate();
 }
 
 void AIManager::alertAgentsInRadius(const sf::Vector2f& position, float radius, entities::Entity* source) {
     if (!coordinationConfig_.enableCoordination) return;
     
-    recentAlerts_.push_back(position);
+    blackboard_.postAlertZone(position, radius, source ? source->id() : 0);
     
     auto agentsInRange = getAgentsInRadius(position, radius);
     
+    int alerted = 0;
     for (auto* agent : agentsInRange) {
-        if (agent) {
+        // The source does not alert itself
+        if (agent && agent->getEntity() != source) {
             agent->onAlertReceived(position, source);
+            ++alerted;
         }
     }
     
-    core::Logger::instance().info("[AI] Alerted " + std::to_string(agentsInRange.size()) + 
+    core::Logger::instance().info("[AI] Alerted " + std::to_string(alerted) + 
                                 " agents at position (" + std::to_string(position.x) + 
                                 ", " + std::to_string(position.y) + ")");
 }
@@ -182,14 +596,7 @@ void AIManager::alertAgentsInRadius(const sf::Vector2f& position, float radius,
 void AIManager::shareTargetInformation(entities::Entity* target, const sf::Vector2f& lastKnownPosition) {
     if (!coordinationConfig_.shareTargetInformation || !target) return;
     
-    sharedTargetPositions_[target] = lastKnownPosition;
-    
-    // Notify nearby agents about the target
-    for (auto* agent : activeAgents_) {
-        if (agent) {
-            agent->addTarget(target, Priority::MEDIUM);
-        }
-    }
+    blackboard_.postTargetPosition(target, lastKnownPosition);
 }
 
 void AIManager::onEntityDamaged(entities::Entity* entity, float damage, entities::Entity* source) {
@@ -211,56 +618,54 @@ void AIManager::onEntityDied(entities::Entity* entity) {
     if (!entity) return;
     
     // Remove from shared targets
-    sharedTargetPositions_.erase(entity);
+    blackboard_.clearTarget(entity);
     
-    // Notify all agents that this entity died
-    for (auto* agent : activeAgents_) {
-        if (agent) {
-            agent->onEntityDied(entity);
-        }
+    // Notify only the agents holding it as a target
+    targetIndex_.holders(entity, targetHolders_);
+    for (auto* agent : targetHolders_) {
+        agent->onEntityDied(entity);
     }
     
     // Remove the agent if it was the dead entity
     removeAgent(entity);
     
-    core::Logger::instance().info("[AI] Entity " + std::to_string(entity->id()) + " died, notified all agents");
+    core::Logger::instance().info("[AI] Entity " + std::to_string(entity->id()) + " died, notified " +
+                                  std::to_string(targetHolders_.size()) + " agents");
 }
 
 void AIManager::onSoundMade(const sf::Vector2f& position, float intensity, entities::Entity* source) {
     if (!coordinationConfig_.enableCoordination) return;
     
-    float hearingRadius = intensity * 150.0f; // Scale intensity to radius
+    float hearingRadius = intensity * coordinationConfig_.soundPropagation.rangePerIntensity;
     auto agentsInRange = getAgentsInRadius(position, hearingRadius);
     
+    // With a nav grid the sound floods around walls and each listener hears
+    // the attenuated intensity at its cell; the field stays for perception
+    int fieldId = activeSoundPropagation() ? soundPropagation_.emit(position, intensity, source) : -1;
+    
+    int heard = 0;
     for (auto* agent : agentsInRange) {
-        if (agent) {
-            agent->onSoundHeard(position, intensity);
-        }
+        if (!agent || agent->getEntity() == source) continue;
+        float heardIntensity = fieldId >= 0
+            ? soundPropagation_.sampleField(fieldId, agent->getEntityPosition()) : intensity;
+        if (heardIntensity <= 0.0f) continue;
+        agent->onSoundHeard(position, heardIntensity);
+        ++heard;
     }
     
     core::Logger::instance().info("[AI] Sound at (" + std::to_string(position.x) + 
                                  ", " + std::to_string(position.y) + 
                                  ") intensity " + std::to_string(intensity) + 
-                                 " heard by " + std::to_string(agentsInRange.size()) + " agents");
+                                 " heard by " + std::to_string(heard) + " agents");
 }
 
 std::vector<AIAgent*> AIManager::getAgentsInRadius(const sf::Vector2f& position, float radius) {
-    std::vector<AIAgent*> agentsInRange;
-    
-    float radiusSquared = radius * radius;
-    
-    for (auto* agent : activeAgents_) {
-        if (!agent) continue;
-        
-        // Get agent's entity position
-        sf::Vector2f agentPos(0, 0);
-        auto debugInfo = agent->getDebugInfo();
-        // Note: We need a way to get the agent's position. This would need to be added to AIAgent
-        // For now, skip position check or assume all agents are in range
-        agentsInRange.push_back(agent);
+    // Agents added or removed since the last frame force an early refresh
+    if (agentGrid_.isDirty()) {
+        agentGrid_.rebuild(activeAgents_);
     }
-    
-    return agentsInRange;
+    agentGrid_.query(position, radius, agentsInRange_);
+    return agentsInRange_;
 }
 
 void AIManager::broadcastAlert(const sf::Vector2f& position, entities::Entity* source) {
@@ -298,6 +703,8 @@ AIManager::PerformanceMetrics AIManager::getPerformanceMetrics() const {
 
 void AIManager::resetPerformanceMetrics() {
     performanceMetrics_ = PerformanceMetrics{};
+    pathCache_.resetStats();
+    blackboard_.resetStats();
     
     for (auto* agent : activeAgents_) {
         if (agent) {
@@ -317,15 +724,21 @@ AIManager::DebugInfo AIManager::getDebugInfo() const {
     }
     
     // Add alert positions
-    info.alertPositions = recentAlerts_;
+    std::vector<const TeamBlackboard::Entry*> entries;
+    blackboard_.collect(TeamBlackboard::Slot::AlertZone, entries);
+    for (const auto* zone : entries) {
+        info.alertPositions.push_back(zone->position);
+    }
     
     // Add performance metrics
     info.performance = performanceMetrics_;
+    info.slowestAgents = agentProfiler_.getSlowest();
     
     // Add coordination links (could be expanded to show agent relationships)
-    for (const auto& targetPos : sharedTargetPositions_) {
+    blackboard_.collect(TeamBlackboard::Slot::TargetPosition, entries);
+    for (const auto* target : entries) {
         // For now, just add the shared target positions
-        info.coordinationLinks.emplace_back(targetPos.second, targetPos.second);
+        info.coordinationLinks.emplace_back(target->position, target->position);
     }
     
     return info;
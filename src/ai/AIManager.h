@@ -3,13 +3,29 @@
 
 #include "AISystem.h"
 #include "Enemy.h"
+#include "EnemyManager.h"
+#include "NavGrid.h"
+#include "PathCache.h"
+#include "NavMesh.h"
+#include "PathRequestQueue.h"
+#include "PerceptionBatch.h"
+#include "VisibilityTable.h"
+#include "LODScheduler.h"
+#include "AgentGrid.h"
+#include "AgentProfiler.h"
+#include "SoundPropagation.h"
+#include "StateBuckets.h"
+#include "TeamBlackboard.h"
+#include "DeterministicStep.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
 
+namespace core { class ThreadPool; }
 namespace entities { 
     class EntityManager; 
     class Entity;
+    class Player;
 }
 namespace collisions { class CollisionManager; }
 
@@ -23,6 +39,42 @@ struct CoordinationConfig {
     int maxCoordinatedAgents = 10;           // Maximum agents that can coordinate
     bool shareTargetInformation = true;
     bool enableGroupBehaviors = true;
+    TeamBlackboardConfig blackboard;         // Shared target positions, alert zones and flank claims
+    
+    // Pathfinding
+    bool asyncPathfinding = true;            // Queue path searches once a nav grid is built
+    PathRequestQueueConfig pathQueue;        // Per-frame search budget
+    bool enablePathCache = true;             // Reuse routes between identical cell pairs
+    PathCacheConfig pathCache;
+    
+    // Perception
+    bool batchedPerception = true;           // One SoA perception sweep for all agents per tick
+    PerceptionBatchConfig perceptionBatch;
+    PerceptionMemoryConfig perceptionMemory; // Ring size of every agent's memory block
+    
+    // Level of detail: update rate by distance to the LOD focus
+    LODConfig lod;
+    
+    // Grid used by radius broadcasts (alerts, sounds, target sharing)
+    AgentGridConfig agentGrid;
+    
+    // Sounds flood the nav grid (around walls) once it is built; otherwise
+    // onSoundMade falls back to a straight radius
+    bool propagateSound = true;
+    SoundPropagationConfig soundPropagation;
+    
+    // Per-agent tick timing with a rolling list of the slowest agents
+    AgentProfilerConfig profiler;
+    
+    // Fixed-step mode for reproducible runs: updateAll advances whole ticks of
+    // fixedTimeStep, path searches get an expansion budget instead of a time
+    // budget, and every tick ends with a hash of the agents' state
+    DeterministicConfig deterministic;
+    
+    // Worker threads for the think phase and sight raycasts
+    // (0 = everything on the calling thread, -1 = one per extra hardware core).
+    // Results do not depend on the thread count.
+    int workerThreads = 0;
 };
 
 // Enhanced AI manager with coordination and performance monitoring
@@ -37,18 +89,81 @@ public:
     AIAgent* getAgent(entities::Entity* entity);
     void clearAllAgents();
     
-    // Legacy Enemy support for backward compatibility
+    // Legacy Enemy support: registered enemies run through the EnemyManager
+    // pipeline as one stage of updateAll
     void addEnemyPointer(Enemy* enemy);
     void removeEnemyPointer(Enemy* enemy);
+    const EnemyManager& getEnemyPipeline() const { return enemyPipeline_; }
+    
+    // Player used as LOD focus fallback and enemy target. Without one the first
+    // Player entity is looked up by type and kept by id: it is looked up again
+    // once that id no longer maps to it, or while none is found, whenever the
+    // entity count changes.
+    void setPlayer(entities::Player* player);
+    entities::Player* getPlayer() const { return player_; }   // As of the last tick
     
-    // Update all AI agents
+    // Update all AI agents. In deterministic mode deltaTime is accumulated
+    // and zero or more fixed ticks run; stage timings are the last tick's.
     void updateAll(float deltaTime, entities::EntityManager* entityManager, 
                    collisions::CollisionManager* collisionManager);
     
+    // Deterministic mode: state hash (agents, then pipeline enemies) after the
+    // last fixed tick and the recent per-tick log; two runs from the same seed and inputs must match, and
+    // firstDivergentStep() finds where they stop doing so
+    std::uint64_t getStateHash() const { return stateHash_; }
+    const std::vector<StepHash>& getStateHashes() const { return stateHashes_; }
+    const FixedStepClock& getFixedStepClock() const { return fixedStepClock_; }
+    
+    // Navigation: bake static obstacles into the nav grid used by queued path searches
+    void rebuildNavGrid(const collisions::CollisionManager* collisionManager,
+                        const NavGridConfig& config = NavGridConfig{});
+    const NavGrid& getNavGrid() const { return navGrid_; }
+    NavGrid& getNavGrid() { return navGrid_; } // Doors/dynamic obstacles: edit cells, planners repair
+    PathRequestQueue& getPathRequestQueue() { return pathQueue_; }
+    PathCache& getPathCache() { return pathCache_; }
+    const PerceptionBatch& getPerceptionBatch() const { return perceptionBatch_; }
+    const PerceptionMemory& getPerceptionMemory() const { return perceptionMemory_; }
+    const TargetIndex& getTargetIndex() const { return targetIndex_; }
+    
+    // Navmesh: bake from wall colliders or load a prebuilt one; agents prefer it once ready
+    void buildNavMesh(const collisions::CollisionManager* collisionManager,
+                      const NavMeshConfig& config = NavMeshConfig{});
+    bool loadNavMesh(const std::string& path);
+    NavMesh& getNavMesh() { return navMesh_; }
+    
+    // Static visibility table for sight checks, baked from the wall shapes. With a
+    // cache path, a cached table built with the same settings from the same
+    // geometry is loaded; otherwise it is rebuilt and written back.
+    void buildVisibilityTable(const collisions::CollisionManager* collisionManager,
+                              const VisibilityTableConfig& config = VisibilityTableConfig{},
+                              const std::string& cachePath = "");
+    const VisibilityTable& getVisibilityTable() const { return visibilityTable_; }
+    bool visibilityTableFromCache() const { return visibilityTableFromCache_; }
+    const SoundPropagation& getSoundPropagation() const { return soundPropagation_; }
+    
+    // Behavior trees, compiled once and shared by every agent whose config names them
+    bool loadBehaviorTree(const std::string& name, const std::string& path);
+    bool loadBehaviorTreeFromString(const std::string& name, const std::string& data);
+    const BehaviorTree* getBehaviorTree(const std::string& name) const;
+    
+    // LOD focus (usually the player); without one the cached player is used
+    void setLODFocus(const entities::Entity* focus) { lodFocus_ = focus; }
+    const LODScheduler& getLODScheduler() const { return lodScheduler_; }
+    
+    // Active agents near a position (grid snapshot refreshed once per frame)
+    std::vector<AIAgent*> getAgentsInRadius(const sf::Vector2f& position, float radius);
+    const AgentGrid& getAgentGrid() const { return agentGrid_; }
+    const AgentStateBuckets& getStateBuckets() const { return stateBuckets_; }
+    
     // Coordination features
     void alertAgentsInRadius(const sf::Vector2f& position, float radius, 
                            entities::Entity* source = nullptr);
+    // Publishes the position on the team blackboard; agents within alertRadius,
+    // now or later while the entry is active, pick the target up at a
+    // coordination update
     void shareTargetInformation(entities::Entity* target, const sf::Vector2f& lastKnownPosition);
+    const TeamBlackboard& getTeamBlackboard() const { return blackboard_; }
+    TeamBlackboard& getTeamBlackboard() { return blackboard_; }   // Flank claims
     
     // Event broadcasting
     void onEntityDamaged(entities::Entity* entity, float damage, entities::Entity* source);
@@ -64,12 +179,33 @@ public:
         int totalPathfindingRequests = 0;
         int totalStateChanges = 0;
         float coordinationUpdateTime = 0.0f;
+        int pendingPathRequests = 0;
+        float pathQueueTime = 0.0f;              // Milliseconds spent searching last frame
+        int pathCacheHits = 0;                   // Full + partial hits since last reset
+        int pathCacheMisses = 0;
+        int lodFullUpdates = 0;                  // Last frame, per LOD outcome
+        int lodLowDetailUpdates = 0;
+        int lodSkippedUpdates = 0;
+        float enemyPipelineTime = 0.0f;          // Milliseconds in the enemy pipeline last frame
+        // Milliseconds per agent stage last frame; with coordination, LOD and
+        // the enemy pipeline they add up to coordinationUpdateTime
+        float perceptionTime = 0.0f;             // Batched perception sweep
+        float decisionTime = 0.0f;               // Think (parallel) and decision commit
+        float behaviorTime = 0.0f;               // State behaviors, including their path requests and cache hits
+        float pathfindingTime = 0.0f;            // Queued path searches
+        float movementTime = 0.0f;               // Movement integration and broadcast grid
+        int blackboardWrites = 0;                // Versioned blackboard changes since reset
+        int blackboardDeliveries = 0;            // Changed entries handed to subscribed agents
+        int blackboardHandoffs = 0;              // Standing targets handed to agents that came into range
     };
     PerformanceMetrics getPerformanceMetrics() const;
     void resetPerformanceMetrics();
+    // Slowest agent ticks (state, stage, cause); writeAgentProfile dumps them as JSON
+    const AgentProfiler& getAgentProfiler() const { return agentProfiler_; }
+    bool writeAgentProfile(const std::string& path) const { return agentProfiler_.saveToFile(path); }
     
     // Configuration
-    void setCoordinationConfig(const CoordinationConfig& config) { coordinationConfig_ = config; }
+    void setCoordinationConfig(const CoordinationConfig& config);
     const CoordinationConfig& getCoordinationConfig() const { return coordinationConfig_; }
     
     // Debug information
@@ -78,32 +214,84 @@ public:
         std::vector<sf::Vector2f> alertPositions;
         std::vector<std::pair<sf::Vector2f, sf::Vector2f>> coordinationLinks;
         PerformanceMetrics performance;
+        std::vector<AgentProfiler::Sample> slowestAgents;   // Rolling worst ticks, slowest first
     };
     DebugInfo getDebugInfo() const;
 
 private:
     CoordinationConfig coordinationConfig_;
     
-    // Agent storage
-    std::unordered_map<entities::Entity*, std::unique_ptr<AIAgent>> agents_;
+    // Navigation (declared before agents so pending requests outlive them)
+    NavGrid navGrid_;
+    bool navGridReady_;
+    PathCache pathCache_;
+    PathRequestQueue pathQueue_;
+    NavMesh navMesh_;
+    PerceptionBatch perceptionBatch_;
+    PerceptionMemory perceptionMemory_;     // Agents release their blocks on destruction
+    TargetIndex targetIndex_;               // Agents unlink their targets on destruction
+    VisibilityTable visibilityTable_;
+    bool visibilityTableFromCache_;         // Last buildVisibilityTable loaded instead of baking
+    std::unordered_map<std::string, std::unique_ptr<BehaviorTree>> behaviorTrees_;
+    SoundPropagation soundPropagation_;
+    
+    // Agent storage: dense array in insertion order plus an entity lookup
+    std::vector<std::unique_ptr<AIAgent>> agents_;
+    std::unordered_map<entities::Entity*, std::size_t> agentIndex_;
     std::vector<AIAgent*> activeAgents_;  // Cache for performance
+    AgentGrid agentGrid_;
+    AgentStateBuckets stateBuckets_;
+    std::vector<AIAgent*> agentsInRange_;
+    std::vector<AIAgent*> targetHolders_;
+    
+    // Level of detail
+    LODScheduler lodScheduler_;
+    const entities::Entity* lodFocus_;
+    std::vector<AIAgent*> fullUpdateAgents_;
+    
+    // Parallel think phase (null when running single-threaded)
+    std::unique_ptr<core::ThreadPool> threadPool_;
     
     // Legacy enemy support
-    std::vector<Enemy*> legacyEnemies_;
+    EnemyManager enemyPipeline_;
+    
+    // Cached player lookup
+    entities::Player* player_;
+    bool playerPinned_;
+    entities::Entity::Id playerId_;
+    std::size_t playerScanCount_;
     
-    // Coordination data
-    std::vector<sf::Vector2f> recentAlerts_;
-    std::unordered_map<entities::Entity*, sf::Vector2f> sharedTargetPositions_;
+    // Coordination data: agents read blackboard changes past their own cursor
+    TeamBlackboard blackboard_;
+    std::vector<const TeamBlackboard::Entry*> blackboardChanges_;
+    std::vector<const TeamBlackboard::Entry*> standingTargets_;
+    float coordinationTime_;
     float coordinationUpdateTimer_;
     
     // Performance tracking
     mutable PerformanceMetrics performanceMetrics_;
+    AgentProfiler agentProfiler_;
     float performanceUpdateTimer_;
     
+    // Deterministic fixed-step mode
+    FixedStepClock fixedStepClock_;
+    std::uint64_t stateHash_;
+    std::vector<StepHash> stateHashes_;
+    
     // Internal methods
+    void runTick(float deltaTime, entities::EntityManager* entityManager,
+                 collisions::CollisionManager* collisionManager);
+    void recordStateHash();
+    PathRequestQueueConfig pathQueueConfig() const;
     void updateCoordination(float deltaTime);
+    void deliverBlackboardChanges();
     void updateActiveAgentsList();
-    std::vector<AIAgent*> getAgentsInRadius(const sf::Vector2f& position, float radius);
+    void attachNavigation(AIAgent* agent);
+    void attachBehaviorTree(AIAgent* agent);
+    void installBehaviorTree(const std::string& name, BehaviorTree&& tree);
+    void configureThreadPool();
+    entities::Player* cachedPlayer(entities::EntityManager* entityManager);
+    const SoundPropagation* activeSoundPropagation() const;
     void broadcastAlert(const sf::Vector2f& position, entities::Entity* source);
     void updatePerformanceMetrics();
 };
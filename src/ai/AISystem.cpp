@@ -6,6 +6,7 @@
 #include "core/Logger.h"
 #include <algorithm>
 #include <chrono>
+#include <limits>
 
 namespace ai {
 
@@ -16,22 +17,45 @@ AIAgent::AIAgent(entities::Entity* entity, const AIAgentConfig& config)
     , previousState_(AIState::IDLE)
     , timeInCurrentState_(0.0f)
     , timeInPreviousState_(0.0f)
-    , primaryTarget_(nullptr)
+    , targets_(config.maxTargets)
+    , targetIndex_(nullptr)
     , hasSimpleTarget_(false)
     , simpleTargetId_(0)
     , simpleTargetPosition_(0, 0)
     , currentPatrolIndex_(0)
     , currentPathIndex_(0)
     , targetPosition_(0, 0)
+    , pathQueue_(nullptr)
+    , pendingPathRequest_(kInvalidPathRequest)
+    , requestedDestination_(0, 0)
+    , steeringTarget_(0, 0)
+    , directSteering_(false)
+    , pathRetryTimer_(0.0f)
+    , rng_(entity ? entity->id() : 1u)
+    , navMesh_(nullptr)
+    , navGrid_(nullptr)
+    , plannerPathRevision_(0)
+    , perceptionIngested_(false)
+    , perceptionClock_(0.0f)
     , lastKnownPlayerPosition_(0, 0)
     , timeSincePlayerSeen_(0.0f)
     , isAlert_(false)
     , alertTimer_(0.0f)
     , lastAlertTime_(0.0f)
+    , blackboardCursor_(0)
+    , blackboardCell_(std::numeric_limits<int>::min(), std::numeric_limits<int>::min())
+    , droppedTargets_{}
+    , nextDropped_(0)
     , investigationTimer_(0.0f)
     , stunnedTimer_(0.0f)
     , attackCooldown_(0.0f)
     , fleeCooldown_(0.0f)
+    , behaviorTree_(nullptr)
+    , intent_(Intent::None)
+    , intentBaseState_(AIState::IDLE)
+    , moveRequested_(false)
+    , moveTarget_(0, 0)
+    , thinkTime_(0.0f)
     , updateTimeAccumulator_(0.0f)
     , updateCount_(0)
 {
@@ -39,40 +63,89 @@ AIAgent::AIAgent(entities::Entity* entity, const AIAgentConfig& config)
     pathfindingSystem_ = std::make_unique<PathfindingSystem>(config_.pathfinding);
 }
 
-AIAgent::~AIAgent() = default;
+AIAgent::~AIAgent() {
+    cancelPathRequest();
+    clearTargets();
+}
+
+void AIAgent::setConfig(const AIAgentConfig& config) {
+    config_ = config;
+    targets_.setLimit(config_.maxTargets);
+    while (targets_.size() > targets_.limit()) {
+        removeTarget(targets_.weakest());
+    }
+}
+
+void AIAgent::setTargetIndex(TargetIndex* index) {
+    if (index == targetIndex_) return;
+    for (const TargetSet::Entry& target : targets_) {
+        if (targetIndex_) targetIndex_->unlink(target.entity, this);
+        if (index) index->link(target.entity, this);
+    }
+    targetIndex_ = index;
+}
+
+void AIAgent::setPathRequestQueue(PathRequestQueue* queue) {
+    if (queue == pathQueue_) return;
+    cancelPathRequest();
+    pathQueue_ = queue;
+}
+
+void AIAgent::setNavGrid(const NavGrid* navGrid) {
+    navGrid_ = navGrid;
+    if (incrementalPlanner_) {
+        incrementalPlanner_->setGrid(navGrid);
+    }
+}
 
 void AIAgent::update(float deltaTime, entities::EntityManager* entityManager, 
                     collisions::CollisionManager* collisionManager) {
+    think(deltaTime, entityManager, collisionManager);
+    commit(deltaTime, collisionManager);
+}
+
+void AIAgent::think(float deltaTime, entities::EntityManager* entityManager,
+                    collisions::CollisionManager* collisionManager) {
     
     auto startTime = std::chrono::high_resolution_clock::now();
+    intent_ = Intent::None;
+    // A batched sweep already opened this tick's profile in ingestPerception()
+    if (!perceptionIngested_) {
+        tickProfile_ = TickProfile{};
+    }
     
     if (!entity_ || !entity_->isActive()) {
         return;
     }
     
     // Update timers
-    timeInCurrentState_ += deltaTime;
-    timeSincePlayerSeen_ += deltaTime;
-    attackCooldown_ = std::max(0.0f, attackCooldown_ - deltaTime);
-    fleeCooldown_ = std::max(0.0f, fleeCooldown_ - deltaTime);
-    investigationTimer_ = std::max(0.0f, investigationTimer_ - deltaTime);
-    stunnedTimer_ = std::max(0.0f, stunnedTimer_ - deltaTime);
-    alertTimer_ = std::max(0.0f, alertTimer_ - deltaTime);
+    tickTimers(deltaTime);
     
     // Handle stunned state
     if (stunnedTimer_ > 0.0f) {
-        executeStunned(deltaTime);
+        perceptionIngested_ = false;
+        intent_ = Intent::Stunned;
         return;
     }
     
-    // Update perception
+    // Update perception (unless the manager already ran the batched stage)
     performanceStats_.perceptionChecks++;
-    auto perceptions = perceptionSystem_->updatePerception(
-        entity_, getEntityPosition(), getFacingDirection(),
-        entityManager, collisionManager, timeInCurrentState_
-    );
-    
-    recentPerceptions_ = perceptions;
+    if (perceptionIngested_) {
+        perceptionIngested_ = false;
+        for (const auto& perception : recentPerceptions_) {
+            if (perception.type == PerceptionType::SIGHT) {
+                perceptionSystem_->remember(perception, perceptionClock_);
+            }
+        }
+        perceptionSystem_->appendMemoryEvent(entity_, recentPerceptions_, perceptionClock_);
+    } else {
+        perceptionSystem_->updatePerception(
+            entity_, getEntityPosition(), getFacingDirection(),
+            entityManager, collisionManager, perceptionClock_, recentPerceptions_
+        );
+    }
+    const std::vector<PerceptionEvent>& perceptions = recentPerceptions_;
+    tickProfile_.perceptionEvents = static_cast<int>(perceptions.size());
     
     // Process perception events
     for (const auto& perception : perceptions) {
@@ -84,58 +157,121 @@ void AIAgent::update(float deltaTime, entities::EntityManager* entityManager,
             }
         }
     }
+    if (!targets_.empty()) {
+        targets_.updateDistances([this](entities::Entity* target) { return distanceTo(target); });
+    }
+    
+    auto decisionTime = std::chrono::high_resolution_clock::now();
+    tickProfile_.perceptionMs += std::chrono::duration<float, std::milli>(decisionTime - startTime).count();
+    
+    // Make behavioral decision; applied in commit()
+    pendingDecision_ = makeDecision(perceptions, entityManager, collisionManager);
+    intentBaseState_ = currentState_;
+    intent_ = Intent::Decided;
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    tickProfile_.decisionMs = std::chrono::duration<float, std::milli>(endTime - decisionTime).count();
+    thinkTime_ = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0f;
+}
+
+void AIAgent::commit(float deltaTime, collisions::CollisionManager* collisionManager) {
+    if (!applyDecision(deltaTime)) {
+        return;
+    }
+    auto startTime = std::chrono::high_resolution_clock::now();
+    executeState(deltaTime, collisionManager);
+    applyMovement(deltaTime);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    addUpdateTime(std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0f, false);
+}
+
+bool AIAgent::applyDecision(float deltaTime) {
+    Intent intent = intent_;
+    intent_ = Intent::None;
+    if (intent == Intent::None) {
+        return false;
+    }
+    if (intent == Intent::Stunned) {
+        executeStunned(deltaTime);
+        return false;
+    }
     
-    // Make behavioral decision
-    auto decision = makeDecision(perceptions, entityManager, collisionManager);
+    auto startTime = std::chrono::high_resolution_clock::now();
+    const BehaviorDecision& decision = pendingDecision_;
     
-    // Execute the decision
-    if (decision.newState != currentState_) {
-        changeState(decision.newState, decision.reason);
+    // Alerts go out before the state change, as when decided inline
+    if (decision.raiseAlert) {
+        alertNearbyAgents(decision.alertPosition);
     }
     
-    // Update target position if provided
-    if (decision.targetPosition != sf::Vector2f(0, 0)) {
-        targetPosition_ = decision.targetPosition;
+    // An event applied since think() (e.g. another agent's alert) takes
+    // precedence over the stale decision; the next think re-decides
+    if (currentState_ == intentBaseState_) {
+        // Execute the decision
+        if (decision.newState != currentState_) {
+            changeState(decision.newState, decision.reason);
+        }
+        
+        // Update target position if provided
+        if (decision.targetPosition != sf::Vector2f(0, 0)) {
+            targetPosition_ = decision.targetPosition;
+        }
     }
     
-    // Execute current state behavior
-    switch (currentState_) {
+    // Update performance stats (think + apply; behavior time is added by the caller)
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+    tickProfile_.commitMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    addUpdateTime(thinkTime_ + duration.count() / 1000.0f, true);
+    return true;
+}
+
+void AIAgent::executeState(float deltaTime, collisions::CollisionManager* collisionManager) {
+    executeState(behaviorFor(currentState_), deltaTime, collisionManager);
+}
+
+AIAgent::StateBehavior AIAgent::behaviorFor(AIState state) {
+    switch (state) {
         case AIState::IDLE:
-            executeIdle(deltaTime);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager*) { agent.executeIdle(dt); };
         case AIState::PATROL:
-            executePatrol(deltaTime, collisionManager);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager* cm) { agent.executePatrol(dt, cm); };
         case AIState::CHASE:
-            executeChase(deltaTime, collisionManager);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager* cm) { agent.executeChase(dt, cm); };
         case AIState::ATTACK:
-            executeAttack(deltaTime);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager*) { agent.executeAttack(dt); };
         case AIState::FLEE:
-            executeFlee(deltaTime, collisionManager);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager* cm) { agent.executeFlee(dt, cm); };
         case AIState::RETURN:
-            executeReturn(deltaTime, collisionManager);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager* cm) { agent.executeReturn(dt, cm); };
         case AIState::INVESTIGATE:
-            executeInvestigate(deltaTime, collisionManager);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager* cm) { agent.executeInvestigate(dt, cm); };
         case AIState::ALERT:
-            executeAlert(deltaTime);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager*) { agent.executeAlert(dt); };
         case AIState::STUNNED:
-            executeStunned(deltaTime);
-            break;
+            return [](AIAgent& agent, float dt, collisions::CollisionManager*) { agent.executeStunned(dt); };
         case AIState::DEAD:
-            // Do nothing when dead
             break;
     }
+    // Do nothing when dead
+    return [](AIAgent&, float, collisions::CollisionManager*) {};
+}
+
+void AIAgent::executeState(StateBehavior behavior, float deltaTime, collisions::CollisionManager* collisionManager) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    int requestsBefore = performanceStats_.pathfindingRequests;
+    
+    behavior(*this, deltaTime, collisionManager);
     
-    // Update performance stats
     auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-    updateTimeAccumulator_ += duration.count() / 1000.0f; // Convert to milliseconds
+    tickProfile_.behaviorMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    tickProfile_.pathRequests = performanceStats_.pathfindingRequests - requestsBefore;
+    tickProfile_.pathLength = static_cast<int>(currentPath_.size());
+}
+
+void AIAgent::addUpdateTime(float milliseconds, bool newSample) {
+    updateTimeAccumulator_ += milliseconds;
+    if (!newSample) return;
     updateCount_++;
     
     if (updateCount_ >= 60) { // Update average every 60 frames
@@ -145,6 +281,46 @@ void AIAgent::update(float deltaTime, entities::EntityManager* entityManager,
     }
 }
 
+void AIAgent::updateLowDetail(float deltaTime) {
+    executeLowDetail(deltaTime);
+    applyMovement(deltaTime);
+}
+
+void AIAgent::executeLowDetail(float deltaTime) {
+    if (!entity_ || !entity_->isActive()) {
+        return;
+    }
+    
+    tickTimers(deltaTime);
+    if (stunnedTimer_ > 0.0f) {
+        return;
+    }
+    if (currentState_ == AIState::STUNNED) {
+        executeStunned(deltaTime);
+        return;
+    }
+    
+    // Walk the patrol loop in straight lines; a full update resumes pathing
+    if (currentState_ == AIState::PATROL && !patrolPoints_.empty()) {
+        if (distanceTo(patrolPoints_[currentPatrolIndex_]) < 32.0f) {
+            currentPatrolIndex_ = (currentPatrolIndex_ + 1) % patrolPoints_.size();
+        }
+        steerTowards(patrolPoints_[currentPatrolIndex_]);
+    }
+}
+
+void AIAgent::tickTimers(float deltaTime) {
+    perceptionClock_ += deltaTime;
+    timeInCurrentState_ += deltaTime;
+    timeSincePlayerSeen_ += deltaTime;
+    attackCooldown_ = std::max(0.0f, attackCooldown_ - deltaTime);
+    fleeCooldown_ = std::max(0.0f, fleeCooldown_ - deltaTime);
+    investigationTimer_ = std::max(0.0f, investigationTimer_ - deltaTime);
+    stunnedTimer_ = std::max(0.0f, stunnedTimer_ - deltaTime);
+    alertTimer_ = std::max(0.0f, alertTimer_ - deltaTime);
+    pathRetryTimer_ = std::max(0.0f, pathRetryTimer_ - deltaTime);
+}
+
 void AIAgent::changeState(AIState newState, const std::string& reason) {
     if (newState == currentState_) return;
     
@@ -169,50 +345,73 @@ BehaviorDecision AIAgent::makeDecision(const std::vector<PerceptionEvent>& perce
                                       collisions::CollisionManager* collisionManager) {
     BehaviorDecision decision(currentState_, Priority::LOW);
     
+    // A behavior tree replaces the profile rules; when it fires no action the
+    // default behaviors below still apply
+    bool decided = behaviorTree_ ? decideFromTree(perceptions, decision)
+                                 : decideFromProfile(perceptions, decision);
+    if (decided) {
+        return decision;
+    }
+    
+    // Default behaviors when no targets
+    if (decision.newState == currentState_ && decision.priority == Priority::LOW) {
+        switch (currentState_) {
+            case AIState::IDLE:
+                if (!patrolPoints_.empty()) {
+                    decision.newState = AIState::PATROL;
+                    decision.reason = "Starting patrol";
+                }
+                break;
+                
+            case AIState::CHASE:
+            case AIState::INVESTIGATE:
+                if (timeSincePlayerSeen_ > config_.investigationTime) {
+                    decision.newState = AIState::RETURN;
+                    decision.reason = "Lost target - returning";
+                }
+                break;
+                
+            case AIState::ALERT:
+                if (alertTimer_ <= 0.0f) {
+                    decision.newState = !patrolPoints_.empty() ? AIState::PATROL : AIState::IDLE;
+                    decision.reason = "Alert timeout - resuming normal behavior";
+                }
+                break;
+                
+            case AIState::RETURN:
+                if (!patrolPoints_.empty()) {
+                    float distanceToPatrol = distanceTo(patrolPoints_[currentPatrolIndex_]);
+                    if (distanceToPatrol < 32.0f) {
+                        decision.newState = AIState::PATROL;
+                        decision.reason = "Reached patrol point";
+                    }
+                } else {
+                    decision.newState = AIState::IDLE;
+                    decision.reason = "No patrol points - going idle";
+                }
+                break;
+                
+            default:
+                break;
+        }
+    }
+    
+    return decision;
+}
+
+bool AIAgent::decideFromProfile(const std::vector<PerceptionEvent>& perceptions, BehaviorDecision& decision) {
     // Check for critical situations first
     if (shouldFlee()) {
         decision.newState = AIState::FLEE;
         decision.priority = Priority::CRITICAL;
         decision.reason = "Low health - fleeing";
-        
-        // Find flee direction (away from threats)
-        sf::Vector2f fleeDirection(0, 0);
-        for (const auto& perception : perceptions) {
-            if (perception.source && perception.type == PerceptionType::SIGHT) {
-                sf::Vector2f awayFromThreat = getEntityPosition() - perception.position;
-                float length = std::sqrt(awayFromThreat.x * awayFromThreat.x + awayFromThreat.y * awayFromThreat.y);
-                if (length > 0.0f) {
-                    fleeDirection += (awayFromThreat / length);
-                }
-            }
-        }
-        
-        if (fleeDirection != sf::Vector2f(0, 0)) {
-            float length = std::sqrt(fleeDirection.x * fleeDirection.x + fleeDirection.y * fleeDirection.y);
-            if (length > 0.0f) {
-                fleeDirection /= length;
-                decision.targetPosition = getEntityPosition() + fleeDirection * config_.fleeDistance;
-            }
-        }
-        
-        return decision;
+        decision.targetPosition = fleePosition(perceptions);
+        return true;
     }
     
     // Handle behavior based on profile and perceptions
-    entities::Entity* bestTarget = nullptr;
     Priority bestPriority = Priority::LOW;
-    
-    // Evaluate current targets and perceptions
-    for (const auto& perception : perceptions) {
-        if (!perception.source) continue;
-        
-        Priority targetPriority = calculateTargetPriority(perception.source);
-        
-        if (targetPriority > bestPriority) {
-            bestTarget = perception.source;
-            bestPriority = targetPriority;
-        }
-    }
+    entities::Entity* bestTarget = findBestTarget(perceptions, bestPriority);
     
     // Decision making based on behavior profile
     if (bestTarget) {
@@ -293,57 +492,111 @@ BehaviorDecision AIAgent::makeDecision(const std::vector<PerceptionEvent>& perce
                     
                     // Alert others if configured
                     if (config_.canAlertOthers) {
-                        alertNearbyAgents(bestTarget->position());
+                        decision.raiseAlert = true;
+                        decision.alertPosition = bestTarget->position();
                     }
                 }
                 break;
         }
     }
+    return false;
+}
+
+bool AIAgent::decideFromTree(const std::vector<PerceptionEvent>& perceptions, BehaviorDecision& decision) {
+    Priority bestPriority = Priority::LOW;
+    entities::Entity* bestTarget = findBestTarget(perceptions, bestPriority);
     
-    // Default behaviors when no targets
-    if (decision.newState == currentState_ && decision.priority == Priority::LOW) {
-        switch (currentState_) {
-            case AIState::IDLE:
-                if (!patrolPoints_.empty()) {
-                    decision.newState = AIState::PATROL;
-                    decision.reason = "Starting patrol";
-                }
-                break;
-                
-            case AIState::CHASE:
-            case AIState::INVESTIGATE:
-                if (timeSincePlayerSeen_ > config_.investigationTime) {
-                    decision.newState = AIState::RETURN;
-                    decision.reason = "Lost target - returning";
-                }
-                break;
-                
-            case AIState::ALERT:
-                if (alertTimer_ <= 0.0f) {
-                    decision.newState = !patrolPoints_.empty() ? AIState::PATROL : AIState::IDLE;
-                    decision.reason = "Alert timeout - resuming normal behavior";
-                }
-                break;
-                
-            case AIState::RETURN:
-                if (!patrolPoints_.empty()) {
-                    float distanceToPatrol = distanceTo(patrolPoints_[currentPatrolIndex_]);
-                    if (distanceToPatrol < 32.0f) {
-                        decision.newState = AIState::PATROL;
-                        decision.reason = "Reached patrol point";
-                    }
-                } else {
-                    decision.newState = AIState::IDLE;
-                    decision.reason = "No patrol points - going idle";
-                }
-                break;
-                
-            default:
-                break;
+    BehaviorContext context;
+    context[BehaviorFact::Health] = getHealthPercentage();
+    context[BehaviorFact::ShouldFlee] = shouldFlee() ? 1.0f : 0.0f;
+    context[BehaviorFact::HasTarget] = bestTarget ? 1.0f : 0.0f;
+    context[BehaviorFact::TargetDistance] = bestTarget ? distanceTo(bestTarget) : std::numeric_limits<float>::max();
+    context[BehaviorFact::TargetPriority] = bestTarget ? static_cast<float>(bestPriority) : 0.0f;
+    context[BehaviorFact::CanAttack] = shouldAttack(bestTarget) ? 1.0f : 0.0f;
+    context[BehaviorFact::AttackRange] = config_.attackRange;
+    int threats = 0;
+    for (const auto& perception : perceptions) {
+        if (perception.source && perception.type == PerceptionType::SIGHT) ++threats;
+    }
+    context[BehaviorFact::ThreatCount] = static_cast<float>(threats);
+    context[BehaviorFact::TimeSinceSeen] = timeSincePlayerSeen_;
+    context[BehaviorFact::InvestigationTime] = config_.investigationTime;
+    context[BehaviorFact::AlertTimer] = alertTimer_;
+    context[BehaviorFact::HasPatrol] = patrolPoints_.empty() ? 0.0f : 1.0f;
+    context[BehaviorFact::PatrolDistance] = patrolPoints_.empty() ? 0.0f : distanceTo(patrolPoints_[currentPatrolIndex_]);
+    context[BehaviorFact::State] = static_cast<float>(currentState_);
+    context[BehaviorFact::TimeInState] = timeInCurrentState_;
+    
+    BehaviorTree::Result result;
+    behaviorTree_->evaluate(context, blackboard_, result);
+    if (!result.decided) {
+        return false;
+    }
+    
+    decision.newState = result.state;
+    decision.priority = result.priority;
+    if (result.state != currentState_) {
+        decision.reason = behaviorTree_->reason(result.reason);
+    }
+    if (bestTarget && result.targetEntity) {
+        decision.targetEntity = bestTarget;
+    }
+    if (result.moveTo == BehaviorTree::MoveTo::Target && bestTarget) {
+        decision.targetPosition = bestTarget->position();
+    } else if (result.moveTo == BehaviorTree::MoveTo::Flee) {
+        decision.targetPosition = fleePosition(perceptions);
+    }
+    if (result.alert && bestTarget && config_.canAlertOthers) {
+        decision.raiseAlert = true;
+        decision.alertPosition = bestTarget->position();
+    }
+    return true;
+}
+
+entities::Entity* AIAgent::findBestTarget(const std::vector<PerceptionEvent>& perceptions, Priority& bestPriority) const {
+    entities::Entity* bestTarget = nullptr;
+    bestPriority = Priority::LOW;
+    
+    // Evaluate current targets and perceptions
+    for (const auto& perception : perceptions) {
+        if (!perception.source) continue;
+        
+        Priority targetPriority = calculateTargetPriority(perception.source);
+        
+        if (targetPriority > bestPriority) {
+            bestTarget = perception.source;
+            bestPriority = targetPriority;
+        }
+    }
+    return bestTarget;
+}
+
+sf::Vector2f AIAgent::fleePosition(const std::vector<PerceptionEvent>& perceptions) const {
+    // Find flee direction (away from threats)
+    sf::Vector2f fleeDirection(0, 0);
+    for (const auto& perception : perceptions) {
+        if (perception.source && perception.type == PerceptionType::SIGHT) {
+            sf::Vector2f awayFromThreat = getEntityPosition() - perception.position;
+            float length = std::sqrt(awayFromThreat.x * awayFromThreat.x + awayFromThreat.y * awayFromThreat.y);
+            if (length > 0.0f) {
+                fleeDirection += (awayFromThreat / length);
+            }
         }
     }
     
-    return decision;
+    if (fleeDirection != sf::Vector2f(0, 0)) {
+        float length = std::sqrt(fleeDirection.x * fleeDirection.x + fleeDirection.y * fleeDirection.y);
+        if (length > 0.0f) {
+            fleeDirection /= length;
+            return getEntityPosition() + fleeDirection * config_.fleeDistance;
+        }
+    }
+    return sf::Vector2f(0, 0);
+}
+
+void AIAgent::setBehaviorTree(const BehaviorTree* tree) {
+    behaviorTree_ = tree;
+    blackboard_ = BehaviorTree::Blackboard{};
 }
 
 // Implement behavior execution functions
@@ -416,10 +669,8 @@ void AIAgent::executeFlee(float deltaTime, collisions::CollisionManager* cm) {
     
     // Check if we've fled far enough
     float distanceFromDanger = 0.0f;
-    for (auto* target : targets_) {
-        if (target) {
-            distanceFromDanger = std::max(distanceFromDanger, distanceTo(target));
-        }
+    for (const TargetSet::Entry& target : targets_) {
+        distanceFromDanger = std::max(distanceFromDanger, distanceTo(target.entity));
     }
     
     if (distanceFromDanger >= config_.fleeDistance) {
@@ -514,7 +765,20 @@ Priority AIAgent::calculateTargetPriority(entities::Entity* target) const {
 }
 
 void AIAgent::updatePath(const sf::Vector2f& destination, collisions::CollisionManager* cm) {
-    if (!pathfindingSystem_ || !cm) return;
+    if (config_.incrementalReplanning && navGrid_) {
+        updatePathIncremental(destination);
+        return;
+    }
+    if (navMesh_ && !navMesh_->empty()) {
+        updatePathNavMesh(destination);
+        return;
+    }
+    if (pathQueue_) {
+        updatePathAsync(destination);
+        return;
+    }
+    
+    if (!pathfindingSystem_ || (!cm && !navGrid_)) return;
     
     sf::Vector2f currentPos = getEntityPosition();
     float distance = std::sqrt(std::pow(destination.x - currentPos.x, 2) + 
@@ -524,7 +788,16 @@ void AIAgent::updatePath(const sf::Vector2f& destination, collisions::CollisionM
     if (currentPath_.empty() || distance > 64.0f) {
         performanceStats_.pathfindingRequests++;
         
-        auto result = pathfindingSystem_->findPath(currentPos, destination, cm, entity_);
+        PathfindingResult result;
+        if (navGrid_) {
+            // Any-angle search on the baked grid: no collider queries or post-smoothing.
+            // The radius is per query, so the collider fallback keeps its own config.
+            PathfindingConfig gridConfig = config_.pathfinding;
+            gridConfig.agentRadius = pathAgentRadius();
+            result = pathfindingSystem_->findPath(currentPos, destination, *navGrid_, gridConfig);
+        } else {
+            result = pathfindingSystem_->findPath(currentPos, destination, cm, entity_);
+        }
         if (result.success) {
             currentPath_ = result.path;
             currentPathIndex_ = 0;
@@ -532,8 +805,129 @@ void AIAgent::updatePath(const sf::Vector2f& destination, collisions::CollisionM
     }
 }
 
+void AIAgent::updatePathAsync(const sf::Vector2f& destination) {
+    sf::Vector2f toRequested = destination - requestedDestination_;
+    bool destinationMoved = (toRequested.x * toRequested.x + toRequested.y * toRequested.y) > 64.0f * 64.0f;
+    
+    // Collect the outstanding request, if any
+    if (pendingPathRequest_ != kInvalidPathRequest) {
+        PathfindingResult result;
+        PathRequestStatus status = pathQueue_->poll(pendingPathRequest_, result);
+        
+        if (status == PathRequestStatus::Ready) {
+            if (result.fromCache) {
+                performanceStats_.pathCacheHits++;
+            }
+            currentPath_ = std::move(result.path);
+            currentPathIndex_ = 0;
+            pendingPathRequest_ = kInvalidPathRequest;
+        } else if (status == PathRequestStatus::Failed || status == PathRequestStatus::Invalid) {
+            pendingPathRequest_ = kInvalidPathRequest;
+            // Avoid resubmitting an unreachable goal every frame; jittered so a
+            // crowd that failed together does not retry on the same tick
+            pathRetryTimer_ = 0.5f + 0.25f * randomUnit();
+        } else if (destinationMoved) {
+            // Result would be stale on arrival
+            cancelPathRequest();
+        }
+    }
+    
+    if (pendingPathRequest_ == kInvalidPathRequest && pathRetryTimer_ <= 0.0f &&
+        (currentPath_.empty() || destinationMoved)) {
+        performanceStats_.pathfindingRequests++;
+        PathfindingConfig requestConfig = config_.pathfinding;
+        requestConfig.agentRadius = pathAgentRadius();
+        pendingPathRequest_ = pathQueue_->submit(getEntityPosition(), destination,
+                                                 pathRequestPriority(), requestConfig);
+        // A cache hit is Ready straight away; anything still pending waits for a search
+        if (pathQueue_->status(pendingPathRequest_) == PathRequestStatus::Pending) {
+            performanceStats_.pathCacheMisses++;
+        }
+        requestedDestination_ = destination;
+    }
+    
+    // Steer straight at the destination until the queued result arrives
+    steeringTarget_ = destination;
+    directSteering_ = currentPath_.empty();
+}
+
+void AIAgent::updatePathNavMesh(const sf::Vector2f& destination) {
+    sf::Vector2f toRequested = destination - requestedDestination_;
+    bool destinationMoved = (toRequested.x * toRequested.x + toRequested.y * toRequested.y) > 32.0f * 32.0f;
+    
+    if (currentPath_.empty() || destinationMoved) {
+        performanceStats_.pathfindingRequests++;
+        auto result = navMesh_->findPath(getEntityPosition(), destination);
+        requestedDestination_ = destination;
+        if (result.success) {
+            currentPath_ = std::move(result.path);
+            currentPathIndex_ = 0;
+        }
+    }
+    
+    steeringTarget_ = destination;
+    directSteering_ = currentPath_.empty();
+}
+
+void AIAgent::updatePathIncremental(const sf::Vector2f& destination) {
+    if (!incrementalPlanner_) {
+        IncrementalPlannerConfig plannerConfig = config_.incrementalPlanner;
+        if (plannerConfig.agentRadius <= 0.0f) {
+            plannerConfig.agentRadius = pathAgentRadius();
+        }
+        incrementalPlanner_ = std::make_unique<IncrementalPlanner>(plannerConfig);
+        incrementalPlanner_->setGrid(navGrid_);
+    }
+    
+    // The planner repairs its own search as the agent, target and grid change
+    int expansionsBefore = incrementalPlanner_->getStats().totalExpansions;
+    incrementalPlanner_->update(getEntityPosition(), destination);
+    if (incrementalPlanner_->getStats().totalExpansions != expansionsBefore) {
+        performanceStats_.pathfindingRequests++;
+    }
+    
+    if (incrementalPlanner_->pathRevision() != plannerPathRevision_) {
+        plannerPathRevision_ = incrementalPlanner_->pathRevision();
+        currentPath_ = incrementalPlanner_->path();
+        currentPathIndex_ = 0;
+    }
+    
+    steeringTarget_ = destination;
+    directSteering_ = currentPath_.empty();
+}
+
+float AIAgent::pathAgentRadius() const {
+    // Explicit config wins; otherwise derive from the body so 28px and 32px enemies
+    // get routes that fit them (NavGrid clearance, path cache size class)
+    if (config_.pathfinding.agentRadius > 0.0f || !entity_) return config_.pathfinding.agentRadius;
+    return std::max(entity_->size().x, entity_->size().y) * 0.5f;
+}
+
+void AIAgent::cancelPathRequest() {
+    if (pathQueue_ && pendingPathRequest_ != kInvalidPathRequest) {
+        pathQueue_->cancel(pendingPathRequest_);
+    }
+    pendingPathRequest_ = kInvalidPathRequest;
+}
+
+Priority AIAgent::pathRequestPriority() const {
+    switch (currentState_) {
+        case AIState::CHASE:
+        case AIState::FLEE:
+            return Priority::HIGH;
+        case AIState::INVESTIGATE:
+        case AIState::RETURN:
+            return Priority::MEDIUM;
+        default:
+            return Priority::LOW;
+    }
+}
+
 void AIAgent::followPath(float deltaTime, collisions::CollisionManager* cm) {
     if (currentPath_.empty() || currentPathIndex_ >= currentPath_.size()) {
+        if (directSteering_) {
+            steerTowards(steeringTarget_);
+        }
         return;
     }
     
@@ -553,8 +947,21 @@ void AIAgent::followPath(float deltaTime, collisions::CollisionManager* cm) {
         targetWaypoint = currentPath_[currentPathIndex_];
     }
     
-    // Move towards waypoint
-    sf::Vector2f direction = targetWaypoint - currentPos;
+    steerTowards(targetWaypoint);
+}
+
+void AIAgent::steerTowards(const sf::Vector2f& point) {
+    // Movement is applied after the behavior step (applyMovement or a batched kernel)
+    moveRequested_ = true;
+    moveTarget_ = point;
+}
+
+void AIAgent::applyMovement(float deltaTime) {
+    if (!moveRequested_) return;
+    moveRequested_ = false;
+    
+    sf::Vector2f currentPos = getEntityPosition();
+    sf::Vector2f direction = moveTarget_ - currentPos;
     float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
     
     if (length > 0.0f) {
@@ -567,13 +974,14 @@ void AIAgent::followPath(float deltaTime, collisions::CollisionManager* cm) {
 }
 
 void AIAgent::alertNearbyAgents(const sf::Vector2f& alertPosition) {
-    // This would require access to other AI agents, which could be provided through EntityManager
-    // For now, just log the alert
     core::Logger::instance().info("[AI] Entity " + std::to_string(entity_->id()) + 
                                 " alerting others about position (" + 
                                 std::to_string(alertPosition.x) + ", " + 
                                 std::to_string(alertPosition.y) + ")");
     lastAlertTime_ = timeInCurrentState_;
+    if (alertCallback_) {
+        alertCallback_(alertPosition, config_.alertRadius, entity_);
+    }
 }
 
 float AIAgent::getHealthPercentage() const {
@@ -587,48 +995,55 @@ float AIAgent::getHealthPercentage() const {
 
 // Add target management functions
 void AIAgent::addTarget(entities::Entity* target, Priority priority) {
-    if (!target || std::find(targets_.begin(), targets_.end(), target) != targets_.end()) {
+    entities::Entity* evicted = nullptr;
+    float distance = target ? distanceTo(target) : 0.0f;
+    if (targets_.add(target, priority, distance, evicted) != TargetSet::AddResult::Added) {
         return;
     }
-    
-    targets_.push_back(target);
-    targetPriorities_[target] = priority;
-    
-    // Update primary target if this one has higher priority
-    if (!primaryTarget_ || priority > targetPriorities_[primaryTarget_]) {
-        primaryTarget_ = target;
+    if (evicted) noteDropped(evicted);
+    if (targetIndex_) {
+        if (evicted) targetIndex_->unlink(evicted, this);
+        targetIndex_->link(target, this);
     }
 }
 
 void AIAgent::removeTarget(entities::Entity* target) {
-    auto it = std::find(targets_.begin(), targets_.end(), target);
-    if (it != targets_.end()) {
-        targets_.erase(it);
-        targetPriorities_.erase(target);
-        
-        if (primaryTarget_ == target) {
-            // Find new primary target
-            primaryTarget_ = nullptr;
-            Priority bestPriority = Priority::LOW;
-            for (auto* t : targets_) {
-                Priority p = targetPriorities_[t];
-                if (p > bestPriority) {
-                    primaryTarget_ = t;
-                    bestPriority = p;
-                }
-            }
+    if (!targets_.remove(target)) return;
+    noteDropped(target);
+    if (targetIndex_) {
+        targetIndex_->unlink(target, this);
+    }
+}
+
+void AIAgent::noteDropped(const entities::Entity* target) {
+    for (DroppedTarget& dropped : droppedTargets_) {
+        if (dropped.entity == target) {
+            dropped.cursor = blackboardCursor_;
+            return;
         }
     }
+    droppedTargets_[nextDropped_] = DroppedTarget{target, blackboardCursor_};
+    nextDropped_ = (nextDropped_ + 1) % droppedTargets_.size();
+}
+
+bool AIAgent::droppedAfter(const entities::Entity* target, TeamBlackboard::Version version) const {
+    for (const DroppedTarget& dropped : droppedTargets_) {
+        if (dropped.entity == target) return dropped.cursor >= version;
+    }
+    return false;
 }
 
 void AIAgent::clearTargets() {
+    if (targetIndex_) {
+        for (const TargetSet::Entry& target : targets_) {
+            targetIndex_->unlink(target.entity, this);
+        }
+    }
     targets_.clear();
-    targetPriorities_.clear();
-    primaryTarget_ = nullptr;
 }
 
 entities::Entity* AIAgent::getPrimaryTarget() const {
-    return primaryTarget_;
+    return targets_.primary();
 }
 
 // Event handlers
@@ -675,6 +1090,31 @@ void AIAgent::addPatrolPoint(const sf::Vector2f& point) {
     patrolPoints_.push_back(point);
 }
 
+float AIAgent::randomUnit() {
+    // Not uniform_real_distribution: its output differs between standard libraries
+    return static_cast<float>(rng_() - std::minstd_rand::min()) /
+           (static_cast<float>(std::minstd_rand::max() - std::minstd_rand::min()) + 1.0f);
+}
+
+void AIAgent::hashState(StateHash& hash) const {
+    hash.add(entity_ ? entity_->id() : 0u);
+    hash.add(getEntityPosition());
+    hash.add(static_cast<int>(currentState_));
+    hash.add(timeInCurrentState_);
+    entities::Entity* primary = targets_.primary();
+    hash.add(primary ? primary->id() : 0u);
+    hash.add(static_cast<std::uint64_t>(targets_.size()));
+    hash.add(static_cast<std::uint64_t>(currentPatrolIndex_));
+    hash.add(static_cast<std::uint64_t>(currentPath_.size()));
+    hash.add(static_cast<std::uint64_t>(currentPathIndex_));
+    hash.add(targetPosition_);
+    hash.add(alertTimer_);
+    hash.add(investigationTimer_);
+    hash.add(attackCooldown_);
+    hash.add(pathRetryTimer_);
+    hash.add(blackboardCursor_);
+}
+
 // Helper functions
 float AIAgent::distanceTo(const sf::Vector2f& position) const {
     sf::Vector2f entityPos = getEntityPosition();
@@ -687,6 +1127,21 @@ float AIAgent::distanceTo(entities::Entity* entity) const {
     return distanceTo(entity->position());
 }
 
+void AIAgent::ingestPerception(const PerceptionBatch& batch, std::size_t slot) {
+    // Reuses the vector's capacity: no allocation once it has grown to the ring size
+    recentPerceptions_.clear();
+    std::size_t count = batch.eventCount(slot);
+    for (std::size_t i = 0; i < count; ++i) {
+        recentPerceptions_.push_back(batch.event(slot, i));
+    }
+    perceptionIngested_ = true;
+    
+    // This tick's profile starts with the agent's share of the sweep
+    tickProfile_ = TickProfile{};
+    tickProfile_.perceptionMs = batch.observerTime(slot);
+    tickProfile_.candidates = batch.candidateCount(slot);
+}
+
 sf::Vector2f AIAgent::getEntityPosition() const {
     return entity_ ? entity_->position() : sf::Vector2f(0, 0);
 }
@@ -704,7 +1159,9 @@ AIAgent::DebugInfo AIAgent::getDebugInfo() const {
     info.profile = config_.profile;
     info.currentPath = currentPath_;
     info.patrolPoints = patrolPoints_;
-    info.currentTargets = targets_;
+    for (const TargetSet::Entry& target : targets_) {
+        info.currentTargets.push_back(target.entity);
+    }
     info.lastPerceptionEvents = recentPerceptions_;
     info.targetPosition = targetPosition_;
     info.timeInCurrentState = timeInCurrentState_;
@@ -3,12 +3,23 @@
 
 #include "AIState.h"
 #include "Perception.h"
+#include "PerceptionBatch.h"
 #include "Pathfinding.h"
+#include "PathRequestQueue.h"
+#include "IncrementalPlanner.h"
+#include "NavMesh.h"
+#include "BehaviorTree.h"
+#include "TeamBlackboard.h"
+#include "TargetSet.h"
+#include "DeterministicStep.h"
 #include <SFML/System/Vector2.hpp>
+#include <array>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <functional>
+#include <random>
 
 namespace entities { 
     class Entity; 
@@ -27,16 +38,22 @@ struct BehaviorDecision {
     sf::Vector2f targetPosition;
     entities::Entity* targetEntity;
     std::string reason;
+    bool raiseAlert;                 // Alert nearby agents about alertPosition when applied
+    sf::Vector2f alertPosition;
     
     BehaviorDecision(AIState state = AIState::IDLE, Priority prio = Priority::LOW)
-        : newState(state), priority(prio), targetPosition(0, 0), targetEntity(nullptr), reason("") {}
+        : newState(state), priority(prio), targetPosition(0, 0), targetEntity(nullptr), reason("")
+        , raiseAlert(false), alertPosition(0, 0) {}
 };
 
 // AI agent configuration
 struct AIAgentConfig {
     BehaviorProfile profile = BehaviorProfile::NEUTRAL;
+    std::string behaviorTree;                    // Tree loaded into the AIManager under this name (empty = profile rules)
     PerceptionConfig perception;
     PathfindingConfig pathfinding;
+    bool incrementalReplanning = false;          // Keep a D* Lite search per agent (needs a nav grid)
+    IncrementalPlannerConfig incrementalPlanner;
     
     // Behavior parameters
     float healthThreshold = 0.2f;       // When to flee (20% health)
@@ -54,9 +71,11 @@ struct AIAgentConfig {
     // Coordination
     bool canAlertOthers = true;         // Can alert other AIs
     float alertRadius = 200.0f;         // How far alerts reach
+    // Team blackboard slots this agent reacts to (changes to other slots are skipped)
+    TeamBlackboard::Mask blackboardSubscriptions = TeamBlackboard::maskOf(TeamBlackboard::Slot::TargetPosition);
     
     // Multi-target support
-    int maxTargets = 3;                 // Maximum simultaneous targets
+    int maxTargets = 3;                 // Maximum simultaneous targets (up to TargetSet::kCapacity)
     bool prioritizePlayerTargets = true; // Players have higher priority
 };
 
@@ -66,10 +85,39 @@ public:
     explicit AIAgent(entities::Entity* entity, const AIAgentConfig& config = AIAgentConfig{});
     ~AIAgent();
     
-    // Main update loop
+    // Main update loop (think() followed by commit())
     void update(float deltaTime, entities::EntityManager* entityManager, 
                 collisions::CollisionManager* collisionManager);
     
+    // Two-phase update. think() runs timers, perception and the decision and
+    // only writes this agent's own state, so agents may think concurrently as
+    // long as nothing moves meanwhile. commit() applies the pending decision:
+    // state change, alerts, path queries and movement; commits must run serially.
+    void think(float deltaTime, entities::EntityManager* entityManager,
+               collisions::CollisionManager* collisionManager);
+    void commit(float deltaTime, collisions::CollisionManager* collisionManager);
+    
+    // commit() in steps, for managers that group agents by state: apply the
+    // pending decision (false when no behavior runs this frame), run the
+    // current state's behavior, then move. Behaviors only request movement;
+    // applyMovement() or a batched kernel moves the entity.
+    bool applyDecision(float deltaTime);
+    void executeState(float deltaTime, collisions::CollisionManager* collisionManager);
+    // One state's behavior, looked up once per batch of agents in that state
+    // instead of switching on every agent's state
+    using StateBehavior = void (*)(AIAgent&, float, collisions::CollisionManager*);
+    static StateBehavior behaviorFor(AIState state);
+    void executeState(StateBehavior behavior, float deltaTime, collisions::CollisionManager* collisionManager);
+    void executeLowDetail(float deltaTime);
+    void applyMovement(float deltaTime);
+    bool hasMovementRequest() const { return moveRequested_; }
+    const sf::Vector2f& getMovementTarget() const { return moveTarget_; }
+    void clearMovementRequest() { moveRequested_ = false; }
+    
+    // Far-away LOD tick: timers and straight-line patrol interpolation only
+    // (no perception, decisions or path queries)
+    void updateLowDetail(float deltaTime);
+    
     // State management
     void changeState(AIState newState, const std::string& reason = "");
     AIState getCurrentState() const { return currentState_; }
@@ -84,7 +132,7 @@ public:
     void clearTarget();
     sf::Vector2f getTargetPosition() const;
     entities::Entity* getPrimaryTarget() const;
-    const std::vector<entities::Entity*>& getAllTargets() const { return targets_; }
+    const TargetSet& getAllTargets() const { return targets_; }
     
     // State management
     void setState(AIState state);
@@ -101,10 +149,66 @@ public:
     void addPatrolPoint(const sf::Vector2f& point);
     const std::vector<sf::Vector2f>& getPatrolPoints() const { return patrolPoints_; }
     
+    // Behavior tree replacing the profile rules (not owned, nullptr = profile rules)
+    void setBehaviorTree(const BehaviorTree* tree);
+    const BehaviorTree* getBehaviorTree() const { return behaviorTree_; }
+    const BehaviorTree::Blackboard& getBlackboard() const { return blackboard_; }
+    
     // Configuration
-    void setConfig(const AIAgentConfig& config) { config_ = config; }
+    void setConfig(const AIAgentConfig& config);
     const AIAgentConfig& getConfig() const { return config_; }
     
+    // Asynchronous pathfinding (nullptr = synchronous findPath)
+    void setPathRequestQueue(PathRequestQueue* queue);
+    PathRequestQueue* getPathRequestQueue() const { return pathQueue_; }
+    bool isWaitingForPath() const { return pendingPathRequest_ != kInvalidPathRequest; }
+    
+    // Incremental replanning grid (used when config.incrementalReplanning is set)
+    void setNavGrid(const NavGrid* navGrid);
+    
+    // Baked navmesh; small enough to query inline, preferred over queued grid searches
+    void setNavMesh(NavMesh* navMesh) { navMesh_ = navMesh; }
+    
+    // Baked static visibility for sight checks (not owned)
+    void setVisibilityTable(const VisibilityTable* table) { perceptionSystem_->setVisibilityTable(table); }
+    // Propagated sound fields heard by the agent's own perception pass (not owned)
+    void setSoundPropagation(const SoundPropagation* sound) { perceptionSystem_->setSoundPropagation(sound); }
+    // Shared memory ring store (not owned); null keeps a private one
+    void setPerceptionMemory(PerceptionMemory* memory) { perceptionSystem_->setMemoryStore(memory); }
+    // Reverse index kept in sync with this agent's targets (must outlive the agent)
+    void setTargetIndex(TargetIndex* index);
+    const PerceptionSystem& getPerceptionSystem() const { return *perceptionSystem_; }
+    PerceptionSystem& getPerceptionSystem() { return *perceptionSystem_; }
+    // Monotonic agent time used to stamp and decay memories
+    float getPerceptionClock() const { return perceptionClock_; }
+    const IncrementalPlanner* getIncrementalPlanner() const { return incrementalPlanner_.get(); }
+    
+    // Receiver for this agent's alerts (position, radius, source); without one alerts are only logged
+    using AlertCallback = std::function<void(const sf::Vector2f&, float, entities::Entity*)>;
+    void setAlertCallback(AlertCallback callback) { alertCallback_ = std::move(callback); }
+    // Per-agent random stream, seeded by the manager from its seed and the
+    // entity id so draws do not depend on update order or thread count
+    void seedRandom(std::uint32_t seed) { rng_.seed(seed); }
+    float randomUnit();                 // Uniform in [0, 1)
+    // Feed the state that decides future behavior into a deterministic-mode hash
+    void hashState(StateHash& hash) const;
+    // Last team blackboard version this agent has processed
+    TeamBlackboard::Version getBlackboardCursor() const { return blackboardCursor_; }
+    void setBlackboardCursor(TeamBlackboard::Version version) { blackboardCursor_ = version; }
+    // Handoff cell the manager last checked standing targets from
+    const sf::Vector2i& getBlackboardCell() const { return blackboardCell_; }
+    void setBlackboardCell(const sf::Vector2i& cell) { blackboardCell_ = cell; }
+    // True when the agent let go of target after reading the blackboard up to
+    // version, i.e. it already knew that report and chose to drop it
+    bool droppedAfter(const entities::Entity* target, TeamBlackboard::Version version) const;
+    
+    // Batched perception: events computed by the manager-level stage replace
+    // the agent's own perception pass on its next update()
+    void ingestPerception(const PerceptionBatch& batch, std::size_t slot);
+    entities::Entity* getEntity() const { return entity_; }
+    sf::Vector2f getEntityPosition() const;
+    sf::Vector2f getFacingDirection() const;
+    
     // Debug information
     struct DebugInfo {
         AIState currentState;
@@ -123,11 +227,26 @@ public:
     struct PerformanceStats {
         int perceptionChecks = 0;
         int pathfindingRequests = 0;
+        int pathCacheHits = 0;      // Queued requests served from the path cache
+        int pathCacheMisses = 0;    // Queued requests that went to a real search
         int stateChanges = 0;
         float averageUpdateTime = 0.0f;
     };
     const PerformanceStats& getPerformanceStats() const { return performanceStats_; }
     void resetPerformanceStats();
+    
+    // Cost of the last full tick by stage, with what drove it
+    struct TickProfile {
+        float perceptionMs = 0.0f;      // Own perception pass, or the agent's share of the batched sweep
+        float decisionMs = 0.0f;        // makeDecision in think()
+        float commitMs = 0.0f;          // applyDecision (alerts, state change)
+        float behaviorMs = 0.0f;        // State behavior, including path queries
+        int candidates = 0;             // Targets tested by the batched sweep
+        int perceptionEvents = 0;
+        int pathLength = 0;             // Waypoints of the current path after the behavior step
+        int pathRequests = 0;           // Searches started by the behavior step
+    };
+    const TickProfile& getTickProfile() const { return tickProfile_; }
 
 private:
     entities::Entity* entity_;
@@ -144,9 +263,8 @@ private:
     std::unique_ptr<PathfindingSystem> pathfindingSystem_;
     
     // Targets and priorities
-    std::vector<entities::Entity*> targets_;
-    std::unordered_map<entities::Entity*, Priority> targetPriorities_;
-    entities::Entity* primaryTarget_;
+    TargetSet targets_;
+    TargetIndex* targetIndex_;
     
     // Simple target tracking (for Strategy Pattern)
     bool hasSimpleTarget_;
@@ -160,8 +278,25 @@ private:
     size_t currentPathIndex_;
     sf::Vector2f targetPosition_;
     
+    // Queued path requests
+    PathRequestQueue* pathQueue_;
+    PathRequestId pendingPathRequest_;
+    sf::Vector2f requestedDestination_;
+    sf::Vector2f steeringTarget_;
+    bool directSteering_;
+    float pathRetryTimer_;
+    std::minstd_rand rng_;
+    
+    // Incremental replanning and navmesh
+    NavMesh* navMesh_;
+    const NavGrid* navGrid_;
+    std::unique_ptr<IncrementalPlanner> incrementalPlanner_;
+    std::uint32_t plannerPathRevision_;
+    
     // Memory and awareness
     std::vector<PerceptionEvent> recentPerceptions_;
+    bool perceptionIngested_;
+    float perceptionClock_;
     sf::Vector2f lastKnownPlayerPosition_;
     float timeSincePlayerSeen_;
     bool isAlert_;
@@ -170,6 +305,17 @@ private:
     // Coordination
     std::vector<AIAgent*> nearbyAgents_;
     float lastAlertTime_;
+    AlertCallback alertCallback_;
+    TeamBlackboard::Version blackboardCursor_;
+    sf::Vector2i blackboardCell_;
+    // Recently removed or evicted targets with the cursor at the time, oldest overwritten
+    struct DroppedTarget {
+        const entities::Entity* entity = nullptr;
+        TeamBlackboard::Version cursor = 0;
+    };
+    std::array<DroppedTarget, TargetSet::kCapacity> droppedTargets_;
+    std::size_t nextDropped_;
+    void noteDropped(const entities::Entity* target);
     
     // Timers and cooldowns
     float investigationTimer_;
@@ -177,8 +323,24 @@ private:
     float attackCooldown_;
     float fleeCooldown_;
     
+    // Data-driven decisions (tree shared between agents, blackboard per agent)
+    const BehaviorTree* behaviorTree_;
+    BehaviorTree::Blackboard blackboard_;
+    
+    // Intent written by think() and consumed by commit()
+    enum class Intent { None, Stunned, Decided };
+    Intent intent_;
+    BehaviorDecision pendingDecision_;
+    AIState intentBaseState_;           // State the pending decision was made from
+    
+    // Movement requested by the last behavior step
+    bool moveRequested_;
+    sf::Vector2f moveTarget_;
+    float thinkTime_;                   // Milliseconds spent in the last think()
+    
     // Performance tracking
     PerformanceStats performanceStats_;
+    TickProfile tickProfile_;
     float updateTimeAccumulator_;
     int updateCount_;
     
@@ -186,6 +348,10 @@ private:
     BehaviorDecision makeDecision(const std::vector<PerceptionEvent>& perceptions,
                                  entities::EntityManager* entityManager,
                                  collisions::CollisionManager* collisionManager);
+    bool decideFromProfile(const std::vector<PerceptionEvent>& perceptions, BehaviorDecision& decision);
+    bool decideFromTree(const std::vector<PerceptionEvent>& perceptions, BehaviorDecision& decision);
+    entities::Entity* findBestTarget(const std::vector<PerceptionEvent>& perceptions, Priority& bestPriority) const;
+    sf::Vector2f fleePosition(const std::vector<PerceptionEvent>& perceptions) const;
     
     // Behavior implementations
     void executeIdle(float deltaTime);
@@ -199,20 +365,27 @@ private:
     void executeStunned(float deltaTime);
     
     // Utility functions
+    void tickTimers(float deltaTime);
     bool shouldFlee() const;
     bool shouldAttack(entities::Entity* target) const;
     bool isTargetValid(entities::Entity* target) const;
     Priority calculateTargetPriority(entities::Entity* target) const;
     void updatePath(const sf::Vector2f& destination, collisions::CollisionManager* cm);
+    void updatePathAsync(const sf::Vector2f& destination);
+    void updatePathIncremental(const sf::Vector2f& destination);
+    void updatePathNavMesh(const sf::Vector2f& destination);
+    void cancelPathRequest();
+    Priority pathRequestPriority() const;
+    float pathAgentRadius() const;
     void followPath(float deltaTime, collisions::CollisionManager* cm);
+    void steerTowards(const sf::Vector2f& point);
+    void addUpdateTime(float milliseconds, bool newSample);
     void alertNearbyAgents(const sf::Vector2f& alertPosition);
     float getHealthPercentage() const;
     
     // Helper functions
     float distanceTo(const sf::Vector2f& position) const;
     float distanceTo(entities::Entity* entity) const;
-    sf::Vector2f getEntityPosition() const;
-    sf::Vector2f getFacingDirection() const;
 };
 
 } // namespace ai
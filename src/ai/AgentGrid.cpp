@@ -0,0 +1,119 @@
+#include "AgentGrid.h"
+#include "AISystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ai {
+
+AgentGrid::AgentGrid(const AgentGridConfig& config)
+    : config_(config)
+    , dirty_(true)
+    , origin_(0.f, 0.f)
+    , cellSize_(config.cellSize)
+    , columns_(0)
+    , rows_(0)
+{
+}
+
+void AgentGrid::rebuild(const std::vector<AIAgent*>& agents) {
+    dirty_ = false;
+    ++stats_.rebuilds;
+
+    positions_.resize(agents.size());
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        positions_[i] = agents[i]->getEntityPosition();
+    }
+    if (agents.empty()) {
+        columns_ = rows_ = 0;
+        cellStart_.assign(1, 0);
+        cellAgents_.clear();
+        cellX_.clear();
+        cellY_.clear();
+        return;
+    }
+
+    sf::Vector2f minPos = positions_.front();
+    sf::Vector2f maxPos = minPos;
+    for (const auto& p : positions_) {
+        minPos.x = std::min(minPos.x, p.x);
+        minPos.y = std::min(minPos.y, p.y);
+        maxPos.x = std::max(maxPos.x, p.x);
+        maxPos.y = std::max(maxPos.y, p.y);
+    }
+
+    // Same bound as the entity grid: widen cells for far-flung agents
+    constexpr float kMaxCellsPerAxis = 256.f;
+    float extent = std::max(maxPos.x - minPos.x, maxPos.y - minPos.y);
+    cellSize_ = std::max(std::max(config_.cellSize, 1.0f), extent / kMaxCellsPerAxis);
+    origin_ = minPos;
+    columns_ = static_cast<int>((maxPos.x - minPos.x) / cellSize_) + 1;
+    rows_ = static_cast<int>((maxPos.y - minPos.y) / cellSize_) + 1;
+
+    std::size_t cellCount = static_cast<std::size_t>(columns_) * rows_;
+    cellStart_.assign(cellCount + 1, 0);
+    agentCell_.resize(agents.size());
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        const sf::Vector2f& p = positions_[i];
+        int cx = std::min(static_cast<int>((p.x - minPos.x) / cellSize_), columns_ - 1);
+        int cy = std::min(static_cast<int>((p.y - minPos.y) / cellSize_), rows_ - 1);
+        agentCell_[i] = cy * columns_ + cx;
+        ++cellStart_[agentCell_[i] + 1];
+    }
+    for (std::size_t c = 0; c < cellCount; ++c) {
+        cellStart_[c + 1] += cellStart_[c];
+    }
+    // Scatter using cellStart_ as write cursors, then shift the starts back
+    cellAgents_.resize(agents.size());
+    cellX_.resize(agents.size());
+    cellY_.resize(agents.size());
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        int slot = cellStart_[agentCell_[i]]++;
+        cellAgents_[slot] = agents[i];
+        cellX_[slot] = positions_[i].x;
+        cellY_[slot] = positions_[i].y;
+    }
+    for (std::size_t c = cellCount; c > 0; --c) {
+        cellStart_[c] = cellStart_[c - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+void AgentGrid::query(const sf::Vector2f& center, float radius, std::vector<AIAgent*>& out,
+                      const AIAgent* exclude) {
+    out.clear();
+    ++stats_.queries;
+    if (radius < 0.f || columns_ == 0) return;
+
+    float maxX = origin_.x + columns_ * cellSize_;
+    float maxY = origin_.y + rows_ * cellSize_;
+    if (center.x + radius < origin_.x || center.y + radius < origin_.y ||
+        center.x - radius > maxX || center.y - radius > maxY) {
+        return;
+    }
+
+    auto toCell = [this](float value, float origin, int limit) {
+        int cell = static_cast<int>(std::floor((value - origin) / cellSize_));
+        return std::max(0, std::min(cell, limit - 1));
+    };
+    int x0 = toCell(center.x - radius, origin_.x, columns_);
+    int x1 = toCell(center.x + radius, origin_.x, columns_);
+    int y0 = toCell(center.y - radius, origin_.y, rows_);
+    int y1 = toCell(center.y + radius, origin_.y, rows_);
+    float radiusSquared = radius * radius;
+
+    for (int y = y0; y <= y1; ++y) {
+        int row = y * columns_;
+        int begin = cellStart_[row + x0];
+        int end = cellStart_[row + x1 + 1];
+        stats_.candidatesTested += end - begin;
+        for (int i = begin; i < end; ++i) {
+            float dx = cellX_[i] - center.x;
+            float dy = cellY_[i] - center.y;
+            if (dx * dx + dy * dy <= radiusSquared && cellAgents_[i] != exclude) {
+                out.push_back(cellAgents_[i]);
+            }
+        }
+    }
+}
+
+} // namespace ai
@@ -0,0 +1,66 @@
+#ifndef ABYSSAL_STATION_SRC_AI_AGENTGRID_H
+#define ABYSSAL_STATION_SRC_AI_AGENTGRID_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace ai {
+
+class AIAgent;
+
+// Configuration for the agent broadcast grid
+struct AgentGridConfig {
+    float cellSize = 256.0f;            // Roughly the typical alert radius
+};
+
+// Uniform grid over AI agent positions for radius broadcasts (alerts, sounds,
+// coordination). Rebuilt once per frame by counting sort: agents and their
+// position snapshot are stored contiguously in cell order, so a query only
+// scans the cells its circle touches.
+class AgentGrid {
+public:
+    explicit AgentGrid(const AgentGridConfig& config = AgentGridConfig{});
+
+    void rebuild(const std::vector<AIAgent*>& agents);
+    void invalidate() { dirty_ = true; }
+    bool isDirty() const { return dirty_; }
+
+    // Agents whose snapshot position lies within radius of center, in cell
+    // order (deterministic), written into out (cleared first)
+    void query(const sf::Vector2f& center, float radius, std::vector<AIAgent*>& out,
+               const AIAgent* exclude = nullptr);
+
+    std::size_t size() const { return cellAgents_.size(); }
+    void setConfig(const AgentGridConfig& config) { config_ = config; dirty_ = true; }
+    const AgentGridConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int rebuilds = 0;
+        int queries = 0;
+        int candidatesTested = 0;   // Agents distance-tested by queries
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    AgentGridConfig config_;
+    bool dirty_;
+    sf::Vector2f origin_;
+    float cellSize_;
+    int columns_;
+    int rows_;
+
+    // cellStart_[c]..cellStart_[c + 1] indexes the agents of cell c
+    std::vector<int> cellStart_;
+    std::vector<int> agentCell_;
+    std::vector<AIAgent*> cellAgents_;
+    std::vector<float> cellX_;
+    std::vector<float> cellY_;
+    std::vector<sf::Vector2f> positions_;
+    Stats stats_;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_AGENTGRID_H
@@ -0,0 +1,156 @@
+#include "AgentProfiler.h"
+#include "AISystem.h"
+#include "../core/Logger.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace ai {
+
+using json = nlohmann::json;
+
+namespace {
+
+bool slower(const AgentProfiler::Sample& a, const AgentProfiler::Sample& b) {
+    return a.totalMs > b.totalMs;
+}
+
+} // namespace
+
+AgentProfiler::AgentProfiler(const AgentProfilerConfig& config)
+    : config_(config)
+    , lastSpikeLogFrame_(0)
+{
+}
+
+void AgentProfiler::recordFrame(const std::vector<AIAgent*>& agents) {
+    if (!config_.enabled) return;
+    ++stats_.frames;
+    std::size_t limit = static_cast<std::size_t>(std::max(config_.topK, 1));
+
+    // Frame top K, kept sorted; K is small so insertion beats a heap
+    frameSlowest_.clear();
+    for (const AIAgent* agent : agents) {
+        if (!agent || !agent->getEntity()) continue;
+        const AIAgent::TickProfile& tick = agent->getTickProfile();
+        std::array<float, kStageCount> stages{tick.perceptionMs, tick.decisionMs, tick.commitMs, tick.behaviorMs};
+        float total = stages[0] + stages[1] + stages[2] + stages[3];
+        ++stats_.samples;
+        if (total > config_.spikeThresholdMs) ++stats_.spikes;
+        if (frameSlowest_.size() == limit && total <= frameSlowest_.back().totalMs) continue;
+
+        Sample sample;
+        sample.frame = stats_.frames;
+        sample.entityId = agent->getEntity()->id();
+        sample.state = agent->getCurrentState();
+        sample.totalMs = total;
+        sample.stageMs = stages;
+        sample.slowestStage = static_cast<Stage>(std::max_element(stages.begin(), stages.end()) - stages.begin());
+        sample.candidates = tick.candidates;
+        sample.perceptionEvents = tick.perceptionEvents;
+        sample.pathLength = tick.pathLength;
+        sample.pathRequests = tick.pathRequests;
+        frameSlowest_.insert(std::upper_bound(frameSlowest_.begin(), frameSlowest_.end(), sample, slower), sample);
+        if (frameSlowest_.size() > limit) frameSlowest_.pop_back();
+    }
+
+    // Rolling list: expire old entries, then keep each agent's worst tick
+    std::uint64_t window = static_cast<std::uint64_t>(std::max(config_.windowFrames, 1));
+    slowest_.erase(std::remove_if(slowest_.begin(), slowest_.end(),
+                                  [&](const Sample& s) { return stats_.frames - s.frame >= window; }),
+                   slowest_.end());
+    for (const Sample& sample : frameSlowest_) {
+        auto same = std::find_if(slowest_.begin(), slowest_.end(),
+                                 [&](const Sample& s) { return s.entityId == sample.entityId; });
+        if (same == slowest_.end()) {
+            slowest_.push_back(sample);
+        } else if (sample.totalMs >= same->totalMs) {
+            *same = sample;
+        }
+    }
+    std::stable_sort(slowest_.begin(), slowest_.end(), slower);
+    if (slowest_.size() > limit) slowest_.resize(limit);
+
+    if (!frameSlowest_.empty() && frameSlowest_.front().totalMs > config_.spikeThresholdMs &&
+        (lastSpikeLogFrame_ == 0 ||
+         stats_.frames - lastSpikeLogFrame_ >= static_cast<std::uint64_t>(std::max(config_.spikeLogCooldownFrames, 1)))) {
+        lastSpikeLogFrame_ = stats_.frames;
+        core::Logger::instance().warning("[AI] Slow agent tick: " + describe(frameSlowest_.front()));
+    }
+}
+
+void AgentProfiler::clear() {
+    slowest_.clear();
+    frameSlowest_.clear();
+    lastSpikeLogFrame_ = 0;
+    stats_ = Stats{};
+}
+
+const char* AgentProfiler::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Perception: return "perception";
+        case Stage::Decision:   return "decision";
+        case Stage::Commit:     return "commit";
+        case Stage::Behavior:   return "behavior";
+    }
+    return "unknown";
+}
+
+std::string AgentProfiler::describe(const Sample& sample) {
+    char text[192];
+    std::snprintf(text, sizeof(text), "agent %u %s %.2f ms, %s %.2f ms (path %d waypoints, %d path request%s, %d candidates)",
+                  static_cast<unsigned>(sample.entityId), stateToString(sample.state), sample.totalMs,
+                  stageName(sample.slowestStage), sample.stageMs[static_cast<std::size_t>(sample.slowestStage)],
+                  sample.pathLength, sample.pathRequests, sample.pathRequests == 1 ? "" : "s", sample.candidates);
+    return text;
+}
+
+std::string AgentProfiler::serialize() const {
+    auto toJson = [](const std::vector<Sample>& samples) {
+        json list = json::array();
+        for (const Sample& sample : samples) {
+            json stages = json::object();
+            for (std::size_t stage = 0; stage < kStageCount; ++stage) {
+                stages[stageName(static_cast<Stage>(stage))] = sample.stageMs[stage];
+            }
+            list.push_back({
+                {"frame", sample.frame},
+                {"entity", sample.entityId},
+                {"state", stateToString(sample.state)},
+                {"totalMs", sample.totalMs},
+                {"stagesMs", stages},
+                {"slowestStage", stageName(sample.slowestStage)},
+                {"candidates", sample.candidates},
+                {"perceptionEvents", sample.perceptionEvents},
+                {"pathLength", sample.pathLength},
+                {"pathRequests", sample.pathRequests},
+                {"reason", describe(sample)},
+            });
+        }
+        return list;
+    };
+
+    json root;
+    root["frames"] = stats_.frames;
+    root["samples"] = stats_.samples;
+    root["spikes"] = stats_.spikes;
+    root["spikeThresholdMs"] = config_.spikeThresholdMs;
+    root["windowFrames"] = config_.windowFrames;
+    root["slowest"] = toJson(slowest_);
+    root["lastFrame"] = toJson(frameSlowest_);
+    return root.dump(2);
+}
+
+bool AgentProfiler::saveToFile(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.good()) {
+        core::Logger::instance().error("[AI] AgentProfiler: failed to open for writing: " + path);
+        return false;
+    }
+    out << serialize();
+    core::Logger::instance().info("[AI] Agent profile saved to " + path);
+    return true;
+}
+
+} // namespace ai
@@ -0,0 +1,328 @@
+#include "BehaviorTree.h"
+#include "core/Logger.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace ai {
+
+namespace {
+
+const char* const kFactNames[] = {
+    "health", "shouldFlee", "hasTarget", "targetDistance", "targetPriority", "canAttack",
+    "attackRange", "threatCount", "timeSinceSeen", "investigationTime", "alertTimer",
+    "hasPatrol", "patrolDistance", "state", "timeInState"
+};
+static_assert(sizeof(kFactNames) / sizeof(kFactNames[0]) == static_cast<std::size_t>(BehaviorFact::Count),
+              "every fact needs a name");
+
+constexpr std::uint8_t kFactCount = static_cast<std::uint8_t>(BehaviorFact::Count);
+
+bool parseState(const std::string& name, AIState& state) {
+    for (int i = 0; i <= static_cast<int>(AIState::DEAD); ++i) {
+        if (name == stateToString(static_cast<AIState>(i))) {
+            state = static_cast<AIState>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parsePriority(const std::string& name, Priority& priority) {
+    for (Priority candidate : {Priority::LOW, Priority::MEDIUM, Priority::HIGH, Priority::CRITICAL}) {
+        if (name == priorityToString(candidate)) {
+            priority = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// Recursive JSON -> pre-order node array translation; throws on malformed input
+class BehaviorTree::Compiler {
+public:
+    explicit Compiler(BehaviorTree& tree) : tree_(tree) {}
+
+    void compile(const json& j) {
+        if (!j.is_object()) {
+            throw std::runtime_error("node must be an object");
+        }
+        std::int32_t index = static_cast<std::int32_t>(tree_.nodes_.size());
+        tree_.nodes_.emplace_back();
+
+        if (j.contains("selector") || j.contains("sequence")) {
+            bool selector = j.contains("selector");
+            tree_.nodes_[index].type = selector ? NodeType::Selector : NodeType::Sequence;
+            for (const auto& child : j.at(selector ? "selector" : "sequence")) {
+                compile(child);
+            }
+        } else if (j.contains("utility")) {
+            tree_.nodes_[index].type = NodeType::Utility;
+            for (const auto& option : j.at("utility")) {
+                compileScored(option);
+            }
+        } else if (j.contains("if")) {
+            Node& node = tree_.nodes_[index];
+            node.type = NodeType::Condition;
+            node.arg0 = parseOperand(j.at("if").get<std::string>());
+            node.arg1 = static_cast<std::uint8_t>(parseCompare(j.value("op", "==")));
+            compileValue(node, j.at("value"));
+        } else if (j.contains("set")) {
+            Node& node = tree_.nodes_[index];
+            node.type = NodeType::Set;
+            node.arg0 = slot(j.at("set").get<std::string>());
+            node.flags = j.value("add", false) ? kFlagAdd : 0;
+            node.value[0] = j.value("value", 0.0f);
+        } else if (j.contains("action")) {
+            compileAction(tree_.nodes_[index], j);
+        } else {
+            throw std::runtime_error("unknown node kind");
+        }
+        tree_.nodes_[index].end = static_cast<std::int32_t>(tree_.nodes_.size());
+    }
+
+private:
+    BehaviorTree& tree_;
+
+    void compileScored(const json& option) {
+        std::int32_t index = static_cast<std::int32_t>(tree_.nodes_.size());
+        tree_.nodes_.emplace_back();
+        const json& score = option.at("score");
+        Node& node = tree_.nodes_[index];
+        node.type = NodeType::Scored;
+        node.arg0 = parseOperand(score.at("fact").get<std::string>());
+        node.arg1 = static_cast<std::uint8_t>(parseCurve(score.value("curve", "linear")));
+        node.value[0] = score.value("min", 0.0f);
+        node.value[1] = score.value("max", 1.0f);
+        node.value[2] = score.value("weight", 1.0f);
+        compile(option.at("node"));
+        tree_.nodes_[index].end = static_cast<std::int32_t>(tree_.nodes_.size());
+    }
+
+    void compileValue(Node& node, const json& value) {
+        if (value.is_number()) {
+            node.value[0] = value.get<float>();
+            return;
+        }
+        std::string name = value.get<std::string>();
+        AIState state;
+        Priority priority;
+        if (parseState(name, state)) {
+            node.value[0] = static_cast<float>(state);
+        } else if (parsePriority(name, priority)) {
+            node.value[0] = static_cast<float>(priority);
+        } else {
+            node.flags = kFlagOperand;
+            node.data = parseOperand(name);
+        }
+    }
+
+    void compileAction(Node& node, const json& j) {
+        node.type = NodeType::Action;
+        AIState state;
+        if (!parseState(j.at("action").get<std::string>(), state)) {
+            throw std::runtime_error("unknown state " + j.at("action").get<std::string>());
+        }
+        Priority priority = Priority::MEDIUM;
+        if (j.contains("priority") && !parsePriority(j.at("priority").get<std::string>(), priority)) {
+            throw std::runtime_error("unknown priority " + j.at("priority").get<std::string>());
+        }
+        node.arg0 = static_cast<std::uint8_t>(state);
+        node.arg1 = static_cast<std::uint8_t>(priority);
+
+        std::string moveTo = j.value("moveTo", "none");
+        if (moveTo == "target") node.data = static_cast<std::int32_t>(MoveTo::Target);
+        else if (moveTo == "flee") node.data = static_cast<std::int32_t>(MoveTo::Flee);
+        else if (moveTo == "none") node.data = static_cast<std::int32_t>(MoveTo::None);
+        else throw std::runtime_error("unknown moveTo " + moveTo);
+
+        if (j.value("targetEntity", false)) node.flags |= kFlagTarget;
+        if (j.value("alert", false)) node.flags |= kFlagAlert;
+        if (j.contains("reason")) {
+            node.reason = static_cast<std::int32_t>(tree_.reasons_.size());
+            tree_.reasons_.push_back(j.at("reason").get<std::string>());
+        }
+    }
+
+    std::uint8_t parseOperand(const std::string& name) {
+        if (name.compare(0, 3, "bb.") == 0) {
+            return static_cast<std::uint8_t>(kFactCount + slot(name.substr(3)));
+        }
+        for (std::uint8_t i = 0; i < kFactCount; ++i) {
+            if (name == kFactNames[i]) return i;
+        }
+        throw std::runtime_error("unknown fact " + name);
+    }
+
+    std::uint8_t slot(const std::string& name) {
+        auto& names = tree_.slotNames_;
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it != names.end()) return static_cast<std::uint8_t>(it - names.begin());
+        if (names.size() >= kBlackboardSlots) {
+            throw std::runtime_error("too many blackboard entries");
+        }
+        names.push_back(name);
+        return static_cast<std::uint8_t>(names.size() - 1);
+    }
+
+    static Compare parseCompare(const std::string& op) {
+        if (op == "<") return Compare::Less;
+        if (op == "<=") return Compare::LessEqual;
+        if (op == ">") return Compare::Greater;
+        if (op == ">=") return Compare::GreaterEqual;
+        if (op == "==") return Compare::Equal;
+        if (op == "!=") return Compare::NotEqual;
+        throw std::runtime_error("unknown operator " + op);
+    }
+
+    static Curve parseCurve(const std::string& curve) {
+        if (curve == "linear") return Curve::Linear;
+        if (curve == "inverse") return Curve::Inverse;
+        if (curve == "quadratic") return Curve::Quadratic;
+        if (curve == "step") return Curve::Step;
+        throw std::runtime_error("unknown curve " + curve);
+    }
+};
+
+bool BehaviorTree::loadFromString(const std::string& data) {
+    BehaviorTree compiled;
+    try {
+        json j = json::parse(data);
+        Compiler(compiled).compile(j.at("root"));
+    } catch (const std::exception& ex) {
+        core::Logger::instance().error(std::string("[AI] BehaviorTree: failed to compile: ") + ex.what());
+        return false;
+    }
+    *this = std::move(compiled);
+    return true;
+}
+
+bool BehaviorTree::loadFromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.good()) {
+        core::Logger::instance().warning("[AI] BehaviorTree: file not found: " + path);
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!loadFromString(data)) return false;
+
+    core::Logger::instance().info("[AI] BehaviorTree loaded from " + path + " (" +
+                                  std::to_string(nodes_.size()) + " nodes)");
+    return true;
+}
+
+void BehaviorTree::clear() {
+    nodes_.clear();
+    reasons_.clear();
+    slotNames_.clear();
+}
+
+void BehaviorTree::evaluate(const BehaviorContext& context, Blackboard& blackboard, Result& result) const {
+    result = Result{};
+    if (!nodes_.empty()) {
+        run(0, context, blackboard, result);
+    }
+}
+
+const std::string& BehaviorTree::reason(int index) const {
+    static const std::string none;
+    if (index < 0 || static_cast<std::size_t>(index) >= reasons_.size()) return none;
+    return reasons_[static_cast<std::size_t>(index)];
+}
+
+int BehaviorTree::blackboardSlot(const std::string& name) const {
+    auto it = std::find(slotNames_.begin(), slotNames_.end(), name);
+    return it != slotNames_.end() ? static_cast<int>(it - slotNames_.begin()) : -1;
+}
+
+float BehaviorTree::operand(std::uint8_t index, const BehaviorContext& context, const Blackboard& blackboard) const {
+    return index < kFactCount ? context.facts[index] : blackboard.slots[index - kFactCount];
+}
+
+float BehaviorTree::score(const Node& node, const BehaviorContext& context, const Blackboard& blackboard) const {
+    float value = operand(node.arg0, context, blackboard);
+    float range = node.value[1] - node.value[0];
+    float t = range != 0.0f ? (value - node.value[0]) / range : (value >= node.value[0] ? 1.0f : 0.0f);
+    t = std::clamp(t, 0.0f, 1.0f);
+    switch (static_cast<Curve>(node.arg1)) {
+        case Curve::Linear: break;
+        case Curve::Inverse: t = 1.0f - t; break;
+        case Curve::Quadratic: t = t * t; break;
+        case Curve::Step: t = value >= node.value[0] ? 1.0f : 0.0f; break;
+    }
+    return t * node.value[2];
+}
+
+bool BehaviorTree::run(std::int32_t index, const BehaviorContext& context, Blackboard& blackboard,
+                       Result& result) const {
+    const Node& node = nodes_[static_cast<std::size_t>(index)];
+    switch (node.type) {
+        case NodeType::Selector:
+            for (std::int32_t child = index + 1; child < node.end; child = nodes_[child].end) {
+                if (run(child, context, blackboard, result)) return true;
+            }
+            return false;
+
+        case NodeType::Sequence:
+            for (std::int32_t child = index + 1; child < node.end; child = nodes_[child].end) {
+                if (!run(child, context, blackboard, result)) return false;
+            }
+            return true;
+
+        case NodeType::Utility: {
+            std::int32_t best = -1;
+            float bestScore = 0.0f;
+            for (std::int32_t child = index + 1; child < node.end; child = nodes_[child].end) {
+                float childScore = score(nodes_[child], context, blackboard);
+                if (childScore > bestScore) {
+                    best = child;
+                    bestScore = childScore;
+                }
+            }
+            return best >= 0 && run(best, context, blackboard, result);
+        }
+
+        case NodeType::Scored:
+            return run(index + 1, context, blackboard, result);
+
+        case NodeType::Condition: {
+            float lhs = operand(node.arg0, context, blackboard);
+            float rhs = (node.flags & kFlagOperand) ? operand(static_cast<std::uint8_t>(node.data), context, blackboard)
+                                                    : node.value[0];
+            switch (static_cast<Compare>(node.arg1)) {
+                case Compare::Less: return lhs < rhs;
+                case Compare::LessEqual: return lhs <= rhs;
+                case Compare::Greater: return lhs > rhs;
+                case Compare::GreaterEqual: return lhs >= rhs;
+                case Compare::Equal: return lhs == rhs;
+                case Compare::NotEqual: return lhs != rhs;
+            }
+            return false;
+        }
+
+        case NodeType::Set: {
+            float& slot = blackboard.slots[node.arg0];
+            slot = (node.flags & kFlagAdd) ? slot + node.value[0] : node.value[0];
+            return true;
+        }
+
+        case NodeType::Action:
+            result.decided = true;
+            result.state = static_cast<AIState>(node.arg0);
+            result.priority = static_cast<Priority>(node.arg1);
+            result.moveTo = static_cast<MoveTo>(node.data);
+            result.targetEntity = (node.flags & kFlagTarget) != 0;
+            result.alert = (node.flags & kFlagAlert) != 0;
+            result.reason = node.reason;
+            return true;
+    }
+    return false;
+}
+
+} // namespace ai
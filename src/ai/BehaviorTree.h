@@ -0,0 +1,124 @@
+#ifndef ABYSSAL_STATION_SRC_AI_BEHAVIORTREE_H
+#define ABYSSAL_STATION_SRC_AI_BEHAVIORTREE_H
+
+#include "AIState.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ai {
+
+// Values a tree can read; filled by the agent once per decision
+enum class BehaviorFact : std::uint8_t {
+    Health,             // 0..1
+    ShouldFlee,         // 1 when health is under the flee threshold
+    HasTarget,
+    TargetDistance,     // Distance to the best perceived target (large when none)
+    TargetPriority,     // Priority value of the best target (0 when none)
+    CanAttack,          // 1 when the best target may be attacked
+    AttackRange,
+    ThreatCount,        // Sight events with a source this tick
+    TimeSinceSeen,
+    InvestigationTime,
+    AlertTimer,
+    HasPatrol,
+    PatrolDistance,     // Distance to the current patrol point (0 when none)
+    State,              // Current AIState as a number
+    TimeInState,
+    Count
+};
+
+struct BehaviorContext {
+    std::array<float, static_cast<std::size_t>(BehaviorFact::Count)> facts{};
+
+    float& operator[](BehaviorFact fact) { return facts[static_cast<std::size_t>(fact)]; }
+    float operator[](BehaviorFact fact) const { return facts[static_cast<std::size_t>(fact)]; }
+};
+
+// Behavior tree / utility selector loaded from JSON and compiled into a flat,
+// pre-order node array. Every node stores the index one past its subtree, so
+// composites walk their children by jumping from end to end; evaluation is a
+// switch over node types with no virtual calls and no allocation. A compiled
+// tree is immutable and shared by any number of agents, each of which keeps
+// its running state in an inline Blackboard.
+//
+// Node syntax:
+//   {"selector": [...]}  first child that succeeds
+//   {"sequence": [...]}  all children in order, stops at the first failure
+//   {"utility": [{"score": {"fact": f, "curve": c, "min": a, "max": b, "weight": w}, "node": {...}}]}
+//                        runs the best scoring child (curve: linear, inverse, quadratic, step)
+//   {"if": f, "op": "<", "value": 3}   compare; value may be a number, fact, state or priority name
+//   {"set": "name", "value": 1, "add": true}   write (or add to) a blackboard slot
+//   {"action": "CHASE", "priority": "HIGH", "moveTo": "target" | "flee", "targetEntity": true,
+//    "alert": true, "reason": "..."}
+// Facts use their names above in camelCase; "bb.name" reads a blackboard slot.
+class BehaviorTree {
+public:
+    static constexpr std::size_t kBlackboardSlots = 8;
+
+    struct Blackboard {
+        std::array<float, kBlackboardSlots> slots{};
+    };
+
+    enum class MoveTo : std::uint8_t { None, Target, Flee };
+
+    struct Result {
+        bool decided = false;
+        AIState state = AIState::IDLE;
+        Priority priority = Priority::LOW;
+        MoveTo moveTo = MoveTo::None;
+        bool targetEntity = false;
+        bool alert = false;
+        int reason = -1;
+    };
+
+    bool loadFromString(const std::string& data);
+    bool loadFromFile(const std::string& path);
+    void clear();
+    bool empty() const { return nodes_.empty(); }
+
+    // Runs the tree once; result.decided is false when no action fired
+    void evaluate(const BehaviorContext& context, Blackboard& blackboard, Result& result) const;
+
+    const std::string& reason(int index) const;
+    // Blackboard slot bound to name, -1 when the tree does not use it
+    int blackboardSlot(const std::string& name) const;
+    std::size_t nodeCount() const { return nodes_.size(); }
+
+private:
+    enum class NodeType : std::uint8_t { Selector, Sequence, Utility, Scored, Condition, Set, Action };
+    enum class Compare : std::uint8_t { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+    enum class Curve : std::uint8_t { Linear, Inverse, Quadratic, Step };
+
+    static constexpr std::uint8_t kFlagOperand = 1;    // Condition: data is the right-hand operand
+    static constexpr std::uint8_t kFlagAdd = 1;        // Set: add instead of assign
+    static constexpr std::uint8_t kFlagTarget = 1;     // Action: targetEntity
+    static constexpr std::uint8_t kFlagAlert = 2;      // Action: alert
+
+    struct Node {
+        NodeType type = NodeType::Selector;
+        std::uint8_t arg0 = 0;      // Operand (Condition/Scored), slot (Set), state (Action)
+        std::uint8_t arg1 = 0;      // Compare, curve, priority
+        std::uint8_t flags = 0;
+        std::int32_t end = 0;       // One past the last node of this subtree
+        std::int32_t data = 0;      // Right-hand operand (Condition), move target (Action)
+        std::int32_t reason = -1;   // Action reason
+        float value[3] = {0.0f, 0.0f, 0.0f};
+    };
+
+    class Compiler;
+    friend class Compiler;
+
+    std::vector<Node> nodes_;
+    std::vector<std::string> reasons_;
+    std::vector<std::string> slotNames_;
+
+    bool run(std::int32_t index, const BehaviorContext& context, Blackboard& blackboard, Result& result) const;
+    float operand(std::uint8_t index, const BehaviorContext& context, const Blackboard& blackboard) const;
+    float score(const Node& node, const BehaviorContext& context, const Blackboard& blackboard) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_BEHAVIORTREE_H
@@ -0,0 +1,202 @@
+#include "CrowdSteering.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ai {
+
+CrowdSteering::CrowdSteering(const CrowdSteeringConfig& config)
+    : config_(config)
+    , origin_(0.f, 0.f)
+    , cellSize_(config.cellSize)
+    , columns_(0)
+    , rows_(0)
+{
+}
+
+void CrowdSteering::clear() {
+    posX_.clear();
+    posY_.clear();
+    velX_.clear();
+    velY_.clear();
+    radius_.clear();
+    maxSpeed_.clear();
+    movable_.clear();
+}
+
+std::size_t CrowdSteering::add(const sf::Vector2f& position, const sf::Vector2f& desiredVelocity,
+                               float radius, float maxSpeed, bool movable) {
+    posX_.push_back(position.x);
+    posY_.push_back(position.y);
+    velX_.push_back(desiredVelocity.x);
+    velY_.push_back(desiredVelocity.y);
+    radius_.push_back(radius);
+    maxSpeed_.push_back(maxSpeed);
+    movable_.push_back(movable ? 1 : 0);
+    return posX_.size() - 1;
+}
+
+void CrowdSteering::solve() {
+    ++stats_.solves;
+    std::size_t count = posX_.size();
+    outX_ = velX_;
+    outY_ = velY_;
+    if (!config_.enabled || count < 2) return;
+
+    buildGrid();
+    const float horizon = std::max(config_.timeHorizon, 0.001f);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!movable_[i]) continue;
+        gatherNeighbors(i);
+
+        float vx = velX_[i];
+        float vy = velY_[i];
+        float pushX = 0.0f;
+        float pushY = 0.0f;
+        for (const auto& [distanceSq, j] : neighbors_) {
+            float px = posX_[j] - posX_[i];
+            float py = posY_[j] - posY_[i];
+            float combined = radius_[i] + radius_[j] + config_.personalSpace;
+            float distance = std::sqrt(distanceSq);
+
+            // Separation: too close already, push straight apart
+            if (distance < combined) {
+                float dx = -1.0f;
+                float dy = 0.0f;
+                if (distance > 0.0001f) {
+                    dx = -px / distance;
+                    dy = -py / distance;
+                } else if (static_cast<std::size_t>(j) < i) {
+                    dx = 1.0f;  // Coincident: the pair splits along x by index
+                }
+                float strength = (1.0f - distance / combined) * config_.separationWeight * maxSpeed_[i];
+                pushX += dx * strength;
+                pushY += dy * strength;
+            }
+
+            // RVO-lite: closest approach of the relative motion within the horizon
+            float rvx = vx - velX_[j];
+            float rvy = vy - velY_[j];
+            float relativeSq = rvx * rvx + rvy * rvy;
+            if (relativeSq < 0.0001f) continue;
+            float t = (px * rvx + py * rvy) / relativeSq;
+            if (t <= 0.0f || t > horizon) continue;
+
+            float cx = rvx * t - px;    // Our offset from the neighbor at closest approach
+            float cy = rvy * t - py;
+            float closest = std::sqrt(cx * cx + cy * cy);
+            if (closest >= combined) continue;
+
+            float sideX;
+            float sideY;
+            if (closest > 0.0001f) {
+                sideX = cx / closest;
+                sideY = cy / closest;
+            } else {
+                // Head-on: perpendicular to the relative velocity, which is mirrored for the neighbor
+                float relative = std::sqrt(relativeSq);
+                sideX = -rvy / relative;
+                sideY = rvx / relative;
+            }
+            // Reciprocal: a moving neighbor takes the other half of the sidestep
+            float share = movable_[j] ? 0.5f : 1.0f;
+            float strength = config_.avoidanceWeight * maxSpeed_[i] * share;
+            pushX += sideX * strength;
+            pushY += sideY * strength;
+        }
+
+        if (pushX == 0.0f && pushY == 0.0f) continue;
+        float ox = vx + pushX;
+        float oy = vy + pushY;
+        float speedSq = ox * ox + oy * oy;
+        float maxSpeed = maxSpeed_[i];
+        if (maxSpeed > 0.0f && speedSq > maxSpeed * maxSpeed) {
+            float scale = maxSpeed / std::sqrt(speedSq);
+            ox *= scale;
+            oy *= scale;
+        }
+        outX_[i] = ox;
+        outY_[i] = oy;
+        ++stats_.adjusted;
+    }
+}
+
+void CrowdSteering::buildGrid() {
+    std::size_t count = posX_.size();
+    float minX = posX_.front();
+    float minY = posY_.front();
+    float maxX = minX;
+    float maxY = minY;
+    for (std::size_t i = 1; i < count; ++i) {
+        minX = std::min(minX, posX_[i]);
+        minY = std::min(minY, posY_[i]);
+        maxX = std::max(maxX, posX_[i]);
+        maxY = std::max(maxY, posY_[i]);
+    }
+
+    // Same bound as the agent grid: widen cells for far-flung crowds
+    constexpr float kMaxCellsPerAxis = 256.f;
+    cellSize_ = std::max(std::max(config_.cellSize, 1.0f), std::max(maxX - minX, maxY - minY) / kMaxCellsPerAxis);
+    origin_ = {minX, minY};
+    columns_ = static_cast<int>((maxX - minX) / cellSize_) + 1;
+    rows_ = static_cast<int>((maxY - minY) / cellSize_) + 1;
+
+    std::size_t cellCount = static_cast<std::size_t>(columns_) * rows_;
+    cellStart_.assign(cellCount + 1, 0);
+    agentCell_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int cx = std::min(static_cast<int>((posX_[i] - minX) / cellSize_), columns_ - 1);
+        int cy = std::min(static_cast<int>((posY_[i] - minY) / cellSize_), rows_ - 1);
+        agentCell_[i] = cy * columns_ + cx;
+        ++cellStart_[agentCell_[i] + 1];
+    }
+    for (std::size_t c = 0; c < cellCount; ++c) {
+        cellStart_[c + 1] += cellStart_[c];
+    }
+    cellAgents_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        cellAgents_[cellStart_[agentCell_[i]]++] = static_cast<int>(i);
+    }
+    for (std::size_t c = cellCount; c > 0; --c) {
+        cellStart_[c] = cellStart_[c - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+void CrowdSteering::gatherNeighbors(std::size_t agent) {
+    neighbors_.clear();
+    float x = posX_[agent];
+    float y = posY_[agent];
+    float radius = config_.neighborRadius;
+    float radiusSq = radius * radius;
+
+    int minCx = std::max(0, static_cast<int>(std::floor((x - radius - origin_.x) / cellSize_)));
+    int minCy = std::max(0, static_cast<int>(std::floor((y - radius - origin_.y) / cellSize_)));
+    int maxCx = std::min(columns_ - 1, static_cast<int>(std::floor((x + radius - origin_.x) / cellSize_)));
+    int maxCy = std::min(rows_ - 1, static_cast<int>(std::floor((y + radius - origin_.y) / cellSize_)));
+
+    for (int cy = minCy; cy <= maxCy; ++cy) {
+        for (int cx = minCx; cx <= maxCx; ++cx) {
+            int cell = cy * columns_ + cx;
+            for (int slot = cellStart_[cell]; slot < cellStart_[cell + 1]; ++slot) {
+                int other = cellAgents_[slot];
+                if (static_cast<std::size_t>(other) == agent) continue;
+                ++stats_.neighborsTested;
+                float dx = posX_[other] - x;
+                float dy = posY_[other] - y;
+                float distanceSq = dx * dx + dy * dy;
+                if (distanceSq <= radiusSq) {
+                    neighbors_.emplace_back(distanceSq, other);
+                }
+            }
+        }
+    }
+
+    std::size_t limit = static_cast<std::size_t>(std::max(config_.maxNeighbors, 0));
+    if (neighbors_.size() > limit) {
+        std::nth_element(neighbors_.begin(), neighbors_.begin() + static_cast<std::ptrdiff_t>(limit), neighbors_.end());
+        neighbors_.resize(limit);
+    }
+}
+
+} // namespace ai
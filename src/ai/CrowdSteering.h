@@ -0,0 +1,87 @@
+#ifndef ABYSSAL_STATION_SRC_AI_CROWDSTEERING_H
+#define ABYSSAL_STATION_SRC_AI_CROWDSTEERING_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace ai {
+
+// Configuration for local avoidance between moving agents
+struct CrowdSteeringConfig {
+    bool enabled = true;
+    float cellSize = 160.0f;            // Neighbor grid cell, about the neighbor radius
+    float neighborRadius = 160.0f;      // Agents further apart never influence each other (>= 2 * speed * timeHorizon)
+    int maxNeighbors = 10;              // Closest neighbors considered per agent
+    float personalSpace = 6.0f;         // Gap kept on top of both radii
+    float separationWeight = 1.0f;      // Push (in max speeds) when fully overlapping
+    float timeHorizon = 0.75f;          // Seconds ahead checked for collisions
+    float avoidanceWeight = 1.0f;       // Sidestep (in max speeds) for an imminent collision, split between movers
+};
+
+// Local avoidance layer: agents submit their desired velocity, solve() returns
+// adjusted ones. Neighbors come from a uniform grid rebuilt by counting sort,
+// so each agent only tests the cells around it. The adjustment combines
+// separation (push apart when closer than both radii plus personalSpace) with
+// an RVO-lite sidestep: when the relative motion brings two agents within
+// their combined radius inside timeHorizon, each takes half the avoidance
+// sideways, away from the closest-approach point. All agents read the same
+// input snapshot, so the result does not depend on submission order beyond
+// ties. Static agents take part as obstacles but keep their velocity.
+class CrowdSteering {
+public:
+    explicit CrowdSteering(const CrowdSteeringConfig& config = CrowdSteeringConfig{});
+
+    void clear();
+    // Returns the agent's index; positions are centers, velocities per second
+    std::size_t add(const sf::Vector2f& position, const sf::Vector2f& desiredVelocity,
+                    float radius, float maxSpeed, bool movable = true);
+    void solve();
+    sf::Vector2f velocity(std::size_t index) const { return {outX_[index], outY_[index]}; }
+    std::size_t size() const { return posX_.size(); }
+
+    void setConfig(const CrowdSteeringConfig& config) { config_ = config; }
+    const CrowdSteeringConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int solves = 0;
+        int neighborsTested = 0;    // Pairs distance-tested through the grid
+        int adjusted = 0;           // Agents whose velocity changed
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    CrowdSteeringConfig config_;
+
+    // Agent input/output, SoA
+    std::vector<float> posX_;
+    std::vector<float> posY_;
+    std::vector<float> velX_;
+    std::vector<float> velY_;
+    std::vector<float> radius_;
+    std::vector<float> maxSpeed_;
+    std::vector<unsigned char> movable_;
+    std::vector<float> outX_;
+    std::vector<float> outY_;
+
+    // Neighbor grid: cellStart_[c]..cellStart_[c + 1] indexes cellAgents_
+    sf::Vector2f origin_;
+    float cellSize_;
+    int columns_;
+    int rows_;
+    std::vector<int> cellStart_;
+    std::vector<int> agentCell_;
+    std::vector<int> cellAgents_;
+
+    // Per-agent scratch: closest neighbors (squared distance, index)
+    std::vector<std::pair<float, int>> neighbors_;
+    Stats stats_;
+
+    void buildGrid();
+    void gatherNeighbors(std::size_t agent);
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_CROWDSTEERING_H
@@ -0,0 +1,80 @@
+#include "DeterministicStep.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ai {
+
+FixedStepClock::FixedStepClock(const DeterministicConfig& config)
+    : step_(1.0f / 60.0f)
+    , maxSteps_(1)
+    , accumulator_(0.0)
+    , steps_(0)
+    , dropped_(0.0)
+{
+    setConfig(config);
+}
+
+void FixedStepClock::setConfig(const DeterministicConfig& config) {
+    step_ = config.fixedTimeStep > 0.0f ? config.fixedTimeStep : 1.0f / 60.0f;
+    maxSteps_ = std::max(config.maxStepsPerUpdate, 1);
+}
+
+int FixedStepClock::advance(float deltaTime) {
+    accumulator_ += std::max(deltaTime, 0.0f);
+    // A frame of exactly one tick must not come out short by rounding
+    const double step = step_;
+    const double epsilon = step * 1e-4;
+    int ticks = 0;
+    while (accumulator_ + epsilon >= step && ticks < maxSteps_) {
+        accumulator_ = std::max(accumulator_ - step, 0.0);
+        ++ticks;
+    }
+    if (accumulator_ + epsilon >= step) {
+        // Over the catch-up cap: keep only the sub-tick remainder
+        double kept = std::fmod(accumulator_, step);
+        dropped_ += accumulator_ - kept;
+        accumulator_ = kept;
+    }
+    steps_ += static_cast<std::uint64_t>(ticks);
+    return ticks;
+}
+
+void FixedStepClock::reset() {
+    accumulator_ = 0.0;
+    steps_ = 0;
+    dropped_ = 0.0;
+}
+
+void StateHash::add(std::uint64_t value) {
+    for (int byte = 0; byte < 8; ++byte) {
+        hash_ ^= (value >> (byte * 8)) & 0xffu;
+        hash_ *= 0x100000001b3ull;
+    }
+}
+
+void StateHash::add(float value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+}
+
+std::int64_t firstDivergentStep(const std::vector<StepHash>& a, const std::vector<StepHash>& b) {
+    // Both logs are in ascending step order but may start at different steps
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i].step < b[j].step) {
+            ++i;
+        } else if (b[j].step < a[i].step) {
+            ++j;
+        } else {
+            if (a[i].hash != b[j].hash) return static_cast<std::int64_t>(a[i].step);
+            ++i;
+            ++j;
+        }
+    }
+    return -1;
+}
+
+} // namespace ai
@@ -0,0 +1,75 @@
+#ifndef ABYSSAL_STATION_SRC_AI_DETERMINISTICSTEP_H
+#define ABYSSAL_STATION_SRC_AI_DETERMINISTICSTEP_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ai {
+
+// Configuration for the deterministic fixed-step simulation mode
+struct DeterministicConfig {
+    bool enabled = false;
+    float fixedTimeStep = 1.0f / 60.0f;     // AI tick length; frame time is accumulated into ticks
+    int maxStepsPerUpdate = 4;              // Catch-up cap per updateAll; time beyond it is dropped
+    std::uint32_t seed = 0x5EEDu;           // Mixed with entity ids into per-agent RNG seeds
+    int pathExpansionsPerStep = 4096;       // Replaces the path queue's wall-clock budget
+    std::size_t hashHistory = 3600;         // Per-step state hashes kept (0 = only the latest)
+};
+
+// Turns variable frame times into a whole number of fixed ticks. Leftover
+// time carries over to the next frame; a frame that would need more than
+// maxStepsPerUpdate ticks runs only that many and drops the rest, so a
+// hitch cannot snowball into ever longer catch-up frames.
+class FixedStepClock {
+public:
+    explicit FixedStepClock(const DeterministicConfig& config = DeterministicConfig{});
+
+    // Ticks to run for a frame of deltaTime seconds
+    int advance(float deltaTime);
+    void reset();
+
+    float step() const { return step_; }
+    std::uint64_t steps() const { return steps_; }
+    double droppedTime() const { return dropped_; }     // Seconds discarded by the catch-up cap
+    void setConfig(const DeterministicConfig& config);
+
+private:
+    float step_;
+    int maxSteps_;
+    double accumulator_;
+    std::uint64_t steps_;
+    double dropped_;
+};
+
+// 64-bit FNV-1a over the values fed to it. Floats are hashed by their bit
+// pattern, so any change in the arithmetic that produced them changes the hash.
+class StateHash {
+public:
+    static constexpr std::uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+
+    void add(std::uint64_t value);
+    void add(std::uint32_t value) { add(static_cast<std::uint64_t>(value)); }
+    void add(int value) { add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value))); }
+    void add(float value);
+    void add(const sf::Vector2f& value) { add(value.x); add(value.y); }
+
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = kOffsetBasis;
+};
+
+// State hash after one fixed tick
+struct StepHash {
+    std::uint64_t step = 0;
+    std::uint64_t hash = 0;
+};
+
+// First step at which two hash logs disagree, matching entries by step
+// number; -1 when the steps both logs cover agree
+std::int64_t firstDivergentStep(const std::vector<StepHash>& a, const std::vector<StepHash>& b);
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_DETERMINISTICSTEP_H
@@ -1,4 +1,5 @@
 #include "ai/Enemy.h"
+#include "ai/VisibilityTable.h"
 #include "core/Logger.h"
 #include "entities/Player.h"
 #include "../collisions/CollisionManager.h"
@@ -92,29 +93,30 @@ const char* Enemy::legacyStateToString(AIState s) {
 void Enemy::changeState(AIState newState) {
     if (useEnhancedAI_ && aiAgent_) {
         aiAgent_->changeState(newState);
-    } else {
-        if (newState == legacyState_) return;
-        
-        // Only log transitions if cooldown expired
-        if (logTimer_ <= 0.f) {
-            std::ostringstream ss;
-            ss << "[AI] Enemy " << id_ << " -> " << legacyStateToString(newState);
-            Logger::instance().info(ss.str());
-            logTimer_ = logCooldown_;
-        }
-        
-        // If entering patrol or return, pick the nearest patrol point as the target
-        if ((newState == AIState::PATROL || newState == AIState::RETURN) && !patrolPoints_.empty()) {
-            currentPatrolIndex_ = findNearestPatrolIndex();
-        }
-        legacyState_ = newState;
     }
+    transition(newState);
 }
 
-AIState Enemy::getCurrentState() const {
-    if (useEnhancedAI_ && aiAgent_) {
-        return aiAgent_->getCurrentState();
+// FSM transitions only touch the FSM state, which is the one the FSM reads back
+void Enemy::transition(AIState newState) {
+    if (newState == legacyState_) return;
+    
+    // Only log transitions if cooldown expired
+    if (logTimer_ <= 0.f) {
+        std::ostringstream ss;
+        ss << "[AI] Enemy " << id_ << " -> " << legacyStateToString(newState);
+        Logger::instance().info(ss.str());
+        logTimer_ = logCooldown_;
     }
+    
+    // If entering patrol or return, pick the nearest patrol point as the target
+    if ((newState == AIState::PATROL || newState == AIState::RETURN) && !patrolPoints_.empty()) {
+        currentPatrolIndex_ = findNearestPatrolIndex();
+    }
+    legacyState_ = newState;
+}
+
+AIState Enemy::getCurrentState() const {
     return legacyState_;
 }
 
@@ -127,6 +129,9 @@ bool Enemy::detectPlayer(const sf::Vector2f& playerPos) const {
     if (collisionManager_) {
         sf::Vector2f a = position_ + (size_ * 0.5f);
         sf::Vector2f b = playerPos + (size_ * 0.5f);
+        if (visibilityTable_) {
+            return visibilityTable_->hasLineOfSight(a, b, collisionManager_, const_cast<ai::Enemy*>(this), entities::kLayerMaskWall);
+        }
         if (collisionManager_->segmentIntersectsAny(a, b, const_cast<ai::Enemy*>(this), entities::kLayerMaskWall)) return false;
     }
     return true;
@@ -234,29 +239,40 @@ void Enemy::commitMove(const sf::Vector2f& newPosition) {
 }
 
 void Enemy::update(float deltaTime) {
-    if (useEnhancedAI_ && aiAgent_) {
-        // Use enhanced AI system
-        // Note: This requires EntityManager and CollisionManager to be passed
-        // For now, fall back to legacy system
-        runLegacyFSM(deltaTime, nullptr);
-    } else {
-        // Use legacy FSM
-        runLegacyFSM(deltaTime, nullptr);
-    }
+    // EntityManager ticks every entity; managed enemies already ran this frame
+    if (pipelineManaged_) return;
+    runLegacyFSM(deltaTime, nullptr);
 }
 
 void Enemy::update(float deltaTime, const sf::Vector2f& playerPos) {
-    if (useEnhancedAI_ && aiAgent_) {
-        // Enhanced AI would be updated by AIManager, not here
-        // For backward compatibility, still run legacy FSM
-        runLegacyFSM(deltaTime, &playerPos);
-    } else {
-        runLegacyFSM(deltaTime, &playerPos);
-    }
+    runLegacyFSM(deltaTime, &playerPos);
 }
 
 // Legacy FSM for backward compatibility
 void Enemy::runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos) {
+    sense(playerPos);
+    think(deltaTime, playerPos);
+}
+
+void Enemy::hashState(StateHash& hash) const {
+    hash.add(id());
+    hash.add(position());
+    hash.add(static_cast<int>(legacyState_));
+    hash.add(static_cast<std::uint64_t>(currentPatrolIndex_));
+    hash.add(intendedPosition_);
+    hash.add(facingDir_);
+    hash.add(attackTimer_);
+    hash.add(playerVisible_ ? 1u : 0u);
+    if (aiAgent_) {
+        aiAgent_->hashState(hash);
+    }
+}
+
+void Enemy::sense(const sf::Vector2f* playerPos) {
+    playerVisible_ = playerPos ? detectPlayer(*playerPos) : detectPlayer();
+}
+
+void Enemy::think(float deltaTime, const sf::Vector2f* playerPos) {
     // Update log timer
     if (logTimer_ > 0.f) logTimer_ -= deltaTime;
     // Update attack timer
@@ -268,26 +284,26 @@ void Enemy::runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos) {
         {
             // If has patrol points, start patrolling
             if (!patrolPoints_.empty()) {
-                changeState(AIState::PATROL);
+                transition(AIState::PATROL);
                 break;
             }
             // otherwise remain idle but check for player
-            if (playerPos ? detectPlayer(*playerPos) : detectPlayer()) {
+            if (playerVisible_) {
                 Logger::instance().info("[AI] Enemy " + std::to_string(id_) + " detectó al jugador -> CHASE");
-                changeState(AIState::CHASE);
+                transition(AIState::CHASE);
             }
         }
         break;
 
         case AIState::PATROL:
         {
-            if (playerPos ? detectPlayer(*playerPos) : detectPlayer()) {
+            if (playerVisible_) {
                 Logger::instance().info("[AI] Enemy " + std::to_string(id_) + " detectó al jugador -> CHASE");
-                changeState(AIState::CHASE);
+                transition(AIState::CHASE);
                 break;
             }
             if (patrolPoints_.empty()) {
-                changeState(AIState::IDLE);
+                transition(AIState::IDLE);
                 break;
             }
             const sf::Vector2f& dest = patrolPoints_[currentPatrolIndex_];
@@ -302,14 +318,14 @@ void Enemy::runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos) {
         case AIState::CHASE:
         {
             if (!targetPlayer_) {
-                changeState(AIState::RETURN);
+                transition(AIState::RETURN);
                 break;
             }
             // Determine the player position to use for chasing/detection
             sf::Vector2f ppos = playerPos ? *playerPos : (targetPlayer_ ? targetPlayer_->position() : position_);
-            if (! (playerPos ? detectPlayer(ppos) : detectPlayer()) ) {
+            if (!playerVisible_) {
                 Logger::instance().info("[AI] Enemy " + std::to_string(id_) + " retornando a patrulla..");
-                changeState(AIState::RETURN);
+                transition(AIState::RETURN);
                 break;
             }
             // move to player
@@ -322,7 +338,7 @@ void Enemy::runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos) {
                 std::ostringstream ss;
                 ss << "[AI] Enemy " << id_ << " alcanzó al jugador -> ATTACK";
                 Logger::instance().info(ss.str());
-                changeState(AIState::ATTACK);
+                transition(AIState::ATTACK);
             }
         }
         break;
@@ -337,25 +353,25 @@ void Enemy::runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos) {
                     attackTimer_ = attackCooldown_;
                 }
             }
-            if (playerPos ? !detectPlayer(*playerPos) : !detectPlayer()) {
+            if (!playerVisible_) {
                 Logger::instance().info("[AI] Enemy " + std::to_string(id_) + " retornando a patrulla..");
-                changeState(AIState::RETURN);
+                transition(AIState::RETURN);
             } else {
                 // for now just go back to CHASE to continue closing distance
-                changeState(AIState::CHASE);
+                transition(AIState::CHASE);
             }
         }
         break;
 
         case AIState::RETURN:
         {
-            if (playerPos ? detectPlayer(*playerPos) : detectPlayer()) {
+            if (playerVisible_) {
                 Logger::instance().info("[AI] Enemy " + std::to_string(id_) + " detectó al jugador -> CHASE");
-                changeState(AIState::CHASE);
+                transition(AIState::CHASE);
                 break;
             }
             if (patrolPoints_.empty()) {
-                changeState(AIState::IDLE);
+                transition(AIState::IDLE);
                 break;
             }
             // Move back to the nearest patrol point
@@ -363,7 +379,7 @@ void Enemy::runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos) {
             moveTowards(dest, deltaTime);
             sf::Vector2f toDest = dest - position_;
             if ((toDest.x*toDest.x + toDest.y*toDest.y) < 4.0f) {
-                changeState(AIState::PATROL);
+                transition(AIState::PATROL);
             }
         }
         break;
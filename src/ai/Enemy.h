@@ -16,6 +16,8 @@ namespace collisions { class CollisionManager; }
 
 namespace ai {
 
+class VisibilityTable;
+
 class Enemy : public entities::Entity {
 public:
     using Id = entities::Entity::Id;
@@ -44,11 +46,30 @@ public:
     void changeState(AIState newState);
     AIState getCurrentState() const;
 
+    // Baked static visibility used by detectPlayer before raycasting (not owned)
+    void setVisibilityTable(const VisibilityTable* table) { visibilityTable_ = table; }
+
     // Player target for detection/chase (optional)
     void setTargetPlayer(entities::Player* player) { targetPlayer_ = player; }
+    entities::Player* getTargetPlayer() const { return targetPlayer_; }
+
+    // Pipeline stages, driven once per frame by EnemyManager::update.
+    // sense() only reads the world and writes this enemy's sight result, so
+    // it may run on worker threads; think() runs the FSM on that result and
+    // records the intended move or attack.
+    void sense(const sf::Vector2f* playerPos);
+    void think(float deltaTime, const sf::Vector2f* playerPos);
+    bool seesPlayer() const { return playerVisible_; }
+    // Managed enemies skip their own update() tick so the FSM runs once per frame
+    void setPipelineManaged(bool managed) { pipelineManaged_ = managed; }
+    bool isPipelineManaged() const { return pipelineManaged_; }
+    // Feeds the simulation state (position, FSM state, timers) to a determinism hash
+    void hashState(StateHash& hash) const;
+    void setCollisionManager(collisions::CollisionManager* cm) { collisionManager_ = cm; }
 
     // Configurable parameters
     void setSpeed(float s) { speed_ = s; }
+    float getSpeed() const { return speed_; }
     void setVisionRange(float r) { visionRange_ = r; }
     void setAttackRange(float r) { attackRange_ = r; }
     void setBehaviorProfile(BehaviorProfile profile);
@@ -71,6 +92,7 @@ public:
     // Intended movement API (for collision handling)
     sf::Vector2f computeIntendedMove(float deltaTime) const;
     void commitMove(const sf::Vector2f& newPosition);
+    void setIntendedMove(const sf::Vector2f& position) { intendedPosition_ = position; }
     void performMovementPlanning(float deltaTime, collisions::CollisionManager* collisionManager);
 
     // Attack functionality
@@ -84,6 +106,7 @@ public:
 private:
     // Legacy FSM for backward compatibility
     void runLegacyFSM(float deltaTime, const sf::Vector2f* playerPos);
+    void transition(AIState newState);
     std::size_t findNearestPatrolIndex() const;
     static const char* legacyStateToString(AIState s);
 
@@ -104,6 +127,7 @@ private:
     entities::Player* targetPlayer_{nullptr};
     // CollisionManager pointer (not owned) used for LOS checks and movement planning
     collisions::CollisionManager* collisionManager_{nullptr};
+    const VisibilityTable* visibilityTable_{nullptr};
 
     // Simple debug shape (not required for logic)
     sf::RectangleShape shape_;
@@ -123,6 +147,9 @@ private:
     
     // Mode selection
     bool useEnhancedAI_{false};
+    bool pipelineManaged_{false};
+    // Sense stage result for this frame
+    bool playerVisible_{false};
 };
 
 } // namespace ai
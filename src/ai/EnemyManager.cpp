@@ -3,12 +3,146 @@
 #include "../collisions/CollisionSystem.h"
 #include <SFML/Graphics/Rect.hpp>
 #include "../core/Logger.h"
+#include "../core/ThreadPool.h"
+#include "../entities/Player.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
 
 namespace ai {
 
-void EnemyManager::updateAll(float dt, const sf::Vector2f& playerPos) {
-    for (auto& e : enemies_) {
-        if (e) e->update(dt, playerPos);
+namespace {
+
+sf::FloatRect unionBounds(const sf::FloatRect& a, const sf::FloatRect& b) {
+    float left = std::min(a.position.x, b.position.x);
+    float top = std::min(a.position.y, b.position.y);
+    float right = std::max(a.position.x + a.size.x, b.position.x + b.size.x);
+    float bottom = std::max(a.position.y + a.size.y, b.position.y + b.size.y);
+    return sf::FloatRect({left, top}, {right - left, bottom - top});
+}
+
+sf::FloatRect sweptBounds(const sf::FloatRect& from, const sf::Vector2f& target) {
+    return unionBounds(from, sf::FloatRect(target, from.size));
+}
+
+// First time in [0, 1) at which box a, moving by relative, overlaps box b.
+// Returns 1 when they never touch, or when they already overlap and separate.
+float timeOfImpact(const sf::FloatRect& a, const sf::FloatRect& b, const sf::Vector2f& relative) {
+    float entry = -std::numeric_limits<float>::infinity();
+    float exit = std::numeric_limits<float>::infinity();
+    const float aMin[2] = {a.position.x, a.position.y};
+    const float aMax[2] = {a.position.x + a.size.x, a.position.y + a.size.y};
+    const float bMin[2] = {b.position.x, b.position.y};
+    const float bMax[2] = {b.position.x + b.size.x, b.position.y + b.size.y};
+    const float d[2] = {relative.x, relative.y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (d[axis] == 0.0f) {
+            if (aMin[axis] >= bMax[axis] || bMin[axis] >= aMax[axis]) return 1.0f;
+            continue;
+        }
+        float t1 = (bMin[axis] - aMax[axis]) / d[axis];
+        float t2 = (bMax[axis] - aMin[axis]) / d[axis];
+        entry = std::max(entry, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+    }
+    if (entry >= exit || entry >= 1.0f || exit <= 0.0f) return 1.0f;
+    if (entry < 0.0f) {
+        // Already overlapping: only moves that bring the centers closer conflict
+        sf::Vector2f centers = (b.position + b.size * 0.5f) - (a.position + a.size * 0.5f);
+        return centers.x * relative.x + centers.y * relative.y > 0.0f ? 0.0f : 1.0f;
+    }
+    return entry;
+}
+
+} // namespace
+
+void EnemyManager::addEnemyPointer(Enemy* e) {
+    if (!e || std::find(enemies_.begin(), enemies_.end(), e) != enemies_.end()) return;
+    if (visibilityTable_) e->setVisibilityTable(visibilityTable_);
+    if (player_) e->setTargetPlayer(player_);
+    e->setPipelineManaged(true);
+    enemies_.push_back(e);
+}
+
+void EnemyManager::removeEnemyPointer(Enemy* e) {
+    auto it = std::find(enemies_.begin(), enemies_.end(), e);
+    if (it == enemies_.end()) return;
+    e->setPipelineManaged(false);
+    enemies_.erase(it);
+}
+
+void EnemyManager::clear() {
+    for (auto* e : enemies_) {
+        if (e) e->setPipelineManaged(false);
+    }
+    enemies_.clear();
+}
+
+void EnemyManager::setPlayer(entities::Player* player) {
+    if (player == player_) return;
+    player_ = player;
+    for (auto* e : enemies_) {
+        if (e) e->setTargetPlayer(player);
+    }
+}
+
+void EnemyManager::update(float dt, collisions::CollisionManager* cm) {
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsed = [](Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count() / 1000.0f;
+    };
+
+    auto start = Clock::now();
+    senseAll(cm);
+    auto sensed = Clock::now();
+    thinkAll(dt);
+    auto thought = Clock::now();
+    planAllMovement(dt, cm);
+    auto planned = Clock::now();
+    steerAllMoves(dt);
+    commitAllMoves(cm);
+    auto committed = Clock::now();
+
+    ++pipelineStats_.frames;
+    pipelineStats_.enemies = static_cast<int>(enemies_.size());
+    pipelineStats_.senseTime = elapsed(start, sensed);
+    pipelineStats_.thinkTime = elapsed(sensed, thought);
+    pipelineStats_.planTime = elapsed(thought, planned);
+    pipelineStats_.commitTime = elapsed(planned, committed);
+    pipelineStats_.totalTime = elapsed(start, committed);
+}
+
+void EnemyManager::senseAll(collisions::CollisionManager* cm) {
+    // Sight checks only read the world and write each enemy's own result
+    for (auto* e : enemies_) {
+        if (e) e->setCollisionManager(cm);
+    }
+    if (player_) playerPosition_ = player_->position();
+    const sf::Vector2f* playerPos = player_ ? &playerPosition_ : nullptr;
+    auto senseRange = [this, playerPos](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Enemy* e = enemies_[i];
+            if (e && e->isActive()) e->sense(playerPos);
+        }
+    };
+    if (threadPool_) {
+        threadPool_->parallelFor(enemies_.size(), senseRange);
+    } else {
+        senseRange(0, enemies_.size());
+    }
+
+    pipelineStats_.sawPlayer = 0;
+    for (auto* e : enemies_) {
+        if (e && e->isActive() && e->seesPlayer()) ++pipelineStats_.sawPlayer;
+    }
+}
+
+void EnemyManager::thinkAll(float dt) {
+    // FSM transitions log and attacks damage the player: serial, in enemy order
+    const sf::Vector2f* playerPos = player_ ? &playerPosition_ : nullptr;
+    for (auto* e : enemies_) {
+        if (e && e->isActive()) e->think(dt, playerPos);
     }
 }
 
@@ -24,20 +158,173 @@ void EnemyManager::planAllMovement(float dt, collisions::CollisionManager* cm) {
     }
 }
 
-void EnemyManager::commitAllMoves(collisions::CollisionManager* cm) {
-    for (auto& e : enemies_) {
+void EnemyManager::steerAllMoves(float dt) {
+    if (dt <= 0.f || !crowd_.getConfig().enabled) return;
+
+    // Every enemy is a neighbor; only those with a planned move get steered
+    crowd_.clear();
+    steered_.clear();
+    for (auto* e : enemies_) {
         if (!e) continue;
+        sf::Vector2f position = e->position();
         sf::Vector2f intended = e->computeIntendedMove(0.f);
-        sf::FloatRect testBounds;
-        testBounds.position.x = intended.x; testBounds.position.y = intended.y;
-        testBounds.size.x = e->size().x; testBounds.size.y = e->size().y;
-    auto blocker = cm ? cm->firstColliderForBounds(testBounds, e, entities::kLayerMaskAll & ~entities::kLayerMaskItem) : nullptr;
-        if (!blocker) {
-            e->commitMove(intended);
-        } else {
-            core::Logger::instance().info("[EnemyManager] Enemy movement blocked id=" + std::to_string(e->id()) +
-                " by entity id=" + std::to_string(blocker->id()));
+        sf::Vector2f half = e->size() * 0.5f;
+        crowd_.add(position + half, (intended - position) / dt, std::max(half.x, half.y),
+                   e->getSpeed(), intended != position);
+        steered_.push_back(e);
+    }
+    crowd_.solve();
+
+    for (std::size_t i = 0; i < steered_.size(); ++i) {
+        Enemy* e = steered_[i];
+        if (e->computeIntendedMove(0.f) == e->position()) continue;
+        e->setIntendedMove(e->position() + crowd_.velocity(i) * dt);
+    }
+}
+
+void EnemyManager::commitAllMoves(collisions::CollisionManager* cm) {
+    commitStats_ = CommitStats{};
+    moves_.clear();
+    for (auto* e : enemies_) {
+        if (e) moves_.push_back({e, e->getBounds(), e->computeIntendedMove(0.f), 1.f});
+    }
+    if (moves_.empty()) return;
+
+    // World blockers (everything but items and enemies) for all swept boxes at once
+    world_.clear();
+    bool anyMove = false;
+    sf::FloatRect region;
+    for (const auto& move : moves_) {
+        if (move.target == move.from.position) continue;
+        sf::FloatRect swept = sweptBounds(move.from, move.target);
+        region = anyMove ? unionBounds(region, swept) : swept;
+        anyMove = true;
+    }
+    if (!anyMove) return;
+    if (cm) {
+        cm->queryBounds(region, world_, entities::kLayerMaskAll & ~entities::kLayerMaskItem & ~entities::kLayerMaskEnemy);
+    }
+    pairSweptBoxes();
+
+    // Against the world each enemy takes its full move, else an axis slide, else stays
+    std::size_t pair = 0;
+    for (std::size_t i = 0; i < moves_.size(); ++i) {
+        PendingMove& move = moves_[i];
+        std::size_t first = pair;
+        while (pair < worldPairs_.size() && worldPairs_[pair].first == static_cast<int>(i)) ++pair;
+        if (move.target == move.from.position || first == pair) continue;
+
+        sf::Vector2f start = move.from.position;
+        const sf::Vector2f options[] = {move.target, {move.target.x, start.y}, {start.x, move.target.y}};
+        const collisions::CollisionBox* blocker = nullptr;
+        bool placed = false;
+        for (int option = 0; option < 3 && !placed; ++option) {
+            if (option > 0 && options[option] == start) continue;
+            sf::FloatRect bounds(options[option], move.from.size);
+            blocker = nullptr;
+            for (std::size_t k = first; k < pair && !blocker; ++k) {
+                const collisions::CollisionBox* box = world_[static_cast<std::size_t>(worldPairs_[k].second)];
+                if (bounds.findIntersection(box->getBounds())) blocker = box;
+            }
+            if (!blocker) {
+                move.target = options[option];
+                placed = true;
+                if (option > 0) ++commitStats_.slid;
+            }
+        }
+        if (!placed) {
+            move.target = start;
+            ++commitStats_.blocked;
+            core::Logger::instance().info("[EnemyManager] Enemy movement blocked id=" + std::to_string(move.enemy->id()) +
+                " by entity id=" + std::to_string(blocker->owner() ? blocker->owner()->id() : 0));
+        }
+    }
+
+    resolveAgentConflicts();
+
+    // Apply every move, then refresh all enemy colliders with one partition rebuild
+    colliderUpdates_.clear();
+    for (const auto& move : moves_) {
+        sf::Vector2f start = move.from.position;
+        sf::Vector2f position = start + (move.target - start) * move.fraction;
+        if (position != start) ++commitStats_.moved;
+        move.enemy->commitMove(position);
+        colliderUpdates_.emplace_back(move.enemy, sf::FloatRect(position, move.from.size));
+    }
+    if (cm) cm->updateColliderBoundsBatch(colliderUpdates_);
+}
+
+void EnemyManager::pairSweptBoxes() {
+    // One sort-and-sweep along x over enemy swept boxes and world boxes
+    sweep_.clear();
+    for (std::size_t i = 0; i < moves_.size(); ++i) {
+        sf::FloatRect swept = sweptBounds(moves_[i].from, moves_[i].target);
+        sweep_.push_back({swept.position.x, swept.position.x + swept.size.x,
+                          swept.position.y, swept.position.y + swept.size.y, static_cast<int>(i)});
+    }
+    int worldBase = static_cast<int>(moves_.size());
+    for (std::size_t k = 0; k < world_.size(); ++k) {
+        const sf::FloatRect& b = world_[k]->getBounds();
+        sweep_.push_back({b.position.x, b.position.x + b.size.x, b.position.y, b.position.y + b.size.y,
+                          worldBase + static_cast<int>(k)});
+    }
+    std::sort(sweep_.begin(), sweep_.end(), [](const SweepEntry& a, const SweepEntry& b) {
+        return a.minX != b.minX ? a.minX < b.minX : a.index < b.index;
+    });
+
+    worldPairs_.clear();
+    agentPairs_.clear();
+    active_.clear();
+    for (std::size_t e = 0; e < sweep_.size(); ++e) {
+        const SweepEntry& entry = sweep_[e];
+        active_.erase(std::remove_if(active_.begin(), active_.end(), [this, &entry](int other) {
+            return sweep_[static_cast<std::size_t>(other)].maxX <= entry.minX;
+        }), active_.end());
+        for (int other : active_) {
+            const SweepEntry& o = sweep_[static_cast<std::size_t>(other)];
+            if (entry.minY >= o.maxY || o.minY >= entry.maxY) continue;
+            int a = std::min(entry.index, o.index);
+            int b = std::max(entry.index, o.index);
+            if (a >= worldBase) continue;   // World vs world
+            if (b >= worldBase) worldPairs_.emplace_back(a, b - worldBase);
+            else agentPairs_.emplace_back(a, b);
+        }
+        active_.push_back(static_cast<int>(e));
+    }
+    std::sort(worldPairs_.begin(), worldPairs_.end());
+    std::sort(agentPairs_.begin(), agentPairs_.end());
+}
+
+void EnemyManager::resolveAgentConflicts() {
+    // Every pass reads the same fractions and only lowers them, so the
+    // outcome is symmetric and independent of enemy order
+    constexpr int kMaxPasses = 8;
+    constexpr float kSkin = 0.01f;
+    clipped_.resize(moves_.size());
+    auto delta = [this](std::size_t i) {
+        return (moves_[i].target - moves_[i].from.position) * moves_[i].fraction;
+    };
+
+    for (int pass = 0; pass <= kMaxPasses; ++pass) {
+        for (std::size_t i = 0; i < moves_.size(); ++i) clipped_[i] = moves_[i].fraction;
+        bool conflict = false;
+        for (const auto& [a, b] : agentPairs_) {
+            std::size_t i = static_cast<std::size_t>(a);
+            std::size_t j = static_cast<std::size_t>(b);
+            sf::Vector2f relative = delta(i) - delta(j);
+            float impact = timeOfImpact(moves_[i].from, moves_[j].from, relative);
+            if (impact >= 1.0f) continue;
+            conflict = true;
+            if (pass == 0) ++commitStats_.agentConflicts;
+
+            // Both stop just short of contact; after the last pass they stay put
+            float length = std::sqrt(relative.x * relative.x + relative.y * relative.y);
+            float keep = pass < kMaxPasses ? std::max(0.0f, impact - kSkin / length) : 0.0f;
+            clipped_[i] = std::min(clipped_[i], moves_[i].fraction * keep);
+            clipped_[j] = std::min(clipped_[j], moves_[j].fraction * keep);
         }
+        for (std::size_t i = 0; i < moves_.size(); ++i) moves_[i].fraction = clipped_[i];
+        if (!conflict) return;
     }
 }
 
@@ -2,9 +2,14 @@
 #define ABYSSAL_STATION_SRC_AI_ENEMYMANAGER_H
 
 #include "Enemy.h"
+#include "CrowdSteering.h"
 #include <vector>
 #include <memory>
 
+namespace core { class ThreadPool; }
+namespace entities { class Player; }
+namespace collisions { class CollisionBox; }
+
 namespace ai {
 
 class EnemyManager {
@@ -12,26 +17,108 @@ public:
     EnemyManager() = default;
     ~EnemyManager() = default;
 
-    // Add an enemy by pointer ownership
-    // Register an enemy pointer (EntityManager keeps ownership via unique_ptr)
-    void addEnemyPointer(Enemy* e) { enemies_.push_back(e); }
+    // Register an enemy pointer (EntityManager keeps ownership via unique_ptr).
+    // Registered enemies are ticked only by this manager's pipeline.
+    void addEnemyPointer(Enemy* e);
+    void removeEnemyPointer(Enemy* e);
+    void clear();
+
+    // Baked static visibility shared by all enemies' sight checks (not owned)
+    void setVisibilityTable(const VisibilityTable* table) {
+        visibilityTable_ = table;
+        for (auto* e : enemies_) if (e) e->setVisibilityTable(table);
+    }
+
+    // Player cached once for the whole pipeline; every enemy targets it
+    void setPlayer(entities::Player* player);
+    entities::Player* getPlayer() const { return player_; }
+
+    // Workers for the sense stage (not owned, null runs it inline)
+    void setThreadPool(core::ThreadPool* pool) { threadPool_ = pool; }
+
+    // One frame of the enemy pipeline, each stage over all enemies:
+    // sense (sight checks, parallel) -> decide/act (FSM, movement intent) ->
+    // plan (collision-aware) -> steer (local avoidance) -> commit (batched)
+    void update(float dt, collisions::CollisionManager* cm);
 
-    // Update all enemies with the player's position (runs FSM)
-    void updateAll(float dt, const sf::Vector2f& playerPos);
+    // Individual stages, in pipeline order
+    void senseAll(collisions::CollisionManager* cm);
+    void thinkAll(float dt);
 
     // Plan movement for all enemies (collision-aware)
     void planAllMovement(float dt, collisions::CollisionManager* cm);
 
-    // Commit all planned moves after collision checks
+    // Local avoidance between enemies: adjusts planned moves before commit
+    void steerAllMoves(float dt);
+
+    // Commit all planned moves in one batch. World blockers come from a single
+    // broad-phase query and every swept box is paired in one sort-and-sweep;
+    // a move blocked by the world falls back to an axis slide. Enemy-vs-enemy
+    // conflicts clip both moves at their time of impact, so the result does not
+    // depend on enemy order. Colliders are updated together afterwards.
     void commitAllMoves(collisions::CollisionManager* cm);
 
+    struct CommitStats {
+        int moved = 0;
+        int slid = 0;               // Fell back to a single-axis slide
+        int blocked = 0;            // Stayed put because of the world
+        int agentConflicts = 0;     // Enemy pairs clipped at time of impact
+    };
+    const CommitStats& getCommitStats() const { return commitStats_; }
+
+    // Milliseconds per stage in the last update()
+    struct PipelineStats {
+        int frames = 0;
+        int enemies = 0;
+        int sawPlayer = 0;
+        float senseTime = 0.0f;
+        float thinkTime = 0.0f;
+        float planTime = 0.0f;
+        float commitTime = 0.0f;    // Steering and commit
+        float totalTime = 0.0f;
+    };
+    const PipelineStats& getPipelineStats() const { return pipelineStats_; }
+
     // Render all enemies
     void renderAll(sf::RenderWindow& window);
 
     std::vector<Enemy*>& enemies() { return enemies_; }
+    const std::vector<Enemy*>& enemies() const { return enemies_; }
+    CrowdSteering& crowdSteering() { return crowd_; }
 
 private:
     std::vector<Enemy*> enemies_;
+    const VisibilityTable* visibilityTable_{nullptr};
+    entities::Player* player_{nullptr};
+    sf::Vector2f playerPosition_;           // Read once per frame by every enemy
+    core::ThreadPool* threadPool_{nullptr};
+    PipelineStats pipelineStats_;
+    CrowdSteering crowd_;
+    std::vector<Enemy*> steered_;   // Enemies in crowd_ index order
+
+    // Batched commit scratch
+    struct PendingMove {
+        Enemy* enemy;
+        sf::FloatRect from;
+        sf::Vector2f target;
+        float fraction;             // Share of from -> target actually applied
+    };
+    struct SweepEntry {
+        float minX, maxX, minY, maxY;
+        int index;                  // < moves_.size(): enemy, otherwise world collider
+    };
+    std::vector<PendingMove> moves_;
+    std::vector<const collisions::CollisionBox*> world_;
+    std::vector<SweepEntry> sweep_;
+    std::vector<int> active_;
+    std::vector<std::pair<int, int>> worldPairs_;
+    std::vector<std::pair<int, int>> agentPairs_;
+    std::vector<float> clipped_;
+    std::vector<std::pair<entities::Entity*, sf::FloatRect>> colliderUpdates_;
+    CommitStats commitStats_;
+
+    void pairSweptBoxes();
+    void resolveAgentConflicts();
 };
 
 } // namespace ai
@@ -0,0 +1,384 @@
+#include "IncrementalPlanner.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ai {
+
+namespace {
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+constexpr float kDiagonalFactor = 1.41421356f;
+
+const int kOffsets[8][2] = {
+    {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+    {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+};
+}
+
+IncrementalPlanner::IncrementalPlanner(const IncrementalPlannerConfig& config)
+    : config_(config)
+    , grid_(nullptr)
+    , status_(Status::Idle)
+    , startCell_(-1)
+    , goalCell_(-1)
+    , lastStartCell_(-1)
+    , keyModifier_(0.0f)
+    , gridVersion_(0)
+    , dirty_(false)
+    , pathGoalCell_(-1)
+    , pathRevision_(0)
+{
+}
+
+template <typename Fn>
+void IncrementalPlanner::forEachNeighbor(int cell, Fn&& fn) const {
+    sf::Vector2i pos = grid_->cellFromIndex(cell);
+    const int neighborCount = config_.allowDiagonal ? 8 : 4;
+    for (int n = 0; n < neighborCount; ++n) {
+        int nx = pos.x + kOffsets[n][0];
+        int ny = pos.y + kOffsets[n][1];
+        if (grid_->inBounds(nx, ny)) {
+            fn(grid_->index(nx, ny));
+        }
+    }
+}
+
+void IncrementalPlanner::setGrid(const NavGrid* grid) {
+    if (grid == grid_) return;
+    grid_ = grid;
+    reset();
+}
+
+void IncrementalPlanner::reset() {
+    status_ = Status::Idle;
+    startCell_ = goalCell_ = lastStartCell_ = -1;
+    keyModifier_ = 0.0f;
+    open_.clear();
+    g_.clear();
+    rhs_.clear();
+    openKey_.clear();
+    inOpen_.clear();
+    if (!path_.empty()) {
+        path_.clear();
+        ++pathRevision_;
+    }
+}
+
+IncrementalPlanner::Status IncrementalPlanner::update(const sf::Vector2f& start, const sf::Vector2f& goal) {
+    stats_.expansionsLastUpdate = 0;
+
+    int startCell = -1;
+    int goalCell = -1;
+    if (grid_ && !grid_->empty()) {
+        sf::Vector2i startPos = grid_->worldToCell(start);
+        sf::Vector2i goalPos = grid_->worldToCell(goal);
+        if (grid_->inBounds(startPos.x, startPos.y) && grid_->inBounds(goalPos.x, goalPos.y)) {
+            startCell = freeCellNear(grid_->index(startPos.x, startPos.y));
+            goalCell = freeCellNear(grid_->index(goalPos.x, goalPos.y));
+        }
+    }
+    if (startCell < 0 || goalCell < 0) {
+        reset();
+        status_ = Status::NoPath;
+        return status_;
+    }
+
+    bool reroot = goalCell_ < 0 || g_.size() != static_cast<std::size_t>(grid_->cellCount());
+    if (!reroot && goalCell != goalCell_) {
+        // D* Lite needs a fixed root: a target drifting a cell or two keeps the tree
+        // and finishes with a straight step, anything further re-roots the search
+        sf::Vector2i a = grid_->cellFromIndex(goalCell_);
+        sf::Vector2i b = grid_->cellFromIndex(goalCell);
+        int drift = std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+        reroot = drift > config_.goalToleranceCells || !straightCellWalk(goalCell_, goalCell);
+    }
+
+    startCell_ = startCell;
+    if (reroot) {
+        goalCell_ = goalCell;
+        initialize();
+    } else {
+        if (startCell_ != lastStartCell_) {
+            keyModifier_ += heuristic(lastStartCell_, startCell_);
+            lastStartCell_ = startCell_;
+            dirty_ = true;
+        }
+        if (grid_->version() != gridVersion_ && !applyGridChanges()) {
+            initialize();
+        }
+    }
+
+    if (!computeShortestPath(config_.maxExpansionsPerUpdate)) {
+        status_ = Status::Searching;
+        return status_;
+    }
+
+    if (rhs_[startCell_] == kInfinity) {
+        if (!path_.empty()) {
+            path_.clear();
+            ++pathRevision_;
+        }
+        status_ = Status::NoPath;
+        return status_;
+    }
+
+    if (dirty_ || status_ != Status::Ready || goalCell != pathGoalCell_) {
+        extractPath(start, goal);
+        pathGoalCell_ = goalCell;
+    }
+    return status_;
+}
+
+void IncrementalPlanner::initialize() {
+    std::size_t cellCount = static_cast<std::size_t>(grid_->cellCount());
+    g_.assign(cellCount, kInfinity);
+    rhs_.assign(cellCount, kInfinity);
+    openKey_.assign(cellCount, Key{kInfinity, kInfinity});
+    inOpen_.assign(cellCount, 0);
+    open_.clear();
+
+    keyModifier_ = 0.0f;
+    lastStartCell_ = startCell_;
+    gridVersion_ = grid_->version();
+
+    rhs_[goalCell_] = 0.0f;
+    pushOpen(goalCell_, Key{heuristic(startCell_, goalCell_), 0.0f});
+
+    dirty_ = true;
+    stats_.fullReplans++;
+}
+
+bool IncrementalPlanner::applyGridChanges() {
+    changedCells_.clear();
+    if (!grid_->changedCellsSince(gridVersion_, changedCells_)) return false;
+    gridVersion_ = grid_->version();
+
+    std::sort(changedCells_.begin(), changedCells_.end());
+    changedCells_.erase(std::unique(changedCells_.begin(), changedCells_.end()), changedCells_.end());
+
+    // A toggled cell changes its own edges and the diagonals cutting its corners,
+    // and shifts clearance out to the agent radius; update every cell in that ring
+    int ring = 1 + static_cast<int>(std::ceil(std::max(0.0f, config_.agentRadius) / grid_->cellSize()));
+    for (int cell : changedCells_) {
+        sf::Vector2i pos = grid_->cellFromIndex(cell);
+        for (int y = pos.y - ring; y <= pos.y + ring; ++y) {
+            for (int x = pos.x - ring; x <= pos.x + ring; ++x) {
+                if (grid_->inBounds(x, y)) {
+                    updateVertex(grid_->index(x, y));
+                }
+            }
+        }
+    }
+
+    if (!changedCells_.empty()) {
+        dirty_ = true;
+        stats_.repairs++;
+    }
+    return true;
+}
+
+bool IncrementalPlanner::computeShortestPath(int budget) {
+    int expansions = 0;
+    bool converged = false;
+
+    while (true) {
+        Key top;
+        bool hasTop = topKey(top);
+        if (!hasTop || (!(top < calculateKey(startCell_)) && rhs_[startCell_] == g_[startCell_])) {
+            converged = true;
+            break;
+        }
+        if (budget > 0 && expansions >= budget) break;
+
+        std::pop_heap(open_.begin(), open_.end(), OpenCompare{});
+        int cell = open_.back().cell;
+        open_.pop_back();
+        inOpen_[cell] = 0;
+        ++expansions;
+
+        Key newKey = calculateKey(cell);
+        if (top < newKey) {
+            pushOpen(cell, newKey);
+        } else if (g_[cell] > rhs_[cell]) {
+            g_[cell] = rhs_[cell];
+            forEachNeighbor(cell, [this](int neighbor) { updateVertex(neighbor); });
+        } else {
+            g_[cell] = kInfinity;
+            updateVertex(cell);
+            forEachNeighbor(cell, [this](int neighbor) { updateVertex(neighbor); });
+        }
+    }
+
+    if (expansions > 0) dirty_ = true;
+    stats_.expansionsLastUpdate += expansions;
+    stats_.totalExpansions += expansions;
+    return converged;
+}
+
+void IncrementalPlanner::updateVertex(int cell) {
+    if (cell != goalCell_) {
+        float best = kInfinity;
+        forEachNeighbor(cell, [&](int neighbor) {
+            float cost = edgeCost(cell, neighbor);
+            if (cost < kInfinity) {
+                best = std::min(best, cost + g_[neighbor]);
+            }
+        });
+        rhs_[cell] = best;
+    }
+
+    inOpen_[cell] = 0;
+    if (g_[cell] != rhs_[cell]) {
+        pushOpen(cell, calculateKey(cell));
+    }
+}
+
+void IncrementalPlanner::pushOpen(int cell, const Key& key) {
+    openKey_[cell] = key;
+    inOpen_[cell] = 1;
+    open_.push_back({key, cell});
+    std::push_heap(open_.begin(), open_.end(), OpenCompare{});
+}
+
+bool IncrementalPlanner::topKey(Key& key) {
+    // Discard entries superseded by a later push or removed by updateVertex
+    while (!open_.empty()) {
+        const OpenEntry& front = open_.front();
+        if (inOpen_[front.cell] && openKey_[front.cell] == front.key) {
+            key = front.key;
+            return true;
+        }
+        std::pop_heap(open_.begin(), open_.end(), OpenCompare{});
+        open_.pop_back();
+    }
+    return false;
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculateKey(int cell) const {
+    float best = std::min(g_[cell], rhs_[cell]);
+    return Key{best + heuristic(startCell_, cell) + keyModifier_, best};
+}
+
+float IncrementalPlanner::heuristic(int cellA, int cellB) const {
+    sf::Vector2i a = grid_->cellFromIndex(cellA);
+    sf::Vector2i b = grid_->cellFromIndex(cellB);
+    float dx = static_cast<float>(std::abs(a.x - b.x));
+    float dy = static_cast<float>(std::abs(a.y - b.y));
+
+    if (config_.allowDiagonal) {
+        return (std::max(dx, dy) + (kDiagonalFactor - 1.0f) * std::min(dx, dy)) * grid_->cellSize();
+    }
+    return (dx + dy) * grid_->cellSize();
+}
+
+float IncrementalPlanner::edgeCost(int fromCell, int toCell) const {
+    if (!passable(fromCell) || !passable(toCell)) return kInfinity;
+
+    sf::Vector2i a = grid_->cellFromIndex(fromCell);
+    sf::Vector2i b = grid_->cellFromIndex(toCell);
+
+    if (a.x != b.x && a.y != b.y) {
+        // Do not cut corners around blocked cells
+        if (grid_->isBlocked(b.x, a.y) || grid_->isBlocked(a.x, b.y)) return kInfinity;
+        return grid_->cellSize() * kDiagonalFactor;
+    }
+    return grid_->cellSize();
+}
+
+bool IncrementalPlanner::passable(int cell) const {
+    // The goal is exempt from the clearance test so targets against walls stay reachable
+    sf::Vector2i pos = grid_->cellFromIndex(cell);
+    return grid_->isWalkable(pos.x, pos.y, cell == goalCell_ ? 0.0f : config_.agentRadius);
+}
+
+int IncrementalPlanner::freeCellNear(int cell) const {
+    sf::Vector2i pos = grid_->cellFromIndex(cell);
+    if (grid_->isWalkable(pos.x, pos.y, config_.agentRadius)) return cell;
+
+    // Prefer a neighbour wide enough for the agent, then any free one
+    int fallback = grid_->isBlocked(pos.x, pos.y) ? -1 : cell;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int x = pos.x + dx;
+            int y = pos.y + dy;
+            if (grid_->isWalkable(x, y, config_.agentRadius)) return grid_->index(x, y);
+            if (fallback < 0 && !grid_->isBlocked(x, y)) fallback = grid_->index(x, y);
+        }
+    }
+    return fallback;
+}
+
+bool IncrementalPlanner::straightCellWalk(int fromCell, int toCell) const {
+    sf::Vector2i a = grid_->cellFromIndex(fromCell);
+    sf::Vector2i b = grid_->cellFromIndex(toCell);
+    int dx = std::abs(b.x - a.x);
+    int dy = std::abs(b.y - a.y);
+    int sx = a.x < b.x ? 1 : -1;
+    int sy = a.y < b.y ? 1 : -1;
+    int err = dx - dy;
+
+    int x = a.x;
+    int y = a.y;
+    while (true) {
+        if (grid_->isBlocked(x, y)) return false;
+        if (x == b.x && y == b.y) return true;
+
+        int e2 = 2 * err;
+        int nx = x;
+        int ny = y;
+        if (e2 > -dy) { err -= dy; nx += sx; }
+        if (e2 < dx) { err += dx; ny += sy; }
+        if (nx != x && ny != y && (grid_->isBlocked(nx, y) || grid_->isBlocked(x, ny))) return false;
+        x = nx;
+        y = ny;
+    }
+}
+
+void IncrementalPlanner::extractPath(const sf::Vector2f& start, const sf::Vector2f& goal) {
+    // Follow the cheapest successor from the start; g-values are distances to the goal
+    std::vector<int> cells{startCell_};
+    int current = startCell_;
+    int guard = grid_->cellCount();
+    while (current != goalCell_ && guard-- > 0) {
+        int next = -1;
+        float bestCost = kInfinity;
+        forEachNeighbor(current, [&](int neighbor) {
+            float cost = edgeCost(current, neighbor) + g_[neighbor];
+            if (cost < bestCost) {
+                bestCost = cost;
+                next = neighbor;
+            }
+        });
+        if (next < 0) break;
+        cells.push_back(next);
+        current = next;
+    }
+
+    path_.clear();
+    ++pathRevision_;
+    dirty_ = false;
+    if (current != goalCell_) {
+        status_ = Status::NoPath;
+        return;
+    }
+
+    path_.push_back(start);
+    for (std::size_t i = 1; i + 1 < cells.size(); ++i) {
+        sf::Vector2i prev = grid_->cellFromIndex(cells[i - 1]);
+        sf::Vector2i curr = grid_->cellFromIndex(cells[i]);
+        sf::Vector2i next = grid_->cellFromIndex(cells[i + 1]);
+        if (curr - prev != next - curr) {
+            path_.push_back(grid_->cellToWorld(curr.x, curr.y));
+        }
+    }
+    sf::Vector2i root = grid_->cellFromIndex(goalCell_);
+    if (cells.size() > 1 && grid_->worldToCell(goal) != root) {
+        // Ends on the search root; a drifted target is reached with one straight step
+        path_.push_back(grid_->cellToWorld(root.x, root.y));
+    }
+    path_.push_back(goal);
+    status_ = Status::Ready;
+}
+
+} // namespace ai
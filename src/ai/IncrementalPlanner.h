@@ -0,0 +1,119 @@
+#ifndef ABYSSAL_STATION_SRC_AI_INCREMENTALPLANNER_H
+#define ABYSSAL_STATION_SRC_AI_INCREMENTALPLANNER_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace ai {
+
+class NavGrid;
+
+// Configuration for per-agent incremental replanning
+struct IncrementalPlannerConfig {
+    bool allowDiagonal = true;          // 8-connected grid (no corner cutting)
+    int maxExpansionsPerUpdate = 512;   // Search work per update(), 0 = run to completion
+    int goalToleranceCells = 2;         // Goal drift absorbed without re-rooting the search
+    float agentRadius = 0.0f;           // Cells with less clearance are treated as blocked
+};
+
+// D* Lite over a NavGrid. The search is rooted at the goal and keeps its
+// g/rhs values between calls, so agent movement only shifts the key modifier
+// and toggled cells (doors, dynamic obstacles) repair just the affected part
+// of the search tree. Work is capped per update() and resumes on the next call.
+class IncrementalPlanner {
+public:
+    enum class Status { Idle, Searching, Ready, NoPath };
+
+    explicit IncrementalPlanner(const IncrementalPlannerConfig& config = IncrementalPlannerConfig{});
+
+    void setGrid(const NavGrid* grid);
+    const NavGrid* getGrid() const { return grid_; }
+
+    // Plan (or repair) a route from start to goal and return the current status.
+    // While Searching, path() still holds the last complete route.
+    Status update(const sf::Vector2f& start, const sf::Vector2f& goal);
+    void reset();
+
+    Status status() const { return status_; }
+    bool hasPath() const { return !path_.empty(); }
+    const std::vector<sf::Vector2f>& path() const { return path_; }
+    // Bumped whenever path() is rebuilt
+    std::uint32_t pathRevision() const { return pathRevision_; }
+
+    void setConfig(const IncrementalPlannerConfig& config) { config_ = config; }
+    const IncrementalPlannerConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int expansionsLastUpdate = 0;
+        int totalExpansions = 0;
+        int fullReplans = 0;      // Search re-rooted from scratch
+        int repairs = 0;          // Grid changes absorbed incrementally
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    struct Key {
+        float primary;
+        float secondary;
+        bool operator<(const Key& other) const {
+            return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+        }
+        bool operator==(const Key& other) const {
+            return primary == other.primary && secondary == other.secondary;
+        }
+    };
+    struct OpenEntry {
+        Key key;
+        int cell;
+    };
+    struct OpenCompare {
+        bool operator()(const OpenEntry& a, const OpenEntry& b) const { return b.key < a.key; }
+    };
+
+    IncrementalPlannerConfig config_;
+    const NavGrid* grid_;
+    Status status_;
+
+    int startCell_;
+    int goalCell_;
+    int lastStartCell_;
+    float keyModifier_;
+    std::uint32_t gridVersion_;
+    bool dirty_;        // Search state changed since the path was extracted
+    int pathGoalCell_;  // Cell of the goal position the path was extracted for
+
+    // Dense per-cell search state; open set uses lazy deletion via openKey_
+    std::vector<float> g_;
+    std::vector<float> rhs_;
+    std::vector<Key> openKey_;
+    std::vector<std::uint8_t> inOpen_;
+    std::vector<OpenEntry> open_;
+
+    std::vector<sf::Vector2f> path_;
+    std::uint32_t pathRevision_;
+    std::vector<int> changedCells_;
+    Stats stats_;
+
+    void initialize();
+    bool applyGridChanges();
+    bool computeShortestPath(int budget);
+    void updateVertex(int cell);
+    void pushOpen(int cell, const Key& key);
+    bool topKey(Key& key);
+    Key calculateKey(int cell) const;
+    float heuristic(int cellA, int cellB) const;
+    float edgeCost(int fromCell, int toCell) const;
+    bool passable(int cell) const;
+    int freeCellNear(int cell) const;
+    bool straightCellWalk(int fromCell, int toCell) const;
+    void extractPath(const sf::Vector2f& start, const sf::Vector2f& goal);
+
+    template <typename Fn>
+    void forEachNeighbor(int cell, Fn&& fn) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_INCREMENTALPLANNER_H
@@ -0,0 +1,91 @@
+#include "LODScheduler.h"
+#include "AISystem.h"
+#include <algorithm>
+
+namespace ai {
+
+LODScheduler::LODScheduler(const LODConfig& config)
+    : config_(config)
+    , frame_(0)
+    , nextPhase_(0)
+{
+}
+
+LODTier LODScheduler::tierFor(const AIAgent& agent, const sf::Vector2f* focus) const {
+    if (!config_.enabled || !focus) return LODTier::Near;
+    sf::Vector2f delta = agent.getEntityPosition() - *focus;
+    float distanceSquared = delta.x * delta.x + delta.y * delta.y;
+    if (distanceSquared <= config_.nearDistance * config_.nearDistance) return LODTier::Near;
+    if (distanceSquared <= config_.farDistance * config_.farDistance) return LODTier::Mid;
+    return LODTier::Far;
+}
+
+const std::vector<LODScheduler::Task>& LODScheduler::schedule(const std::vector<AIAgent*>& agents,
+                                                              const sf::Vector2f* focus, float deltaTime) {
+    tasks_.clear();
+    due_.clear();
+    stats_ = Stats{};
+    ++frame_;
+
+    std::uint32_t interval = static_cast<std::uint32_t>(std::max(1, config_.midUpdateInterval));
+    for (auto* agent : agents) {
+        if (!agent) continue;
+        auto inserted = state_.emplace(agent, AgentState{});
+        AgentState& state = inserted.first->second;
+        if (inserted.second) {
+            // Round-robin phases spread mid-range agents evenly over the interval
+            state.phase = nextPhase_++;
+        }
+        state.pendingTime += deltaTime;
+
+        LODTier tier = tierFor(*agent, focus);
+        Task task{agent, UpdateKind::Skip, 0.0f, tier};
+        bool due = false;
+        switch (tier) {
+            case LODTier::Near:
+                due = true;
+                break;
+            case LODTier::Mid:
+                due = state.deferred || (frame_ + state.phase) % interval == 0;
+                break;
+            case LODTier::Far:
+                task.kind = UpdateKind::LowDetail;
+                task.deltaTime = state.pendingTime;
+                state.pendingTime = 0.0f;
+                state.deferred = false;
+                ++stats_.lowDetailUpdates;
+                break;
+        }
+        if (due) due_.push_back(tasks_.size());
+        tasks_.push_back(task);
+    }
+
+    // Over budget: most overdue agents first, the rest wait for the next frame
+    std::size_t budget = config_.maxFullUpdatesPerFrame > 0
+        ? static_cast<std::size_t>(config_.maxFullUpdatesPerFrame) : due_.size();
+    if (due_.size() > budget) {
+        std::stable_sort(due_.begin(), due_.end(), [this](std::size_t a, std::size_t b) {
+            return state_[tasks_[a].agent].pendingTime > state_[tasks_[b].agent].pendingTime;
+        });
+    }
+    for (std::size_t i = 0; i < due_.size(); ++i) {
+        Task& task = tasks_[due_[i]];
+        AgentState& state = state_[task.agent];
+        if (i < budget) {
+            task.kind = UpdateKind::Full;
+            task.deltaTime = state.pendingTime;
+            state.pendingTime = 0.0f;
+            state.deferred = false;
+            ++stats_.fullUpdates;
+        } else {
+            state.deferred = true;
+            ++stats_.deferredByBudget;
+        }
+    }
+    for (const auto& task : tasks_) {
+        if (task.kind == UpdateKind::Skip) ++stats_.skipped;
+    }
+    return tasks_;
+}
+
+} // namespace ai
@@ -0,0 +1,80 @@
+#ifndef ABYSSAL_STATION_SRC_AI_LODSCHEDULER_H
+#define ABYSSAL_STATION_SRC_AI_LODSCHEDULER_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace ai {
+
+class AIAgent;
+
+// Distance tiers relative to the LOD focus (usually the player)
+enum class LODTier : std::uint8_t { Near, Mid, Far };
+
+// Configuration for distance-based AI update rates
+struct LODConfig {
+    bool enabled = true;
+    float nearDistance = 480.0f;        // Full update every frame inside this radius
+    float farDistance = 1200.0f;        // Beyond this only timers and patrol interpolation run
+    int midUpdateInterval = 4;          // Mid-range agents get a full update every N frames
+    int maxFullUpdatesPerFrame = 0;     // Frame budget for full updates, 0 = unlimited
+};
+
+// Decides, per frame, which agents get a full update, a low-detail tick or
+// nothing. Mid-range agents are staggered by a per-agent phase so every frame
+// carries an even share, and skipped time is handed over on the next update.
+// When the frame budget is exceeded the most overdue agents go first.
+class LODScheduler {
+public:
+    enum class UpdateKind : std::uint8_t { Full, LowDetail, Skip };
+
+    struct Task {
+        AIAgent* agent;
+        UpdateKind kind;
+        float deltaTime;    // Includes time accumulated while skipped
+        LODTier tier;
+    };
+
+    explicit LODScheduler(const LODConfig& config = LODConfig{});
+
+    // Plan this frame for agents; without a focus every agent is Near
+    const std::vector<Task>& schedule(const std::vector<AIAgent*>& agents,
+                                      const sf::Vector2f* focus, float deltaTime);
+
+    void forget(const AIAgent* agent) { state_.erase(agent); }
+    void clear() { state_.clear(); }
+
+    void setConfig(const LODConfig& config) { config_ = config; }
+    const LODConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int fullUpdates = 0;
+        int lowDetailUpdates = 0;
+        int skipped = 0;
+        int deferredByBudget = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct AgentState {
+        std::uint32_t phase = 0;
+        float pendingTime = 0.0f;   // Time not yet handed to a full update
+        bool deferred = false;      // Missed its slot because of the frame budget
+    };
+
+    LODConfig config_;
+    std::unordered_map<const AIAgent*, AgentState> state_;
+    std::uint32_t frame_;
+    std::uint32_t nextPhase_;
+    std::vector<Task> tasks_;
+    std::vector<std::size_t> due_;
+    Stats stats_;
+
+    LODTier tierFor(const AIAgent& agent, const sf::Vector2f* focus) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_LODSCHEDULER_H
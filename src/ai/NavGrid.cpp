@@ -0,0 +1,291 @@
+#include "NavGrid.h"
+#include "collisions/CollisionManager.h"
+#include "core/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ai {
+
+namespace {
+constexpr std::size_t kMaxChangeLog = 4096;
+
+// Grid DDA from one cell center to another; visit(previousX, previousY, x, y)
+// sees each step and stops the walk by returning false
+template <typename Visit>
+bool walkLine(const sf::Vector2i& from, const sf::Vector2i& to, Visit&& visit) {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    int stepX = dx > 0 ? 1 : -1;
+    int stepY = dy > 0 ? 1 : -1;
+    int remainingX = std::abs(dx);
+    int remainingY = std::abs(dy);
+
+    // Ray parameter at which the segment crosses the next vertical/horizontal cell
+    // border; centers sit half a cell from each border
+    const float infinity = std::numeric_limits<float>::infinity();
+    float deltaX = remainingX > 0 ? 1.0f / remainingX : infinity;
+    float deltaY = remainingY > 0 ? 1.0f / remainingY : infinity;
+    float nextX = deltaX * 0.5f;
+    float nextY = deltaY * 0.5f;
+
+    int x = from.x;
+    int y = from.y;
+    while (remainingX > 0 || remainingY > 0) {
+        int previousX = x;
+        int previousY = y;
+        float difference = nextX - nextY;
+        if (std::abs(difference) < 1e-6f) {
+            // Exact corner crossing
+            x += stepX;
+            y += stepY;
+            nextX += deltaX;
+            nextY += deltaY;
+            --remainingX;
+            --remainingY;
+        } else if (difference < 0.0f) {
+            x += stepX;
+            nextX += deltaX;
+            --remainingX;
+        } else {
+            y += stepY;
+            nextY += deltaY;
+            --remainingY;
+        }
+        if (!visit(previousX, previousY, x, y)) return false;
+    }
+    return true;
+}
+}
+
+NavGrid::NavGrid(const NavGridConfig& config)
+    : config_(config)
+    , width_(0)
+    , height_(0)
+    , version_(0)
+    , changeLogBase_(0)
+{
+    resize();
+}
+
+void NavGrid::resize() {
+    if (config_.cellSize <= 0.0f) {
+        width_ = height_ = 0;
+    } else {
+        width_ = std::max(0, static_cast<int>(std::ceil(config_.bounds.size.x / config_.cellSize)));
+        height_ = std::max(0, static_cast<int>(std::ceil(config_.bounds.size.y / config_.cellSize)));
+    }
+    blocked_.assign(static_cast<std::size_t>(width_) * height_, 0);
+    ++version_;
+    resetChangeLog();
+    updateClearance();
+}
+
+void NavGrid::resetChangeLog() {
+    changeLog_.clear();
+    changeLogBase_ = version_;
+}
+
+void NavGrid::rebuild(const collisions::CollisionManager* collisionManager, const NavGridConfig& config) {
+    config_ = config;
+    resize();
+    rebuild(collisionManager);
+}
+
+void NavGrid::rebuild(const collisions::CollisionManager* collisionManager) {
+    std::fill(blocked_.begin(), blocked_.end(), 0);
+
+    int blockedCount = 0;
+    if (collisionManager) {
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                sf::FloatRect cellBounds;
+                cellBounds.position = config_.bounds.position +
+                    sf::Vector2f(x * config_.cellSize, y * config_.cellSize);
+                cellBounds.size = sf::Vector2f(config_.cellSize, config_.cellSize);
+
+                if (collisionManager->firstColliderForBounds(cellBounds, nullptr, config_.obstacleLayerMask)) {
+                    blocked_[index(x, y)] = 1;
+                    ++blockedCount;
+                }
+            }
+        }
+    }
+    ++version_;
+    resetChangeLog();
+    updateClearance();
+
+    core::Logger::instance().info("[AI] NavGrid rebuilt " + std::to_string(width_) + "x" +
+                                  std::to_string(height_) + " (" + std::to_string(blockedCount) +
+                                  " blocked cells)");
+}
+
+void NavGrid::clear() {
+    std::fill(blocked_.begin(), blocked_.end(), 0);
+    ++version_;
+    resetChangeLog();
+    updateClearance();
+}
+
+void NavGrid::setBlocked(int x, int y, bool blocked) {
+    if (setCell(x, y, blocked)) {
+        updateClearance();
+    }
+}
+
+bool NavGrid::setCell(int x, int y, bool blocked) {
+    if (!inBounds(x, y)) return false;
+
+    std::uint8_t value = blocked ? 1 : 0;
+    std::uint8_t& cell = blocked_[index(x, y)];
+    if (cell == value) return false;
+
+    cell = value;
+    ++version_;
+
+    if (changeLog_.size() >= kMaxChangeLog) {
+        // Drop the older half; planners older than that fall back to a full replan
+        changeLog_.erase(changeLog_.begin(), changeLog_.begin() + kMaxChangeLog / 2);
+        changeLogBase_ = changeLog_.front().version - 1;
+    }
+    changeLog_.push_back({version_, index(x, y)});
+    return true;
+}
+
+bool NavGrid::changedCellsSince(std::uint32_t sinceVersion, std::vector<int>& cells) const {
+    if (sinceVersion < changeLogBase_ || sinceVersion > version_) return false;
+
+    auto it = std::upper_bound(changeLog_.begin(), changeLog_.end(), sinceVersion,
+                               [](std::uint32_t version, const CellChange& change) {
+                                   return version < change.version;
+                               });
+    for (; it != changeLog_.end(); ++it) {
+        cells.push_back(it->cell);
+    }
+    return true;
+}
+
+void NavGrid::markRect(const sf::FloatRect& rect, bool blocked) {
+    if (empty()) return;
+
+    // Cells whose interior overlaps the rectangle (touching edges do not count)
+    sf::Vector2f local = rect.position - config_.bounds.position;
+    int minX = std::max(0, static_cast<int>(std::floor(local.x / config_.cellSize)));
+    int minY = std::max(0, static_cast<int>(std::floor(local.y / config_.cellSize)));
+    int maxX = std::min(width_ - 1, static_cast<int>(std::ceil((local.x + rect.size.x) / config_.cellSize)) - 1);
+    int maxY = std::min(height_ - 1, static_cast<int>(std::ceil((local.y + rect.size.y) / config_.cellSize)) - 1);
+
+    // One clearance pass for the whole rectangle rather than one per cell
+    bool changed = false;
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            changed |= setCell(x, y, blocked);
+        }
+    }
+    if (changed) {
+        updateClearance();
+    }
+}
+
+bool NavGrid::isBlocked(int x, int y) const {
+    if (!inBounds(x, y)) return true;
+    return blocked_[index(x, y)] != 0;
+}
+
+bool NavGrid::isBlocked(const sf::Vector2f& worldPos) const {
+    sf::Vector2i cell = worldToCell(worldPos);
+    return isBlocked(cell.x, cell.y);
+}
+
+float NavGrid::clearance(int x, int y) const {
+    if (!inBounds(x, y)) return 0.0f;
+    return clearance(index(x, y));
+}
+
+float NavGrid::clearance(int cellIndex) const {
+    return clearance_[cellIndex];
+}
+
+bool NavGrid::isWalkable(int x, int y, float agentRadius) const {
+    if (isBlocked(x, y)) return false;
+    return agentRadius <= 0.0f || clearance(index(x, y)) >= agentRadius;
+}
+
+bool NavGrid::hasLineOfSight(const sf::Vector2i& from, const sf::Vector2i& to, float agentRadius) const {
+    if (isBlocked(from.x, from.y) || isBlocked(to.x, to.y)) return false;
+
+    auto passable = [&](int x, int y) {
+        if ((x == to.x && y == to.y) || (x == from.x && y == from.y)) return !isBlocked(x, y);
+        return isWalkable(x, y, agentRadius);
+    };
+    return walkLine(from, to, [&](int previousX, int previousY, int x, int y) {
+        // Exact corner crossing: both side cells must be open
+        if (x != previousX && y != previousY && (!passable(x, previousY) || !passable(previousX, y))) {
+            return false;
+        }
+        return passable(x, y);
+    });
+}
+
+void NavGrid::traceLine(const sf::Vector2i& from, const sf::Vector2i& to, std::vector<int>& cells) const {
+    walkLine(from, to, [&](int, int, int x, int y) {
+        cells.push_back(index(x, y));
+        return true;
+    });
+}
+
+void NavGrid::updateClearance() {
+    // Two-pass chamfer transform (1, sqrt2) giving the center-to-center distance, in
+    // cells, to the nearest blocked cell; everything outside the grid counts as blocked
+    constexpr float kDiagonal = 1.41421356f;
+    const float far = static_cast<float>(width_ + height_);
+    clearance_.resize(blocked_.size());
+
+    auto distanceAt = [&](int x, int y) {
+        return inBounds(x, y) ? clearance_[index(x, y)] : 0.0f;
+    };
+
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            float& d = clearance_[index(x, y)];
+            if (blocked_[index(x, y)]) { d = 0.0f; continue; }
+            d = far;
+            d = std::min(d, distanceAt(x - 1, y) + 1.0f);
+            d = std::min(d, distanceAt(x, y - 1) + 1.0f);
+            d = std::min(d, distanceAt(x - 1, y - 1) + kDiagonal);
+            d = std::min(d, distanceAt(x + 1, y - 1) + kDiagonal);
+        }
+    }
+    for (int y = height_ - 1; y >= 0; --y) {
+        for (int x = width_ - 1; x >= 0; --x) {
+            float& d = clearance_[index(x, y)];
+            if (d == 0.0f) continue;
+            d = std::min(d, distanceAt(x + 1, y) + 1.0f);
+            d = std::min(d, distanceAt(x, y + 1) + 1.0f);
+            d = std::min(d, distanceAt(x + 1, y + 1) + kDiagonal);
+            d = std::min(d, distanceAt(x - 1, y + 1) + kDiagonal);
+        }
+    }
+
+    // Distance to the blocked cell's near edge rather than its center, in world units
+    for (float& d : clearance_) {
+        d = d > 0.0f ? (d - 0.5f) * config_.cellSize : 0.0f;
+    }
+}
+
+sf::Vector2i NavGrid::worldToCell(const sf::Vector2f& worldPos) const {
+    sf::Vector2f local = worldPos - config_.bounds.position;
+    return sf::Vector2i(
+        static_cast<int>(std::floor(local.x / config_.cellSize)),
+        static_cast<int>(std::floor(local.y / config_.cellSize))
+    );
+}
+
+sf::Vector2f NavGrid::cellToWorld(int x, int y) const {
+    return config_.bounds.position + sf::Vector2f(
+        x * config_.cellSize + config_.cellSize * 0.5f,
+        y * config_.cellSize + config_.cellSize * 0.5f
+    );
+}
+
+} // namespace ai
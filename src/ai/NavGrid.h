@@ -0,0 +1,100 @@
+#ifndef ABYSSAL_STATION_SRC_AI_NAVGRID_H
+#define ABYSSAL_STATION_SRC_AI_NAVGRID_H
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "entities/Entity.h"
+#include <vector>
+#include <cstdint>
+
+namespace collisions { class CollisionManager; }
+
+namespace ai {
+
+// Configuration for the navigation occupancy grid
+struct NavGridConfig {
+    float cellSize = 32.0f;                      // World units per cell
+    sf::FloatRect bounds{{0.f, 0.f}, {2048.f, 2048.f}}; // World area covered by the grid
+    std::uint32_t obstacleLayerMask = entities::kLayerMaskWall; // Layers baked as static obstacles
+};
+
+// Occupancy bitmap of the static level geometry. Searches run against this
+// read-only snapshot instead of issuing collider queries per node.
+class NavGrid {
+public:
+    explicit NavGrid(const NavGridConfig& config = NavGridConfig{});
+
+    // (Re)build occupancy by sampling the collision manager once per cell
+    void rebuild(const collisions::CollisionManager* collisionManager);
+    void rebuild(const collisions::CollisionManager* collisionManager, const NavGridConfig& config);
+
+    // Direct editing (level load, doors, tests)
+    void clear();
+    void setBlocked(int x, int y, bool blocked);
+    void markRect(const sf::FloatRect& rect, bool blocked = true);
+
+    // Queries. Out-of-bounds cells are reported as blocked.
+    bool isBlocked(int x, int y) const;
+    bool isBlocked(const sf::Vector2f& worldPos) const;
+    bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < width_ && y < height_; }
+    bool empty() const { return width_ == 0 || height_ == 0; }
+
+    // Clearance: world distance from a cell center to the nearest blocked cell or
+    // grid edge (0 for blocked cells). Recomputed by every occupancy change, so
+    // agents of any size share one grid, test walkability in O(1), and queries
+    // from worker threads never write to the grid.
+    float clearance(int x, int y) const;
+    float clearance(int cellIndex) const;
+    bool isWalkable(int x, int y, float agentRadius) const;
+
+    // Grid DDA between two cell centers. Every traversed cell must be walkable for
+    // the radius (endpoints only need to be free); passing exactly through a cell
+    // corner requires both side cells, matching the no-corner-cutting rule.
+    bool hasLineOfSight(const sf::Vector2i& from, const sf::Vector2i& to, float agentRadius = 0.0f) const;
+    // Indices of the cells the same DDA crosses after from, up to and including to
+    void traceLine(const sf::Vector2i& from, const sf::Vector2i& to, std::vector<int>& cells) const;
+
+    // Coordinate helpers
+    sf::Vector2i worldToCell(const sf::Vector2f& worldPos) const;
+    sf::Vector2f cellToWorld(int x, int y) const; // Cell center
+    int index(int x, int y) const { return y * width_ + x; }
+    sf::Vector2i cellFromIndex(int index) const { return {index % width_, index / width_}; }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int cellCount() const { return width_ * height_; }
+    float cellSize() const { return config_.cellSize; }
+    const NavGridConfig& getConfig() const { return config_; }
+
+    // Monotonic counter bumped on every occupancy change
+    std::uint32_t version() const { return version_; }
+
+    // Cells toggled by setBlocked()/markRect() after `sinceVersion`, for incremental
+    // replanning. Returns false when the log no longer reaches back that far
+    // (rebuild, clear, resize or overflow): callers must then replan from scratch.
+    bool changedCellsSince(std::uint32_t sinceVersion, std::vector<int>& cells) const;
+
+private:
+    NavGridConfig config_;
+    int width_;
+    int height_;
+    std::vector<std::uint8_t> blocked_;
+    std::uint32_t version_;
+    std::vector<float> clearance_;
+
+    struct CellChange {
+        std::uint32_t version;
+        int cell;
+    };
+    std::vector<CellChange> changeLog_;
+    std::uint32_t changeLogBase_; // Oldest version the log can answer from
+
+    void resize();
+    void resetChangeLog();
+    bool setCell(int x, int y, bool blocked);   // Occupancy and change log only
+    void updateClearance();
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_NAVGRID_H
@@ -0,0 +1,521 @@
+#include "NavMesh.h"
+#include "collisions/CollisionManager.h"
+#include "core/Logger.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+using json = nlohmann::json;
+
+namespace ai {
+
+namespace {
+constexpr float kEpsilon = 1e-3f;
+constexpr int kSerializationVersion = 1;
+
+float distance(const sf::Vector2f& a, const sf::Vector2f& b) {
+    sf::Vector2f d = b - a;
+    return std::sqrt(d.x * d.x + d.y * d.y);
+}
+
+float cross(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+// Twice the signed area of triangle abc (funnel side test)
+float triangleArea2(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c) {
+    sf::Vector2f ab = b - a;
+    sf::Vector2f ac = c - a;
+    return ac.x * ab.y - ab.x * ac.y;
+}
+
+bool nearlyEqual(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return std::abs(a.x - b.x) < kEpsilon && std::abs(a.y - b.y) < kEpsilon;
+}
+
+bool containsInclusive(const sf::FloatRect& rect, const sf::Vector2f& point) {
+    return point.x >= rect.position.x && point.x <= rect.position.x + rect.size.x &&
+           point.y >= rect.position.y && point.y <= rect.position.y + rect.size.y;
+}
+
+sf::Vector2f center(const sf::FloatRect& rect) {
+    return rect.position + rect.size * 0.5f;
+}
+
+// Sorted unique coordinates, merging values closer than kEpsilon
+void compress(std::vector<float>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end(),
+                             [](float a, float b) { return b - a < kEpsilon; }),
+                 values.end());
+}
+
+int coordinateIndex(const std::vector<float>& values, float value) {
+    return static_cast<int>(std::lower_bound(values.begin(), values.end(), value - kEpsilon) - values.begin());
+}
+}
+
+NavMesh::NavMesh(const NavMeshConfig& config)
+    : config_(config)
+    , bucketColumns_(0)
+    , bucketRows_(0)
+    , stamp_(0)
+{
+}
+
+void NavMesh::build(const collisions::CollisionManager* collisionManager, const NavMeshConfig& config) {
+    config_ = config;
+    build(collisionManager);
+}
+
+void NavMesh::build(const collisions::CollisionManager* collisionManager) {
+    build(collisionManager ? collisionManager->collectBounds(config_.obstacleLayerMask)
+                           : std::vector<sf::FloatRect>{});
+}
+
+void NavMesh::build(const std::vector<sf::FloatRect>& obstacles) {
+    clear();
+
+    // Space the agent center may occupy: bounds shrunk and walls grown by its radius
+    float radius = std::max(0.0f, config_.agentRadius);
+    sf::FloatRect area(config_.bounds.position + sf::Vector2f(radius, radius),
+                       config_.bounds.size - sf::Vector2f(radius * 2.0f, radius * 2.0f));
+    if (area.size.x <= 0.0f || area.size.y <= 0.0f) {
+        core::Logger::instance().warning("[AI] NavMesh: bounds smaller than agent radius");
+        return;
+    }
+
+    std::vector<sf::FloatRect> inflated;
+    std::vector<float> xs{area.position.x, area.position.x + area.size.x};
+    std::vector<float> ys{area.position.y, area.position.y + area.size.y};
+    for (const auto& obstacle : obstacles) {
+        sf::FloatRect grown(obstacle.position - sf::Vector2f(radius, radius),
+                            obstacle.size + sf::Vector2f(radius * 2.0f, radius * 2.0f));
+        auto clipped = grown.findIntersection(area);
+        if (!clipped) continue;
+
+        inflated.push_back(*clipped);
+        xs.push_back(clipped->position.x);
+        xs.push_back(clipped->position.x + clipped->size.x);
+        ys.push_back(clipped->position.y);
+        ys.push_back(clipped->position.y + clipped->size.y);
+    }
+
+    // Subtract obstacles on the grid induced by their edges (coordinate compression)
+    compress(xs);
+    compress(ys);
+    int columns = static_cast<int>(xs.size()) - 1;
+    int rows = static_cast<int>(ys.size()) - 1;
+    std::vector<std::uint8_t> blocked(static_cast<std::size_t>(columns) * rows, 0);
+    for (const auto& rect : inflated) {
+        int x0 = coordinateIndex(xs, rect.position.x);
+        int x1 = coordinateIndex(xs, rect.position.x + rect.size.x);
+        int y0 = coordinateIndex(ys, rect.position.y);
+        int y1 = coordinateIndex(ys, rect.position.y + rect.size.y);
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                blocked[y * columns + x] = 1;
+            }
+        }
+    }
+
+    // Greedy merge of free cells into maximal rectangles (row runs grown downwards)
+    struct CellRange { int x0, x1, y0, y1; };
+    std::vector<CellRange> ranges;
+    std::vector<int> owner(blocked.size(), -1);
+    auto available = [&](int x, int y) { return !blocked[y * columns + x] && owner[y * columns + x] < 0; };
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            if (!available(x, y)) continue;
+
+            int x1 = x;
+            while (x1 < columns && available(x1, y)) ++x1;
+            int y1 = y + 1;
+            while (y1 < rows) {
+                bool rowFree = true;
+                for (int cx = x; cx < x1 && rowFree; ++cx) rowFree = available(cx, y1);
+                if (!rowFree) break;
+                ++y1;
+            }
+
+            int id = static_cast<int>(ranges.size());
+            for (int cy = y; cy < y1; ++cy) {
+                for (int cx = x; cx < x1; ++cx) owner[cy * columns + cx] = id;
+            }
+            ranges.push_back({x, x1, y, y1});
+
+            Polygon polygon;
+            polygon.bounds = sf::FloatRect({xs[x], ys[y]}, {xs[x1] - xs[x], ys[y1] - ys[y]});
+            polygons_.push_back(std::move(polygon));
+        }
+    }
+
+    // Portals along the right and bottom edge of each rectangle (each pair found once)
+    for (int id = 0; id < static_cast<int>(ranges.size()); ++id) {
+        const CellRange& r = ranges[id];
+        if (r.x1 < columns) {
+            for (int y = r.y0; y < r.y1;) {
+                int other = owner[y * columns + r.x1];
+                int runEnd = y + 1;
+                while (runEnd < r.y1 && owner[runEnd * columns + r.x1] == other) ++runEnd;
+                if (other >= 0) {
+                    portals_.push_back({id, other, {xs[r.x1], ys[y]}, {xs[r.x1], ys[runEnd]}});
+                }
+                y = runEnd;
+            }
+        }
+        if (r.y1 < rows) {
+            for (int x = r.x0; x < r.x1;) {
+                int other = owner[r.y1 * columns + x];
+                int runEnd = x + 1;
+                while (runEnd < r.x1 && owner[r.y1 * columns + runEnd] == other) ++runEnd;
+                if (other >= 0) {
+                    portals_.push_back({id, other, {xs[x], ys[r.y1]}, {xs[runEnd], ys[r.y1]}});
+                }
+                x = runEnd;
+            }
+        }
+    }
+
+    linkPortals();
+    buildBuckets();
+
+    core::Logger::instance().info("[AI] NavMesh built: " + std::to_string(polygons_.size()) + " polygons, " +
+                                  std::to_string(portals_.size()) + " portals from " +
+                                  std::to_string(inflated.size()) + " obstacles");
+}
+
+void NavMesh::clear() {
+    polygons_.clear();
+    portals_.clear();
+    buckets_.clear();
+    bucketColumns_ = bucketRows_ = 0;
+}
+
+std::string NavMesh::serialize() const {
+    json j;
+    j["version"] = kSerializationVersion;
+    j["bounds"] = {config_.bounds.position.x, config_.bounds.position.y,
+                   config_.bounds.size.x, config_.bounds.size.y};
+    j["agentRadius"] = config_.agentRadius;
+
+    json polygons = json::array();
+    for (const auto& polygon : polygons_) {
+        polygons.push_back({polygon.bounds.position.x, polygon.bounds.position.y,
+                            polygon.bounds.size.x, polygon.bounds.size.y});
+    }
+    j["polygons"] = std::move(polygons);
+
+    json portals = json::array();
+    for (const auto& portal : portals_) {
+        portals.push_back({portal.polygonA, portal.polygonB,
+                           portal.start.x, portal.start.y, portal.end.x, portal.end.y});
+    }
+    j["portals"] = std::move(portals);
+    return j.dump();
+}
+
+bool NavMesh::deserialize(const std::string& data) {
+    try {
+        json j = json::parse(data);
+        if (j.value("version", 0) != kSerializationVersion) {
+            core::Logger::instance().warning("[AI] NavMesh: unsupported mesh version");
+            return false;
+        }
+
+        std::vector<Polygon> polygons;
+        for (const auto& entry : j.at("polygons")) {
+            Polygon polygon;
+            polygon.bounds = sf::FloatRect({entry.at(0).get<float>(), entry.at(1).get<float>()},
+                                           {entry.at(2).get<float>(), entry.at(3).get<float>()});
+            polygons.push_back(std::move(polygon));
+        }
+
+        std::vector<Portal> portals;
+        int polygonCount = static_cast<int>(polygons.size());
+        for (const auto& entry : j.at("portals")) {
+            Portal portal{entry.at(0).get<int>(), entry.at(1).get<int>(),
+                          {entry.at(2).get<float>(), entry.at(3).get<float>()},
+                          {entry.at(4).get<float>(), entry.at(5).get<float>()}};
+            if (portal.polygonA < 0 || portal.polygonA >= polygonCount ||
+                portal.polygonB < 0 || portal.polygonB >= polygonCount) {
+                core::Logger::instance().warning("[AI] NavMesh: portal references missing polygon");
+                return false;
+            }
+            portals.push_back(portal);
+        }
+
+        const auto& bounds = j.at("bounds");
+        config_.bounds = sf::FloatRect({bounds.at(0).get<float>(), bounds.at(1).get<float>()},
+                                       {bounds.at(2).get<float>(), bounds.at(3).get<float>()});
+        config_.agentRadius = j.value("agentRadius", config_.agentRadius);
+        polygons_ = std::move(polygons);
+        portals_ = std::move(portals);
+        linkPortals();
+        buildBuckets();
+        return true;
+    } catch (const std::exception& ex) {
+        core::Logger::instance().error(std::string("[AI] NavMesh: failed to parse mesh: ") + ex.what());
+        return false;
+    }
+}
+
+bool NavMesh::saveToFile(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.good()) {
+        core::Logger::instance().error("[AI] NavMesh: failed to open for writing: " + path);
+        return false;
+    }
+    out << serialize();
+    core::Logger::instance().info("[AI] NavMesh saved to " + path);
+    return true;
+}
+
+bool NavMesh::loadFromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.good()) {
+        core::Logger::instance().warning("[AI] NavMesh: file not found: " + path);
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!deserialize(data)) return false;
+
+    core::Logger::instance().info("[AI] NavMesh loaded from " + path + " (" +
+                                  std::to_string(polygons_.size()) + " polygons)");
+    return true;
+}
+
+int NavMesh::findPolygon(const sf::Vector2f& point) const {
+    if (buckets_.empty()) return -1;
+
+    sf::Vector2f local = point - config_.bounds.position;
+    int column = static_cast<int>(std::floor(local.x / config_.bucketSize));
+    int row = static_cast<int>(std::floor(local.y / config_.bucketSize));
+    if (column < 0 || row < 0 || column >= bucketColumns_ || row >= bucketRows_) return -1;
+
+    for (int id : buckets_[row * bucketColumns_ + column]) {
+        if (containsInclusive(polygons_[id].bounds, point)) return id;
+    }
+    return -1;
+}
+
+PathfindingResult NavMesh::findPath(const sf::Vector2f& start, const sf::Vector2f& goal) {
+    PathfindingResult result;
+    if (polygons_.empty()) return result;
+
+    // Endpoints inside the inflated wall margin are snapped onto the nearest region
+    sf::Vector2f from;
+    sf::Vector2f to;
+    int startPolygon = nearestPolygon(start, from);
+    int goalPolygon = nearestPolygon(goal, to);
+    if (startPolygon < 0 || goalPolygon < 0) return result;
+
+    std::size_t count = polygons_.size();
+    if (gCost_.size() != count) {
+        gCost_.assign(count, 0.0f);
+        entryPoint_.assign(count, sf::Vector2f());
+        parentPortal_.assign(count, -1);
+        visitStamp_.assign(count, 0);
+        closedStamp_.assign(count, 0);
+        stamp_ = 0;
+    }
+    if (++stamp_ == 0) {
+        std::fill(visitStamp_.begin(), visitStamp_.end(), 0);
+        std::fill(closedStamp_.begin(), closedStamp_.end(), 0);
+        stamp_ = 1;
+    }
+    open_.clear();
+
+    // A* over regions; each region is entered at the midpoint of the portal used
+    gCost_[startPolygon] = 0.0f;
+    entryPoint_[startPolygon] = from;
+    parentPortal_[startPolygon] = -1;
+    visitStamp_[startPolygon] = stamp_;
+    open_.push_back({distance(from, to), startPolygon});
+
+    bool found = false;
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), OpenCompare{});
+        int current = open_.back().polygon;
+        open_.pop_back();
+        if (closedStamp_[current] == stamp_) continue;
+        closedStamp_[current] = stamp_;
+        ++result.iterations;
+
+        if (current == goalPolygon) {
+            found = true;
+            break;
+        }
+
+        for (int portalIndex : polygons_[current].portals) {
+            const Portal& portal = portals_[portalIndex];
+            int next = portal.polygonA == current ? portal.polygonB : portal.polygonA;
+            if (closedStamp_[next] == stamp_) continue;
+
+            sf::Vector2f entry = (portal.start + portal.end) * 0.5f;
+            float tentativeG = gCost_[current] + distance(entryPoint_[current], entry);
+            if (visitStamp_[next] != stamp_ || tentativeG < gCost_[next]) {
+                visitStamp_[next] = stamp_;
+                gCost_[next] = tentativeG;
+                entryPoint_[next] = entry;
+                parentPortal_[next] = portalIndex;
+                open_.push_back({tentativeG + distance(entry, to), next});
+                std::push_heap(open_.begin(), open_.end(), OpenCompare{});
+            }
+        }
+    }
+    if (!found) return result;
+
+    std::vector<int> chain;
+    for (int polygon = goalPolygon; polygon != startPolygon;) {
+        const Portal& portal = portals_[parentPortal_[polygon]];
+        chain.push_back(parentPortal_[polygon]);
+        polygon = portal.polygonA == polygon ? portal.polygonB : portal.polygonA;
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    std::vector<sf::Vector2f> corridor = stringPull(from, to, chain, startPolygon);
+    result.path.push_back(start);
+    for (const auto& point : corridor) {
+        if (!nearlyEqual(point, result.path.back())) result.path.push_back(point);
+    }
+    if (!nearlyEqual(goal, result.path.back())) result.path.push_back(goal);
+    if (result.path.size() == 1) result.path.push_back(goal);
+
+    for (std::size_t i = 1; i < result.path.size(); ++i) {
+        result.totalCost += distance(result.path[i - 1], result.path[i]);
+    }
+    result.success = true;
+    return result;
+}
+
+void NavMesh::linkPortals() {
+    for (auto& polygon : polygons_) {
+        polygon.portals.clear();
+    }
+    for (int i = 0; i < static_cast<int>(portals_.size()); ++i) {
+        polygons_[portals_[i].polygonA].portals.push_back(i);
+        polygons_[portals_[i].polygonB].portals.push_back(i);
+    }
+}
+
+void NavMesh::buildBuckets() {
+    buckets_.clear();
+    if (config_.bucketSize <= 0.0f) return;
+
+    bucketColumns_ = std::max(1, static_cast<int>(std::ceil(config_.bounds.size.x / config_.bucketSize)));
+    bucketRows_ = std::max(1, static_cast<int>(std::ceil(config_.bounds.size.y / config_.bucketSize)));
+    buckets_.resize(static_cast<std::size_t>(bucketColumns_) * bucketRows_);
+
+    for (int id = 0; id < static_cast<int>(polygons_.size()); ++id) {
+        sf::FloatRect bounds = polygons_[id].bounds;
+        sf::Vector2f local = bounds.position - config_.bounds.position;
+        int x0 = std::max(0, static_cast<int>(std::floor(local.x / config_.bucketSize)));
+        int y0 = std::max(0, static_cast<int>(std::floor(local.y / config_.bucketSize)));
+        int x1 = std::min(bucketColumns_ - 1, static_cast<int>(std::floor((local.x + bounds.size.x) / config_.bucketSize)));
+        int y1 = std::min(bucketRows_ - 1, static_cast<int>(std::floor((local.y + bounds.size.y) / config_.bucketSize)));
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                buckets_[y * bucketColumns_ + x].push_back(id);
+            }
+        }
+    }
+}
+
+int NavMesh::nearestPolygon(const sf::Vector2f& point, sf::Vector2f& clamped) const {
+    int id = findPolygon(point);
+    if (id >= 0) {
+        clamped = point;
+        return id;
+    }
+
+    float bestDistance = 0.0f;
+    for (int i = 0; i < static_cast<int>(polygons_.size()); ++i) {
+        const sf::FloatRect& bounds = polygons_[i].bounds;
+        sf::Vector2f candidate(
+            std::clamp(point.x, bounds.position.x, bounds.position.x + bounds.size.x),
+            std::clamp(point.y, bounds.position.y, bounds.position.y + bounds.size.y));
+        float d = distance(point, candidate);
+        if (id < 0 || d < bestDistance) {
+            id = i;
+            bestDistance = d;
+            clamped = candidate;
+        }
+    }
+    return id;
+}
+
+std::vector<sf::Vector2f> NavMesh::stringPull(const sf::Vector2f& start, const sf::Vector2f& goal,
+                                              const std::vector<int>& portalChain, int startPolygon) const {
+    // Orient every portal as (left, right) seen when crossing it
+    std::vector<sf::Vector2f> lefts{start};
+    std::vector<sf::Vector2f> rights{start};
+    int current = startPolygon;
+    for (int portalIndex : portalChain) {
+        const Portal& portal = portals_[portalIndex];
+        int next = portal.polygonA == current ? portal.polygonB : portal.polygonA;
+        sf::Vector2f direction = center(polygons_[next].bounds) - center(polygons_[current].bounds);
+        sf::Vector2f middle = (portal.start + portal.end) * 0.5f;
+        bool startIsRight = cross(direction, portal.start - middle) < 0.0f;
+        lefts.push_back(startIsRight ? portal.end : portal.start);
+        rights.push_back(startIsRight ? portal.start : portal.end);
+        current = next;
+    }
+    lefts.push_back(goal);
+    rights.push_back(goal);
+
+    // Simple stupid funnel algorithm
+    std::vector<sf::Vector2f> points{start};
+    sf::Vector2f apex = start;
+    sf::Vector2f funnelLeft = lefts[0];
+    sf::Vector2f funnelRight = rights[0];
+    std::size_t apexIndex = 0;
+    std::size_t leftIndex = 0;
+    std::size_t rightIndex = 0;
+
+    for (std::size_t i = 1; i < lefts.size(); ++i) {
+        const sf::Vector2f& left = lefts[i];
+        const sf::Vector2f& right = rights[i];
+
+        // Tighten the right side
+        if (triangleArea2(apex, funnelRight, right) <= 0.0f) {
+            if (nearlyEqual(apex, funnelRight) || triangleArea2(apex, funnelLeft, right) > 0.0f) {
+                funnelRight = right;
+                rightIndex = i;
+            } else {
+                // Right crossed over left: the left corner becomes the new apex
+                points.push_back(funnelLeft);
+                apex = funnelLeft;
+                apexIndex = leftIndex;
+                funnelLeft = funnelRight = apex;
+                leftIndex = rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // Tighten the left side
+        if (triangleArea2(apex, funnelLeft, left) >= 0.0f) {
+            if (nearlyEqual(apex, funnelLeft) || triangleArea2(apex, funnelRight, left) < 0.0f) {
+                funnelLeft = left;
+                leftIndex = i;
+            } else {
+                points.push_back(funnelRight);
+                apex = funnelRight;
+                apexIndex = rightIndex;
+                funnelLeft = funnelRight = apex;
+                leftIndex = rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+
+    if (!nearlyEqual(points.back(), goal)) points.push_back(goal);
+    return points;
+}
+
+} // namespace ai
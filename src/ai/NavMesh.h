@@ -0,0 +1,104 @@
+#ifndef ABYSSAL_STATION_SRC_AI_NAVMESH_H
+#define ABYSSAL_STATION_SRC_AI_NAVMESH_H
+
+#include "Pathfinding.h"
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "entities/Entity.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace collisions { class CollisionManager; }
+
+namespace ai {
+
+// Configuration for navmesh baking
+struct NavMeshConfig {
+    sf::FloatRect bounds{{0.f, 0.f}, {2048.f, 2048.f}};        // World area covered by the mesh
+    std::uint32_t obstacleLayerMask = entities::kLayerMaskWall; // Layers subtracted from the bounds
+    float agentRadius = 16.0f;                                  // Obstacles are inflated by this much
+    float bucketSize = 128.0f;                                  // Point-location grid resolution
+};
+
+// Navigation mesh of convex free-space regions. Static walls are axis-aligned,
+// so free space is decomposed into maximal rectangles instead of triangles:
+// fewer, larger polygons for open rooms and exact portals between them. Paths
+// run A* over regions and are string-pulled through the portal corridor.
+class NavMesh {
+public:
+    struct Polygon {
+        sf::FloatRect bounds;
+        std::vector<int> portals;   // Indices into portals()
+    };
+
+    // Shared edge between two adjacent polygons
+    struct Portal {
+        int polygonA;
+        int polygonB;
+        sf::Vector2f start;
+        sf::Vector2f end;
+    };
+
+    explicit NavMesh(const NavMeshConfig& config = NavMeshConfig{});
+
+    // Bake from wall colliders (or an explicit obstacle list)
+    void build(const collisions::CollisionManager* collisionManager);
+    void build(const collisions::CollisionManager* collisionManager, const NavMeshConfig& config);
+    void build(const std::vector<sf::FloatRect>& obstacles);
+    void clear();
+
+    // Prebuilt meshes for large maps
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+    std::string serialize() const;
+    bool deserialize(const std::string& data);
+
+    // Polygon containing the point, -1 when it lies in an obstacle or outside
+    int findPolygon(const sf::Vector2f& point) const;
+
+    // A* over polygons followed by funnel refinement
+    PathfindingResult findPath(const sf::Vector2f& start, const sf::Vector2f& goal);
+
+    const std::vector<Polygon>& polygons() const { return polygons_; }
+    const std::vector<Portal>& portals() const { return portals_; }
+    bool empty() const { return polygons_.empty(); }
+    const NavMeshConfig& getConfig() const { return config_; }
+
+private:
+    struct OpenEntry {
+        float fCost;
+        int polygon;
+    };
+    struct OpenCompare {
+        bool operator()(const OpenEntry& a, const OpenEntry& b) const { return a.fCost > b.fCost; }
+    };
+
+    NavMeshConfig config_;
+    std::vector<Polygon> polygons_;
+    std::vector<Portal> portals_;
+
+    // Uniform buckets of overlapping polygon indices for point location
+    std::vector<std::vector<int>> buckets_;
+    int bucketColumns_;
+    int bucketRows_;
+
+    // Search scratch, invalidated by bumping stamp_
+    std::vector<float> gCost_;
+    std::vector<sf::Vector2f> entryPoint_;
+    std::vector<int> parentPortal_;
+    std::vector<std::uint32_t> visitStamp_;
+    std::vector<std::uint32_t> closedStamp_;
+    std::uint32_t stamp_;
+    std::vector<OpenEntry> open_;
+
+    void linkPortals();
+    void buildBuckets();
+    int nearestPolygon(const sf::Vector2f& point, sf::Vector2f& clamped) const;
+    std::vector<sf::Vector2f> stringPull(const sf::Vector2f& start, const sf::Vector2f& goal,
+                                         const std::vector<int>& portalChain, int startPolygon) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_NAVMESH_H
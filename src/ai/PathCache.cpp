@@ -0,0 +1,201 @@
+#include "PathCache.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ai {
+
+PathCache::PathCache(const PathCacheConfig& config)
+    : config_(config)
+    , gridVersion_(0)
+{
+}
+
+PathCacheKey PathCache::makeKey(const NavGrid& grid, const sf::Vector2f& start, const sf::Vector2f& goal,
+                                const PathfindingConfig& config) {
+    PathCacheKey key;
+    sf::Vector2i startPos = grid.worldToCell(start);
+    sf::Vector2i goalPos = grid.worldToCell(goal);
+    key.startCell = grid.inBounds(startPos.x, startPos.y) ? grid.index(startPos.x, startPos.y) : -1;
+    key.goalCell = grid.inBounds(goalPos.x, goalPos.y) ? grid.index(goalPos.x, goalPos.y) : -1;
+    key.obstacleMask = config.obstacleLayerMask;
+    key.sizeClass = sizeClassFor(config.agentRadius);
+    key.anyAngle = config.anyAngle;
+    return key;
+}
+
+std::uint8_t PathCache::sizeClassFor(float agentRadius) {
+    // 4 world-unit buckets: 28px and 32px enemies share routes only if they fit the same gaps
+    float bucket = std::ceil(std::max(0.0f, agentRadius) / 4.0f);
+    return static_cast<std::uint8_t>(std::min(255.0f, bucket));
+}
+
+bool PathCache::lookup(const NavGrid& grid, const PathCacheKey& key, const sf::Vector2f& start,
+                       const sf::Vector2f& goal, PathfindingResult& result) {
+    syncVersion(grid);
+
+    if (key.startCell < 0 || key.goalCell < 0) {
+        stats_.misses++;
+        return false;
+    }
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        buildResult(*it->second, 0, start, goal, result);
+        stats_.hits++;
+        return true;
+    }
+
+    if (config_.allowPartialReuse) {
+        auto goalIt = byGoal_.find(goalKey(key));
+        if (goalIt != byGoal_.end()) {
+            for (auto entryIt : goalIt->second) {
+                const auto& cells = entryIt->cells;
+                auto cellIt = std::find(cells.begin(), cells.end(), key.startCell);
+                if (cellIt == cells.end()) continue;
+                std::size_t fromCell = static_cast<std::size_t>(cellIt - cells.begin());
+                if (key.anyAngle && !reachesNextTurn(grid, *entryIt, fromCell)) continue;
+
+                entries_.splice(entries_.begin(), entries_, entryIt);
+                buildResult(*entryIt, fromCell, start, goal, result);
+                stats_.partialHits++;
+                return true;
+            }
+        }
+    }
+
+    stats_.misses++;
+    return false;
+}
+
+void PathCache::store(const NavGrid& grid, const PathCacheKey& key, const std::vector<int>& cells) {
+    syncVersion(grid);
+    if (cells.empty() || key.startCell < 0 || key.goalCell < 0 || config_.capacity == 0) return;
+
+    Entry entry;
+    entry.key = key;
+    if (key.anyAngle) {
+        // Any-angle routes arrive as their vertices: keep every cell each leg
+        // crosses so a start anywhere along a leg finds the route
+        entry.cells.push_back(cells.front());
+        for (std::size_t i = 1; i < cells.size(); ++i) {
+            grid.traceLine(grid.cellFromIndex(cells[i - 1]), grid.cellFromIndex(cells[i]), entry.cells);
+            if (i + 1 < cells.size()) {
+                sf::Vector2i vertex = grid.cellFromIndex(cells[i]);
+                entry.turns.push_back(grid.cellToWorld(vertex.x, vertex.y));
+                entry.turnCellIndex.push_back(static_cast<int>(entry.cells.size() - 1));
+            }
+        }
+    } else {
+        entry.cells = cells;
+        for (std::size_t i = 1; i + 1 < cells.size(); ++i) {
+            sf::Vector2i prev = grid.cellFromIndex(cells[i - 1]);
+            sf::Vector2i curr = grid.cellFromIndex(cells[i]);
+            sf::Vector2i next = grid.cellFromIndex(cells[i + 1]);
+            if (curr - prev != next - curr) {
+                entry.turns.push_back(grid.cellToWorld(curr.x, curr.y));
+                entry.turnCellIndex.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    auto existing = index_.find(key);
+    if (existing != index_.end()) {
+        *existing->second = std::move(entry);
+        entries_.splice(entries_.begin(), entries_, existing->second);
+        return;
+    }
+
+    entries_.push_front(std::move(entry));
+    index_[key] = entries_.begin();
+    byGoal_[goalKey(key)].push_back(entries_.begin());
+
+    while (entries_.size() > config_.capacity) {
+        evictOldest();
+    }
+}
+
+void PathCache::clear() {
+    entries_.clear();
+    index_.clear();
+    byGoal_.clear();
+}
+
+void PathCache::setConfig(const PathCacheConfig& config) {
+    config_ = config;
+    while (entries_.size() > config_.capacity) {
+        evictOldest();
+    }
+}
+
+PathCacheKey PathCache::goalKey(const PathCacheKey& key) {
+    PathCacheKey goal = key;
+    goal.startCell = -1;
+    return goal;
+}
+
+void PathCache::syncVersion(const NavGrid& grid) {
+    if (grid.version() == gridVersion_) return;
+
+    if (!entries_.empty()) {
+        stats_.invalidations++;
+    }
+    clear();
+    gridVersion_ = grid.version();
+}
+
+void PathCache::evictOldest() {
+    if (entries_.empty()) return;
+
+    auto oldest = std::prev(entries_.end());
+    index_.erase(oldest->key);
+
+    auto goalIt = byGoal_.find(goalKey(oldest->key));
+    if (goalIt != byGoal_.end()) {
+        auto& routes = goalIt->second;
+        routes.erase(std::remove(routes.begin(), routes.end(), oldest), routes.end());
+        if (routes.empty()) {
+            byGoal_.erase(goalIt);
+        }
+    }
+
+    entries_.erase(oldest);
+    stats_.evictions++;
+}
+
+bool PathCache::reachesNextTurn(const NavGrid& grid, const Entry& entry, std::size_t fromCell) const {
+    // A straight leg only guarantees sight from its own vertex: the start cell
+    // merely lies on it, so test the shortcut to the next vertex (or the goal)
+    int next = entry.cells.back();
+    for (std::size_t i = 0; i < entry.turnCellIndex.size(); ++i) {
+        if (static_cast<std::size_t>(entry.turnCellIndex[i]) > fromCell) {
+            next = entry.cells[entry.turnCellIndex[i]];
+            break;
+        }
+    }
+    // Top of the size class bucket, so the test never admits a wider agent
+    float radius = entry.key.sizeClass * 4.0f;
+    return grid.hasLineOfSight(grid.cellFromIndex(entry.cells[fromCell]), grid.cellFromIndex(next), radius);
+}
+
+void PathCache::buildResult(const Entry& entry, std::size_t fromCell, const sf::Vector2f& start,
+                            const sf::Vector2f& goal, PathfindingResult& result) const {
+    result = PathfindingResult{};
+    result.path.push_back(start);
+    for (std::size_t i = 0; i < entry.turns.size(); ++i) {
+        if (static_cast<std::size_t>(entry.turnCellIndex[i]) > fromCell) {
+            result.path.push_back(entry.turns[i]);
+        }
+    }
+    result.path.push_back(goal);
+
+    for (std::size_t i = 1; i < result.path.size(); ++i) {
+        sf::Vector2f segment = result.path[i] - result.path[i - 1];
+        result.totalCost += std::sqrt(segment.x * segment.x + segment.y * segment.y);
+    }
+    result.success = true;
+    result.fromCache = true;
+}
+
+} // namespace ai
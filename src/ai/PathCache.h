@@ -0,0 +1,106 @@
+#ifndef ABYSSAL_STATION_SRC_AI_PATHCACHE_H
+#define ABYSSAL_STATION_SRC_AI_PATHCACHE_H
+
+#include "Pathfinding.h"
+#include <SFML/System/Vector2.hpp>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace ai {
+
+class NavGrid;
+
+// Identifies a grid route: endpoints plus everything that changes walkability
+struct PathCacheKey {
+    int startCell = -1;
+    int goalCell = -1;
+    std::uint32_t obstacleMask = 0;
+    std::uint8_t sizeClass = 0;
+    bool anyAngle = false;
+
+    bool operator==(const PathCacheKey& other) const {
+        return startCell == other.startCell && goalCell == other.goalCell &&
+               obstacleMask == other.obstacleMask && sizeClass == other.sizeClass &&
+               anyAngle == other.anyAngle;
+    }
+};
+
+struct PathCacheConfig {
+    std::size_t capacity = 256;      // Maximum cached routes (least recently used evicted)
+    bool allowPartialReuse = true;   // Serve a suffix when the start lies on a cached route
+};
+
+// LRU cache of grid routes. Entries are only valid for the NavGrid version
+// they were computed against; any occupancy change drops the whole cache.
+class PathCache {
+public:
+    explicit PathCache(const PathCacheConfig& config = PathCacheConfig{});
+
+    static PathCacheKey makeKey(const NavGrid& grid, const sf::Vector2f& start, const sf::Vector2f& goal,
+                                const PathfindingConfig& config);
+    static std::uint8_t sizeClassFor(float agentRadius);
+
+    // Fill `result` from the cache. Returns false on a miss.
+    bool lookup(const NavGrid& grid, const PathCacheKey& key, const sf::Vector2f& start,
+                const sf::Vector2f& goal, PathfindingResult& result);
+
+    // Store the dense cell sequence of a route found against `grid`
+    void store(const NavGrid& grid, const PathCacheKey& key, const std::vector<int>& cells);
+
+    void clear();
+    std::size_t size() const { return entries_.size(); }
+
+    void setConfig(const PathCacheConfig& config);
+    const PathCacheConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int hits = 0;
+        int partialHits = 0;
+        int misses = 0;
+        int evictions = 0;
+        int invalidations = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    struct Entry {
+        PathCacheKey key;
+        std::vector<int> cells;          // Every route cell, start to goal (any-angle legs traced)
+        std::vector<sf::Vector2f> turns; // Interior turning points (world)
+        std::vector<int> turnCellIndex;  // Index into `cells` of each turning point
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const PathCacheKey& key) const {
+            std::size_t h = std::hash<int>()(key.startCell);
+            h = h * 31 + std::hash<int>()(key.goalCell);
+            h = h * 31 + std::hash<std::uint32_t>()(key.obstacleMask);
+            h = h * 31 + key.sizeClass;
+            return h * 2 + (key.anyAngle ? 1 : 0);
+        }
+    };
+
+    using EntryList = std::list<Entry>;
+
+    PathCacheConfig config_;
+    EntryList entries_; // Front = most recently used
+    std::unordered_map<PathCacheKey, EntryList::iterator, KeyHash> index_;
+    // Routes grouped by destination for partial reuse (start cell ignored)
+    std::unordered_map<PathCacheKey, std::vector<EntryList::iterator>, KeyHash> byGoal_;
+    std::uint32_t gridVersion_;
+    Stats stats_;
+
+    static PathCacheKey goalKey(const PathCacheKey& key);
+    void syncVersion(const NavGrid& grid);
+    void evictOldest();
+    bool reachesNextTurn(const NavGrid& grid, const Entry& entry, std::size_t fromCell) const;
+    void buildResult(const Entry& entry, std::size_t fromCell, const sf::Vector2f& start,
+                     const sf::Vector2f& goal, PathfindingResult& result) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_PATHCACHE_H
@@ -0,0 +1,189 @@
+#include "PathRequestQueue.h"
+#include "NavGrid.h"
+#include "PathCache.h"
+#include <algorithm>
+#include <chrono>
+
+namespace ai {
+
+PathRequestQueue::PathRequestQueue(const PathRequestQueueConfig& config)
+    : config_(config)
+    , navGrid_(nullptr)
+    , pathCache_(nullptr)
+    , nextId_(1)
+    , activeId_(kInvalidPathRequest)
+    , activeGridVersion_(0)
+{
+}
+
+PathRequestId PathRequestQueue::submit(const sf::Vector2f& start, const sf::Vector2f& goal,
+                                       Priority priority, const PathfindingConfig& config) {
+    PathRequestId id = nextId_++;
+    if (nextId_ == kInvalidPathRequest) nextId_ = 1;
+
+    Request request{id, start, goal, priority, config, PathRequestStatus::Pending, PathfindingResult{}};
+    stats_.submitted++;
+
+    if (pathCache_ && navGrid_ && !navGrid_->empty()) {
+        PathCacheKey key = PathCache::makeKey(*navGrid_, start, goal, config);
+        if (pathCache_->lookup(*navGrid_, key, start, goal, request.result)) {
+            // Served without a search, collectable on the next poll()
+            request.status = PathRequestStatus::Ready;
+            requests_.emplace(id, std::move(request));
+            stats_.completed++;
+            stats_.cacheHits++;
+            return id;
+        }
+    }
+
+    requests_.emplace(id, std::move(request));
+    stats_.pending++;
+    return id;
+}
+
+void PathRequestQueue::cancel(PathRequestId id) {
+    auto it = requests_.find(id);
+    if (it == requests_.end()) return;
+
+    if (it->second.status == PathRequestStatus::Pending || it->second.status == PathRequestStatus::InProgress) {
+        stats_.cancelled++;
+        stats_.pending = std::max(0, stats_.pending - 1);
+    }
+    if (id == activeId_) {
+        search_.reset();
+        activeId_ = kInvalidPathRequest;
+    }
+    requests_.erase(it);
+}
+
+void PathRequestQueue::clear() {
+    requests_.clear();
+    search_.reset();
+    activeId_ = kInvalidPathRequest;
+    stats_.pending = 0;
+}
+
+PathRequestStatus PathRequestQueue::status(PathRequestId id) const {
+    auto it = requests_.find(id);
+    return it != requests_.end() ? it->second.status : PathRequestStatus::Invalid;
+}
+
+PathRequestStatus PathRequestQueue::poll(PathRequestId id, PathfindingResult& result) {
+    auto it = requests_.find(id);
+    if (it == requests_.end()) return PathRequestStatus::Invalid;
+
+    PathRequestStatus status = it->second.status;
+    if (status == PathRequestStatus::Ready || status == PathRequestStatus::Failed) {
+        result = std::move(it->second.result);
+        requests_.erase(it);
+    }
+    return status;
+}
+
+void PathRequestQueue::process() {
+    using clock = std::chrono::steady_clock;
+    auto frameStart = clock::now();
+    stats_.expansionsLastFrame = 0;
+
+    if (!navGrid_ || navGrid_->empty()) {
+        // Nothing to search against: fail everything still waiting
+        for (auto& pair : requests_) {
+            Request& request = pair.second;
+            if (request.status == PathRequestStatus::Pending || request.status == PathRequestStatus::InProgress) {
+                request.status = PathRequestStatus::Failed;
+                stats_.failed++;
+            }
+        }
+        search_.reset();
+        activeId_ = kInvalidPathRequest;
+        stats_.pending = 0;
+        stats_.lastFrameMicroseconds = 0.0f;
+        return;
+    }
+
+    while (true) {
+        if (activeId_ == kInvalidPathRequest) {
+            activeId_ = pickNextRequest();
+            if (activeId_ == kInvalidPathRequest) break;
+            startRequest(requests_.at(activeId_));
+        } else if (navGrid_->version() != activeGridVersion_) {
+            // Occupancy changed under the running search: restart on the new snapshot
+            startRequest(requests_.at(activeId_));
+        }
+
+        int slice = std::max(1, config_.expansionsPerSlice);
+        if (config_.maxExpansionsPerFrame > 0) {
+            slice = std::max(1, std::min(slice, config_.maxExpansionsPerFrame - stats_.expansionsLastFrame));
+        }
+
+        int before = search_.expansions();
+        search_.step(slice);
+        stats_.expansionsLastFrame += search_.expansions() - before;
+
+        if (search_.finished()) {
+            finishActive();
+        }
+
+        if (config_.maxExpansionsPerFrame > 0 && stats_.expansionsLastFrame >= config_.maxExpansionsPerFrame) {
+            break;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - frameStart);
+        if (elapsed.count() >= config_.frameBudgetMicroseconds) {
+            break;
+        }
+    }
+
+    auto frameEnd = clock::now();
+    stats_.lastFrameMicroseconds = static_cast<float>(
+        std::chrono::duration_cast<std::chrono::microseconds>(frameEnd - frameStart).count());
+}
+
+void PathRequestQueue::resetStats() {
+    int pending = stats_.pending;
+    stats_ = Stats{};
+    stats_.pending = pending;
+}
+
+PathRequestId PathRequestQueue::pickNextRequest() const {
+    // Highest priority first, oldest request first within a priority level
+    const Request* best = nullptr;
+    for (const auto& pair : requests_) {
+        const Request& request = pair.second;
+        if (request.status != PathRequestStatus::Pending) continue;
+
+        if (!best || request.priority > best->priority ||
+            (request.priority == best->priority && request.id < best->id)) {
+            best = &request;
+        }
+    }
+    return best ? best->id : kInvalidPathRequest;
+}
+
+void PathRequestQueue::startRequest(Request& request) {
+    search_.begin(*navGrid_, request.start, request.goal, request.config);
+    request.status = PathRequestStatus::InProgress;
+    activeGridVersion_ = navGrid_->version();
+}
+
+void PathRequestQueue::finishActive() {
+    auto it = requests_.find(activeId_);
+    activeId_ = kInvalidPathRequest;
+    if (it == requests_.end()) return;
+
+    Request& request = it->second;
+    if (search_.status() == GridPathSearch::Status::Found) {
+        request.status = PathRequestStatus::Ready;
+        stats_.completed++;
+        if (pathCache_) {
+            pathCache_->store(*navGrid_, PathCache::makeKey(*navGrid_, request.start, request.goal, request.config),
+                              search_.pathCells());
+        }
+    } else {
+        request.status = PathRequestStatus::Failed;
+        stats_.failed++;
+    }
+    request.result = search_.takeResult();
+    stats_.pending = std::max(0, stats_.pending - 1);
+}
+
+} // namespace ai
@@ -0,0 +1,107 @@
+#ifndef ABYSSAL_STATION_SRC_AI_PATHREQUESTQUEUE_H
+#define ABYSSAL_STATION_SRC_AI_PATHREQUESTQUEUE_H
+
+#include "AIState.h"
+#include "Pathfinding.h"
+#include <SFML/System/Vector2.hpp>
+#include <unordered_map>
+#include <cstdint>
+
+namespace ai {
+
+class NavGrid;
+class PathCache;
+
+using PathRequestId = std::uint32_t;
+constexpr PathRequestId kInvalidPathRequest = 0;
+
+enum class PathRequestStatus {
+    Invalid,    // Unknown id (never submitted, cancelled or already collected)
+    Pending,    // Waiting for its turn
+    InProgress, // Search started, continues next frame
+    Ready,      // Path found, collect with poll()
+    Failed      // No path, collect with poll()
+};
+
+// Configuration for the time-sliced path queue
+struct PathRequestQueueConfig {
+    int frameBudgetMicroseconds = 1000;  // Search time allowed per process() call
+    int expansionsPerSlice = 64;         // Expansions between budget checks
+    int maxExpansionsPerFrame = 0;       // Hard cap per frame, 0 = time budget only
+};
+
+// Queue of path searches run against a NavGrid snapshot. Searches are
+// time-sliced on the main thread: process() advances the highest priority
+// request until the frame budget is spent and resumes it on the next call.
+class PathRequestQueue {
+public:
+    explicit PathRequestQueue(const PathRequestQueueConfig& config = PathRequestQueueConfig{});
+
+    void setNavGrid(const NavGrid* navGrid) { navGrid_ = navGrid; }
+    const NavGrid* getNavGrid() const { return navGrid_; }
+
+    // Optional route cache: hits complete on submit, found routes are stored (not owned)
+    void setPathCache(PathCache* pathCache) { pathCache_ = pathCache; }
+    PathCache* getPathCache() const { return pathCache_; }
+
+    // Request management
+    PathRequestId submit(const sf::Vector2f& start, const sf::Vector2f& goal,
+                         Priority priority, const PathfindingConfig& config);
+    void cancel(PathRequestId id);
+    void clear();
+    PathRequestStatus status(PathRequestId id) const;
+
+    // Collect a finished request. Ready/Failed results are moved into `result`
+    // and the request is released; other states leave it queued.
+    PathRequestStatus poll(PathRequestId id, PathfindingResult& result);
+
+    // Advance searches within the frame budget
+    void process();
+
+    // Configuration
+    void setConfig(const PathRequestQueueConfig& config) { config_ = config; }
+    const PathRequestQueueConfig& getConfig() const { return config_; }
+
+    // Statistics
+    struct Stats {
+        int submitted = 0;
+        int completed = 0;
+        int failed = 0;
+        int cancelled = 0;
+        int cacheHits = 0;
+        int pending = 0;
+        int expansionsLastFrame = 0;
+        float lastFrameMicroseconds = 0.0f;
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats();
+
+private:
+    struct Request {
+        PathRequestId id;
+        sf::Vector2f start;
+        sf::Vector2f goal;
+        Priority priority;
+        PathfindingConfig config;
+        PathRequestStatus status;
+        PathfindingResult result;
+    };
+
+    PathRequestQueueConfig config_;
+    const NavGrid* navGrid_;
+    PathCache* pathCache_;
+    std::unordered_map<PathRequestId, Request> requests_;
+    PathRequestId nextId_;
+    PathRequestId activeId_;
+    std::uint32_t activeGridVersion_;
+    GridPathSearch search_;
+    Stats stats_;
+
+    PathRequestId pickNextRequest() const;
+    void startRequest(Request& request);
+    void finishActive();
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_PATHREQUESTQUEUE_H
@@ -1,10 +1,13 @@
 #include "Pathfinding.h"
+#include "NavGrid.h"
+#include "PathCache.h"
 #include "collisions/CollisionManager.h"
 #include "entities/Entity.h"
 #include "core/Logger.h"
 #include <cmath>
 #include <algorithm>
 #include <unordered_set>
+#include <limits>
 
 namespace ai {
 
@@ -125,6 +128,40 @@ PathfindingResult PathfindingSystem::findPath(
     return result;
 }
 
+PathfindingResult PathfindingSystem::findPath(
+    const sf::Vector2f& start,
+    const sf::Vector2f& goal,
+    const NavGrid& navGrid
+) {
+    return findPath(start, goal, navGrid, config_);
+}
+
+PathfindingResult PathfindingSystem::findPath(
+    const sf::Vector2f& start,
+    const sf::Vector2f& goal,
+    const NavGrid& navGrid,
+    const PathfindingConfig& config
+) {
+    PathCacheKey cacheKey;
+    if (pathCache_) {
+        cacheKey = PathCache::makeKey(navGrid, start, goal, config);
+        PathfindingResult cached;
+        if (pathCache_->lookup(navGrid, cacheKey, start, goal, cached)) {
+            return cached;
+        }
+    }
+
+    gridSearch_.begin(navGrid, start, goal, config);
+    while (!gridSearch_.finished()) {
+        gridSearch_.step(std::max(1, config.maxIterations));
+    }
+
+    if (pathCache_ && gridSearch_.status() == GridPathSearch::Status::Found) {
+        pathCache_->store(navGrid, cacheKey, gridSearch_.pathCells());
+    }
+    return gridSearch_.takeResult();
+}
+
 std::vector<sf::Vector2f> PathfindingSystem::findSimplePath(
     const sf::Vector2f& start,
     const sf::Vector2f& goal,
@@ -262,8 +299,10 @@ bool PathfindingSystem::isWalkable(const sf::Vector2f& position, collisions::Col
     
     // Check if there's a collider at this position
     sf::FloatRect testBounds;
-    testBounds.position = position - sf::Vector2f(config_.gridSize * 0.5f, config_.gridSize * 0.5f);
-    testBounds.size = sf::Vector2f(config_.gridSize, config_.gridSize);
+    // Sized to the agent when known, otherwise to a full grid cell
+    float extent = config_.agentRadius > 0.0f ? config_.agentRadius * 2.0f : config_.gridSize;
+    testBounds.position = position - sf::Vector2f(extent * 0.5f, extent * 0.5f);
+    testBounds.size = sf::Vector2f(extent, extent);
     
     auto blocker = cm->firstColliderForBounds(testBounds, entity, config_.obstacleLayerMask);
     return blocker == nullptr;
@@ -282,4 +321,237 @@ std::vector<sf::Vector2f> PathfindingSystem::reconstructPath(PathNode* goalNode)
     return path;
 }
 
+// GridPathSearch implementation
+void GridPathSearch::begin(const NavGrid& grid, const sf::Vector2f& start, const sf::Vector2f& goal,
+                           const PathfindingConfig& config) {
+    grid_ = &grid;
+    config_ = config;
+    start_ = start;
+    goal_ = goal;
+    expansions_ = 0;
+    result_ = PathfindingResult{};
+    pathCells_.clear();
+    open_.clear();
+
+    std::size_t cellCount = static_cast<std::size_t>(grid.cellCount());
+    if (gCost_.size() != cellCount) {
+        gCost_.assign(cellCount, 0.0f);
+        parent_.assign(cellCount, -1);
+        visitStamp_.assign(cellCount, 0);
+        closedStamp_.assign(cellCount, 0);
+        stamp_ = 0;
+    }
+    if (++stamp_ == 0) {
+        // Stamp wrapped around, stale records would look valid again
+        std::fill(visitStamp_.begin(), visitStamp_.end(), 0);
+        std::fill(closedStamp_.begin(), closedStamp_.end(), 0);
+        stamp_ = 1;
+    }
+
+    sf::Vector2i startPos = grid.worldToCell(start);
+    sf::Vector2i goalPos = grid.worldToCell(goal);
+    if (!grid.inBounds(startPos.x, startPos.y) || !grid.inBounds(goalPos.x, goalPos.y)) {
+        status_ = Status::Failed;
+        return;
+    }
+
+    startCell_ = grid.index(startPos.x, startPos.y);
+    goalCell_ = grid.isBlocked(goalPos.x, goalPos.y)
+        ? nearestOpenCell(grid.index(goalPos.x, goalPos.y))
+        : grid.index(goalPos.x, goalPos.y);
+    if (goalCell_ < 0) {
+        status_ = Status::Failed;
+        return;
+    }
+
+    gCost_[startCell_] = 0.0f;
+    parent_[startCell_] = -1;
+    visitStamp_[startCell_] = stamp_;
+    open_.push_back({heuristic(startCell_, goalCell_), startCell_});
+    status_ = Status::Running;
+}
+
+GridPathSearch::Status GridPathSearch::step(int maxExpansions) {
+    if (status_ != Status::Running) return status_;
+
+    static const int kOffsets[8][2] = {
+        {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    };
+    const int neighborCount = config_.allowDiagonal ? 8 : 4;
+    const float straightCost = grid_->cellSize();
+    const float diagonalCost = grid_->cellSize() * config_.diagonalCost;
+
+    for (int i = 0; i < maxExpansions; ++i) {
+        if (open_.empty() || expansions_ >= config_.maxIterations) {
+            status_ = Status::Failed;
+            result_.iterations = expansions_;
+            return status_;
+        }
+
+        std::pop_heap(open_.begin(), open_.end(), OpenCompare{});
+        OpenEntry current = open_.back();
+        open_.pop_back();
+
+        if (closedStamp_[current.cell] == stamp_) continue;
+        closedStamp_[current.cell] = stamp_;
+        ++expansions_;
+
+        if (config_.anyAngle) {
+            resolveParent(current.cell);
+        }
+
+        if (current.cell == goalCell_) {
+            buildResult(current.cell);
+            status_ = Status::Found;
+            return status_;
+        }
+
+        sf::Vector2i pos = grid_->cellFromIndex(current.cell);
+        for (int n = 0; n < neighborCount; ++n) {
+            int nx = pos.x + kOffsets[n][0];
+            int ny = pos.y + kOffsets[n][1];
+            if (!canEnter(nx, ny)) continue;
+
+            bool diagonal = n >= 4;
+            // Do not cut corners around blocked cells
+            if (diagonal && (grid_->isBlocked(pos.x + kOffsets[n][0], pos.y) ||
+                             grid_->isBlocked(pos.x, pos.y + kOffsets[n][1]))) {
+                continue;
+            }
+
+            int neighbor = grid_->index(nx, ny);
+            if (closedStamp_[neighbor] == stamp_) continue;
+
+            // Lazy Theta*: assume the neighbour sees our parent, verified when it is expanded
+            int from = current.cell;
+            float tentativeG = gCost_[current.cell] + (diagonal ? diagonalCost : straightCost);
+            if (config_.anyAngle && parent_[current.cell] != -1) {
+                from = parent_[current.cell];
+                tentativeG = gCost_[from] + distance(from, neighbor);
+            }
+            if (visitStamp_[neighbor] != stamp_ || tentativeG < gCost_[neighbor]) {
+                visitStamp_[neighbor] = stamp_;
+                gCost_[neighbor] = tentativeG;
+                parent_[neighbor] = from;
+                open_.push_back({tentativeG + heuristic(neighbor, goalCell_), neighbor});
+                std::push_heap(open_.begin(), open_.end(), OpenCompare{});
+            }
+        }
+    }
+
+    return status_;
+}
+
+void GridPathSearch::reset() {
+    grid_ = nullptr;
+    open_.clear();
+    status_ = Status::Idle;
+    expansions_ = 0;
+    result_ = PathfindingResult{};
+}
+
+float GridPathSearch::heuristic(int cellA, int cellB) const {
+    // Straight-line distance stays admissible once paths may take any angle
+    if (config_.anyAngle) return distance(cellA, cellB);
+
+    sf::Vector2i a = grid_->cellFromIndex(cellA);
+    sf::Vector2i b = grid_->cellFromIndex(cellB);
+    float dx = static_cast<float>(std::abs(a.x - b.x));
+    float dy = static_cast<float>(std::abs(a.y - b.y));
+
+    if (config_.allowDiagonal) {
+        return (std::max(dx, dy) + (config_.diagonalCost - 1.0f) * std::min(dx, dy)) * grid_->cellSize();
+    }
+    return (dx + dy) * grid_->cellSize();
+}
+
+float GridPathSearch::distance(int cellA, int cellB) const {
+    sf::Vector2i a = grid_->cellFromIndex(cellA);
+    sf::Vector2i b = grid_->cellFromIndex(cellB);
+    float dx = static_cast<float>(a.x - b.x);
+    float dy = static_cast<float>(a.y - b.y);
+    return std::sqrt(dx * dx + dy * dy) * grid_->cellSize();
+}
+
+bool GridPathSearch::canEnter(int x, int y) const {
+    if (grid_->isBlocked(x, y)) return false;
+    // Too narrow for this agent; the goal cell itself is always enterable
+    return config_.agentRadius <= 0.0f || grid_->index(x, y) == goalCell_ ||
+           grid_->clearance(x, y) >= config_.agentRadius;
+}
+
+void GridPathSearch::resolveParent(int cell) {
+    int parent = parent_[cell];
+    if (parent == -1) return;
+    if (grid_->hasLineOfSight(grid_->cellFromIndex(parent), grid_->cellFromIndex(cell), config_.agentRadius)) return;
+
+    // No line of sight: fall back to the best already-expanded grid neighbour
+    static const int kOffsets[8][2] = {
+        {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    };
+    const int neighborCount = config_.allowDiagonal ? 8 : 4;
+    sf::Vector2i pos = grid_->cellFromIndex(cell);
+    float bestCost = std::numeric_limits<float>::max();
+    int bestParent = -1;
+    for (int n = 0; n < neighborCount; ++n) {
+        int nx = pos.x + kOffsets[n][0];
+        int ny = pos.y + kOffsets[n][1];
+        if (!grid_->inBounds(nx, ny)) continue;
+        int neighbor = grid_->index(nx, ny);
+        if (closedStamp_[neighbor] != stamp_) continue;
+        if (n >= 4 && (grid_->isBlocked(nx, pos.y) || grid_->isBlocked(pos.x, ny))) continue;
+
+        float cost = gCost_[neighbor] + distance(neighbor, cell);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestParent = neighbor;
+        }
+    }
+    if (bestParent != -1) {
+        parent_[cell] = bestParent;
+        gCost_[cell] = bestCost;
+    }
+}
+
+int GridPathSearch::nearestOpenCell(int cell) const {
+    // Targets standing against a wall often map onto a blocked cell; use the closest free neighbour
+    sf::Vector2i pos = grid_->cellFromIndex(cell);
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (!grid_->isBlocked(pos.x + dx, pos.y + dy)) {
+                return grid_->index(pos.x + dx, pos.y + dy);
+            }
+        }
+    }
+    return -1;
+}
+
+void GridPathSearch::buildResult(int goalCell) {
+    std::vector<int>& cells = pathCells_;
+    cells.clear();
+    for (int cell = goalCell; cell != -1; cell = parent_[cell]) {
+        cells.push_back(cell);
+    }
+    std::reverse(cells.begin(), cells.end());
+
+    result_.path.clear();
+    result_.path.push_back(start_);
+    // Keep only the cells where the direction changes
+    for (std::size_t i = 1; i + 1 < cells.size(); ++i) {
+        sf::Vector2i prev = grid_->cellFromIndex(cells[i - 1]);
+        sf::Vector2i curr = grid_->cellFromIndex(cells[i]);
+        sf::Vector2i next = grid_->cellFromIndex(cells[i + 1]);
+        if (curr - prev != next - curr) {
+            result_.path.push_back(grid_->cellToWorld(curr.x, curr.y));
+        }
+    }
+    result_.path.push_back(goal_);
+
+    result_.success = true;
+    result_.totalCost = gCost_[goalCell];
+    result_.iterations = expansions_;
+}
+
 } // namespace ai
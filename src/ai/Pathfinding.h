@@ -6,12 +6,16 @@
 #include <queue>
 #include <unordered_map>
 #include <functional>
+#include <cstdint>
 
 namespace collisions { class CollisionManager; }
 namespace entities { class Entity; }
 
 namespace ai {
 
+class NavGrid;
+class PathCache;
+
 // A* pathfinding node
 struct PathNode {
     sf::Vector2f position;
@@ -32,6 +36,8 @@ struct PathfindingConfig {
     bool allowDiagonal = true;       // Allow diagonal movement
     float diagonalCost = 1.414f;     // Cost multiplier for diagonal moves
     std::uint32_t obstacleLayerMask = 0xFFFFFFFF; // What layers are considered obstacles
+    float agentRadius = 0.0f;        // Requester radius: NavGrid clearance test and cache size class
+    bool anyAngle = true;            // NavGrid searches: Lazy Theta* any-angle paths, no post-smoothing
 };
 
 // Result of a pathfinding operation
@@ -40,8 +46,65 @@ struct PathfindingResult {
     bool success;
     float totalCost;
     int iterations;
+    bool fromCache;
     
-    PathfindingResult() : success(false), totalCost(0.0f), iterations(0) {}
+    PathfindingResult() : success(false), totalCost(0.0f), iterations(0), fromCache(false) {}
+};
+
+// Resumable A* over a NavGrid. The search can be advanced a few expansions at a
+// time so long queries are spread across frames (see PathRequestQueue).
+class GridPathSearch {
+public:
+    enum class Status { Idle, Running, Found, Failed };
+
+    void begin(const NavGrid& grid, const sf::Vector2f& start, const sf::Vector2f& goal,
+               const PathfindingConfig& config);
+    Status step(int maxExpansions);
+    void reset();
+
+    Status status() const { return status_; }
+    bool finished() const { return status_ == Status::Found || status_ == Status::Failed; }
+    int expansions() const { return expansions_; }
+    const PathfindingResult& result() const { return result_; }
+    PathfindingResult takeResult() { return std::move(result_); }
+    // Cell route of the last Found search, start cell to goal cell (dense for
+    // grid moves, path vertices only in any-angle mode)
+    const std::vector<int>& pathCells() const { return pathCells_; }
+
+private:
+    struct OpenEntry {
+        float fCost;
+        int cell;
+    };
+    struct OpenCompare {
+        bool operator()(const OpenEntry& a, const OpenEntry& b) const { return a.fCost > b.fCost; }
+    };
+
+    const NavGrid* grid_ = nullptr;
+    PathfindingConfig config_;
+    sf::Vector2f start_;
+    sf::Vector2f goal_;
+    int startCell_ = -1;
+    int goalCell_ = -1;
+    Status status_ = Status::Idle;
+    int expansions_ = 0;
+    PathfindingResult result_;
+    std::vector<int> pathCells_;
+
+    // Dense per-cell records, invalidated by bumping stamp_ instead of clearing
+    std::vector<OpenEntry> open_;
+    std::vector<float> gCost_;
+    std::vector<int> parent_;
+    std::vector<std::uint32_t> visitStamp_;
+    std::vector<std::uint32_t> closedStamp_;
+    std::uint32_t stamp_ = 0;
+
+    float heuristic(int cellA, int cellB) const;
+    float distance(int cellA, int cellB) const;
+    int nearestOpenCell(int cell) const;
+    bool canEnter(int x, int y) const;
+    void resolveParent(int cell);
+    void buildResult(int goalCell);
 };
 
 // A* pathfinding system
@@ -57,6 +120,20 @@ public:
         entities::Entity* pathEntity = nullptr
     );
     
+    // Find path against a prebuilt occupancy grid (no collider queries per node)
+    PathfindingResult findPath(
+        const sf::Vector2f& start,
+        const sf::Vector2f& goal,
+        const NavGrid& navGrid
+    );
+    // Same, with per-query settings (agent radius, any-angle) instead of the stored config
+    PathfindingResult findPath(
+        const sf::Vector2f& start,
+        const sf::Vector2f& goal,
+        const NavGrid& navGrid,
+        const PathfindingConfig& config
+    );
+    
     // Simplified pathfinding for basic movement (direct line with obstacle avoidance)
     std::vector<sf::Vector2f> findSimplePath(
         const sf::Vector2f& start,
@@ -84,12 +161,18 @@ public:
     void setConfig(const PathfindingConfig& config) { config_ = config; }
     const PathfindingConfig& getConfig() const { return config_; }
     
+    // Optional route cache consulted by the NavGrid overload (not owned)
+    void setPathCache(PathCache* pathCache) { pathCache_ = pathCache; }
+    PathCache* getPathCache() const { return pathCache_; }
+    
     // Grid utilities
     sf::Vector2f worldToGrid(const sf::Vector2f& worldPos) const;
     sf::Vector2f gridToWorld(const sf::Vector2f& gridPos) const;
     
 private:
     PathfindingConfig config_;
+    GridPathSearch gridSearch_;
+    PathCache* pathCache_ = nullptr;
     
     // Hash function for Vector2f to use in unordered_map
     struct Vector2fHash {
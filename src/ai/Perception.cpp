@@ -1,11 +1,12 @@
 #include "Perception.h"
+#include "VisibilityTable.h"
+#include "SoundPropagation.h"
 #include "entities/Entity.h"
 #include "entities/EntityManager.h"
 #include "collisions/CollisionManager.h"
 #include "core/Logger.h"
 #include <cmath>
 #include <algorithm>
-#include <map>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -15,6 +16,10 @@ namespace ai {
 
 PerceptionSystem::PerceptionSystem(const PerceptionConfig& config) : config_(config) {}
 
+PerceptionSystem::~PerceptionSystem() {
+    if (memory_) memory_->release(memoryHandle_);
+}
+
 std::vector<PerceptionEvent> PerceptionSystem::updatePerception(
     entities::Entity* observer,
     const sf::Vector2f& observerPosition,
@@ -24,25 +29,39 @@ std::vector<PerceptionEvent> PerceptionSystem::updatePerception(
     float deltaTime
 ) {
     std::vector<PerceptionEvent> events;
-    
+    updatePerception(observer, observerPosition, facingDirection, entityManager, collisionManager, deltaTime, events);
+    return events;
+}
+
+void PerceptionSystem::updatePerception(
+    entities::Entity* observer,
+    const sf::Vector2f& observerPosition,
+    const sf::Vector2f& facingDirection,
+    entities::EntityManager* entityManager,
+    collisions::CollisionManager* collisionManager,
+    float currentTime,
+    std::vector<PerceptionEvent>& events
+) {
+    events.clear();
     if (!observer || !entityManager) {
-        return events;
+        return;
     }
     
-    // Get nearby entities for performance
-    auto nearbyEntities = getNearbyEntities(
+    // Candidates from the entity position grid (already radius-filtered)
+    getNearbyEntities(
         observerPosition, 
         std::max({config_.sightRange, config_.hearingRange, config_.proximityRange}),
         entityManager,
+        nearbyScratch_,
         observer
     );
     
-    for (auto* entity : nearbyEntities) {
+    for (auto* entity : nearbyScratch_) {
         if (!entity || entity == observer) continue;
         
         sf::Vector2f targetPos = entity->position();
-        float distance = std::sqrt(std::pow(targetPos.x - observerPosition.x, 2) + 
-                                 std::pow(targetPos.y - observerPosition.y, 2));
+        sf::Vector2f delta = targetPos - observerPosition;
+        float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
         
         // Check sight perception
         if (distance <= config_.sightRange && canSee(observerPosition, facingDirection, targetPos, collisionManager, observer)) {
@@ -50,7 +69,7 @@ std::vector<PerceptionEvent> PerceptionSystem::updatePerception(
             events.emplace_back(PerceptionType::SIGHT, entity, targetPos, intensity);
             
             // Update memory when we see something
-            addMemory(observer, targetPos, deltaTime);
+            remember(events.back(), currentTime);
         }
         
         // Check hearing perception
@@ -66,22 +85,40 @@ std::vector<PerceptionEvent> PerceptionSystem::updatePerception(
         }
     }
     
+    // Emitted sounds, propagated around walls
+    appendSoundEvents(observer, observerPosition, events);
+    
     // Check memory-based perception
-    if (hasValidMemory(observer, deltaTime)) {
-        sf::Vector2f memoryPos = getLastKnownPosition(observer, deltaTime);
-        events.emplace_back(PerceptionType::MEMORY, nullptr, memoryPos, 0.5f, deltaTime, config_.memoryDuration);
+    appendMemoryEvent(observer, events, currentTime);
+}
+
+void PerceptionSystem::appendSoundEvents(entities::Entity* observer, const sf::Vector2f& observerPosition,
+                                         std::vector<PerceptionEvent>& events) {
+    if (!soundPropagation_ || soundPropagation_->activeFields() == 0) return;
+    soundScratch_.clear();
+    soundPropagation_->sampleAll(observerPosition, soundScratch_, observer);
+    for (const auto& sample : soundScratch_) {
+        events.emplace_back(PerceptionType::HEARING, sample.source, sample.origin, std::min(sample.intensity, 1.0f));
+    }
+}
+
+void PerceptionSystem::appendMemoryEvent(entities::Entity* observer, std::vector<PerceptionEvent>& events,
+                                         float currentTime) const {
+    if (!memory_) return;
+    // Source stays null: a memory is a place to check, not a live target
+    const PerceptionMemory::Record* record = memory_->freshest(memoryHandle_, PerceptionType::SIGHT, currentTime);
+    if (record) {
+        events.emplace_back(PerceptionType::MEMORY, nullptr, record->position,
+                            PerceptionMemory::confidence(*record, currentTime), record->timestamp, record->lifetime);
     }
-    
-    return events;
 }
 
 bool PerceptionSystem::canSee(const sf::Vector2f& observerPos, const sf::Vector2f& observerFacing,
                              const sf::Vector2f& targetPos, collisions::CollisionManager* cm,
                              entities::Entity* excludeEntity) const {
     // Check distance first for performance and correctness
-    float distance = std::sqrt(std::pow(targetPos.x - observerPos.x, 2) + 
-                              std::pow(targetPos.y - observerPos.y, 2));
-    if (distance > config_.sightRange) {
+    sf::Vector2f delta = targetPos - observerPos;
+    if (delta.x * delta.x + delta.y * delta.y > config_.sightRange * config_.sightRange) {
         return false;
     }
     
@@ -92,6 +129,9 @@ bool PerceptionSystem::canSee(const sf::Vector2f& observerPos, const sf::Vector2
     
     // Check line of sight if collision manager is available
     if (cm && config_.requiresLOS) {
+        if (visibilityTable_) {
+            return visibilityTable_->hasLineOfSight(observerPos, targetPos, cm, excludeEntity, config_.sightLayerMask);
+        }
         return !cm->segmentIntersectsAny(observerPos, targetPos, excludeEntity, config_.sightLayerMask);
     }
     
@@ -99,40 +139,62 @@ bool PerceptionSystem::canSee(const sf::Vector2f& observerPos, const sf::Vector2
 }
 
 bool PerceptionSystem::canHear(const sf::Vector2f& observerPos, const sf::Vector2f& soundPos) const {
-    float distance = std::sqrt(std::pow(soundPos.x - observerPos.x, 2) + 
-                              std::pow(soundPos.y - observerPos.y, 2));
-    return distance <= config_.hearingRange;
+    sf::Vector2f delta = soundPos - observerPos;
+    return delta.x * delta.x + delta.y * delta.y <= config_.hearingRange * config_.hearingRange;
 }
 
 bool PerceptionSystem::isInProximity(const sf::Vector2f& observerPos, const sf::Vector2f& targetPos) const {
-    float distance = std::sqrt(std::pow(targetPos.x - observerPos.x, 2) + 
-                              std::pow(targetPos.y - observerPos.y, 2));
-    return distance <= config_.proximityRange;
+    sf::Vector2f delta = targetPos - observerPos;
+    return delta.x * delta.x + delta.y * delta.y <= config_.proximityRange * config_.proximityRange;
+}
+
+void PerceptionSystem::setMemoryStore(PerceptionMemory* store) {
+    if (!store) {
+        if (!ownMemory_) ownMemory_ = std::make_unique<PerceptionMemory>();
+        store = ownMemory_.get();
+    }
+    if (store == memory_) return;
+    
+    // Carry the current records over so rebinding does not forget anything
+    PerceptionMemory::Handle handle = store->allocate();
+    if (memory_) {
+        const PerceptionMemory::Record* records = memory_->records(memoryHandle_);
+        for (std::size_t i = 0, count = memory_->size(memoryHandle_); i < count; ++i) {
+            const auto& r = records[i];
+            store->remember(handle, r.type, r.targetId, r.position, r.intensity, r.timestamp, r.lifetime);
+        }
+        memory_->release(memoryHandle_);
+    }
+    memory_ = store;
+    memoryHandle_ = handle;
+    if (ownMemory_ && store != ownMemory_.get()) ownMemory_.reset();
 }
 
-void PerceptionSystem::addMemory(entities::Entity* observer, const sf::Vector2f& lastKnownPos, float currentTime) {
-    memory_[observer] = {lastKnownPos, currentTime};
+void PerceptionSystem::addMemory(entities::Entity* target, const sf::Vector2f& lastKnownPos, float currentTime) {
+    remember(PerceptionEvent(PerceptionType::SIGHT, target, lastKnownPos, 1.0f, currentTime), currentTime);
 }
 
-sf::Vector2f PerceptionSystem::getLastKnownPosition(entities::Entity* observer, float currentTime) const {
-    auto it = memory_.find(observer);
-    if (it != memory_.end()) {
-        return it->second.first;
-    }
-    return {0.0f, 0.0f};
+void PerceptionSystem::remember(const PerceptionEvent& event, float currentTime) {
+    if (!memory_) setMemoryStore(nullptr);
+    std::uint32_t targetId = event.source ? event.source->id() : 0u;
+    memory_->remember(memoryHandle_, event.type, targetId, event.position, event.intensity,
+                      currentTime, config_.memoryDuration);
 }
 
-bool PerceptionSystem::hasValidMemory(entities::Entity* observer, float currentTime) const {
-    auto it = memory_.find(observer);
-    if (it != memory_.end()) {
-        float elapsed = currentTime - it->second.second;
-        return elapsed <= config_.memoryDuration;
-    }
-    return false;
+sf::Vector2f PerceptionSystem::getLastKnownPosition(entities::Entity* target, float currentTime) const {
+    if (!memory_) return {0.0f, 0.0f};
+    const PerceptionMemory::Record* record = memory_->freshest(memoryHandle_, PerceptionType::SIGHT, currentTime,
+                                                               target ? target->id() : 0u);
+    return record ? record->position : sf::Vector2f(0.0f, 0.0f);
 }
 
-void PerceptionSystem::clearMemory(entities::Entity* observer) {
-    memory_.erase(observer);
+bool PerceptionSystem::hasValidMemory(entities::Entity* target, float currentTime) const {
+    return memory_ && memory_->freshest(memoryHandle_, PerceptionType::SIGHT, currentTime,
+                                        target ? target->id() : 0u) != nullptr;
+}
+
+void PerceptionSystem::clearMemory(entities::Entity* target) {
+    if (memory_) memory_->forget(memoryHandle_, target ? target->id() : 0u);
 }
 
 bool PerceptionSystem::isInSightCone(const sf::Vector2f& observerPos, const sf::Vector2f& facingDir,
@@ -154,42 +216,27 @@ float PerceptionSystem::calculateAngleBetween(const sf::Vector2f& a, const sf::V
     return std::acos(cosAngle);
 }
 
-std::vector<entities::Entity*> PerceptionSystem::getNearbyEntities(
+void PerceptionSystem::getNearbyEntities(
     const sf::Vector2f& position, float radius,
     entities::EntityManager* entityManager,
+    std::vector<entities::Entity*>& out,
     entities::Entity* exclude
 ) const {
-    std::vector<entities::Entity*> nearby;
-    
-    if (!entityManager) return nearby;
-    
-    // Get all entities and filter by distance
-    // Note: This is a simple implementation. For better performance,
-    // you might want to use spatial partitioning in EntityManager
-    auto allEntities = entityManager->allEntities();
+    out.clear();
+    if (!entityManager) return;
     
-    for (auto* entity : allEntities) {
-        if (!entity || entity == exclude) continue;
-        
-        sf::Vector2f entityPos = entity->position();
-        float distance = std::sqrt(std::pow(entityPos.x - position.x, 2) + 
-                                 std::pow(entityPos.y - position.y, 2));
-        
-        if (distance <= radius) {
-            nearby.push_back(entity);
-        }
-    }
-    
-    return nearby;
+    entityManager->queryRadius(position, radius, out, exclude);
 }
 
 PerceptionSystem::DebugInfo PerceptionSystem::getDebugInfo(entities::Entity* observer) const {
     DebugInfo info;
     
-    // Add memory position if available
-    auto it = memory_.find(observer);
-    if (it != memory_.end()) {
-        info.memoryPositions.push_back(it->second.first);
+    // Every remembered position, fresh or not
+    if (memory_) {
+        const PerceptionMemory::Record* records = memory_->records(memoryHandle_);
+        for (std::size_t i = 0, count = memory_->size(memoryHandle_); i < count; ++i) {
+            info.memoryPositions.push_back(records[i].position);
+        }
     }
     
     // Additional debug info could be added here for sight rays, hearing circles, etc.
@@ -2,10 +2,11 @@
 #define ABYSSAL_STATION_SRC_AI_PERCEPTION_H
 
 #include "AIState.h"
+#include "PerceptionMemory.h"
+#include "SoundPropagation.h"
 #include <SFML/System/Vector2.hpp>
 #include <vector>
 #include <memory>
-#include <map>
 
 namespace entities { 
     class Entity; 
@@ -15,6 +16,8 @@ namespace collisions { class CollisionManager; }
 
 namespace ai {
 
+class VisibilityTable;
+
 // Data structure for perception events
 struct PerceptionEvent {
     PerceptionType type;
@@ -44,6 +47,9 @@ struct PerceptionConfig {
 class PerceptionSystem {
 public:
     explicit PerceptionSystem(const PerceptionConfig& config = PerceptionConfig{});
+    ~PerceptionSystem();
+    PerceptionSystem(const PerceptionSystem&) = delete;
+    PerceptionSystem& operator=(const PerceptionSystem&) = delete;
     
     // Update perception for an entity, returns list of perception events
     std::vector<PerceptionEvent> updatePerception(
@@ -54,6 +60,16 @@ public:
         collisions::CollisionManager* collisionManager,
         float deltaTime
     );
+    // Same, refilling events in place so its capacity is reused between ticks
+    void updatePerception(
+        entities::Entity* observer,
+        const sf::Vector2f& observerPosition,
+        const sf::Vector2f& facingDirection,
+        entities::EntityManager* entityManager,
+        collisions::CollisionManager* collisionManager,
+        float currentTime,
+        std::vector<PerceptionEvent>& events
+    );
     
     // Check specific perception types
     bool canSee(const sf::Vector2f& observerPos, const sf::Vector2f& observerFacing,
@@ -64,11 +80,31 @@ public:
     
     bool isInProximity(const sf::Vector2f& observerPos, const sf::Vector2f& targetPos) const;
     
-    // Memory management
-    void addMemory(entities::Entity* observer, const sf::Vector2f& lastKnownPos, float currentTime);
-    sf::Vector2f getLastKnownPosition(entities::Entity* observer, float currentTime) const;
-    bool hasValidMemory(entities::Entity* observer, float currentTime) const;
-    void clearMemory(entities::Entity* observer);
+    // Append a MEMORY event at the freshest remembered sighting, if any is still fresh
+    void appendMemoryEvent(entities::Entity* observer, std::vector<PerceptionEvent>& events,
+                           float currentTime) const;
+    
+    // Memory management: records live in a PerceptionMemory ring keyed by target
+    // id and decay over config.memoryDuration. Without a shared store each
+    // system keeps a private one.
+    void addMemory(entities::Entity* target, const sf::Vector2f& lastKnownPos, float currentTime);
+    void remember(const PerceptionEvent& event, float currentTime);
+    sf::Vector2f getLastKnownPosition(entities::Entity* target, float currentTime) const;
+    bool hasValidMemory(entities::Entity* target, float currentTime) const;
+    void clearMemory(entities::Entity* target);
+    
+    // Move this system's records into a shared store (not owned; null = private store)
+    void setMemoryStore(PerceptionMemory* store);
+    const PerceptionMemory* getMemoryStore() const { return memory_; }
+    PerceptionMemory::Handle getMemoryHandle() const { return memoryHandle_; }
+    
+    // Optional baked static visibility consulted before raycasting (not owned)
+    void setVisibilityTable(const VisibilityTable* table) { visibilityTable_ = table; }
+    
+    // Optional sound fields; audible ones are reported as HEARING events (not owned)
+    void setSoundPropagation(const SoundPropagation* sound) { soundPropagation_ = sound; }
+    void appendSoundEvents(entities::Entity* observer, const sf::Vector2f& observerPosition,
+                           std::vector<PerceptionEvent>& events);
     
     // Configuration
     void setConfig(const PerceptionConfig& config) { config_ = config; }
@@ -84,19 +120,28 @@ public:
 
 private:
     PerceptionConfig config_;
+    const VisibilityTable* visibilityTable_ = nullptr;
+    const SoundPropagation* soundPropagation_ = nullptr;
     
-    // Memory storage: observer entity -> {position, timestamp}
-    std::map<entities::Entity*, std::pair<sf::Vector2f, float>> memory_;
+    // Memory ring: a block in a shared store, or in ownMemory_ when unbound
+    PerceptionMemory* memory_ = nullptr;
+    PerceptionMemory::Handle memoryHandle_ = PerceptionMemory::kInvalidHandle;
+    std::unique_ptr<PerceptionMemory> ownMemory_;
     
     // Helper functions
     bool isInSightCone(const sf::Vector2f& observerPos, const sf::Vector2f& facingDir,
                        const sf::Vector2f& targetPos) const;
     float calculateAngleBetween(const sf::Vector2f& a, const sf::Vector2f& b) const;
-    std::vector<entities::Entity*> getNearbyEntities(
+    void getNearbyEntities(
         const sf::Vector2f& position, float radius,
         entities::EntityManager* entityManager,
+        std::vector<entities::Entity*>& out,
         entities::Entity* exclude = nullptr
     ) const;
+    
+    // Reused across updates so neighbor queries and sound sampling do not allocate per frame
+    std::vector<entities::Entity*> nearbyScratch_;
+    std::vector<SoundPropagation::Sample> soundScratch_;
 };
 
 } // namespace ai
@@ -0,0 +1,282 @@
+#include "PerceptionBatch.h"
+#include "AISystem.h"
+#include "VisibilityTable.h"
+#include "SoundPropagation.h"
+#include "entities/Entity.h"
+#include "entities/EntityManager.h"
+#include "collisions/CollisionManager.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace ai {
+
+PerceptionBatch::PerceptionBatch(const PerceptionBatchConfig& config)
+    : config_(config)
+    , visibilityTable_(nullptr)
+    , threadPool_(nullptr)
+    , soundPropagation_(nullptr)
+{
+    config_.eventsPerAgent = std::max<std::size_t>(1, config_.eventsPerAgent);
+}
+
+void PerceptionBatch::run(const std::vector<AIAgent*>& agents,
+                          entities::EntityManager* entityManager,
+                          collisions::CollisionManager* collisionManager) {
+    stats_ = Stats{};
+    pairs_.clear();
+
+    // Rings are reset every run; storage only grows with the agent count
+    std::size_t capacity = config_.eventsPerAgent;
+    if (events_.size() < agents.size() * capacity) {
+        events_.resize(agents.size() * capacity,
+                       PerceptionEvent(PerceptionType::SIGHT, nullptr, sf::Vector2f(0.f, 0.f)));
+    }
+    ringHead_.assign(agents.size(), 0);
+    ringCount_.assign(agents.size(), 0);
+    candidateCount_.assign(agents.size(), 0);
+    observerTime_.assign(agents.size(), 0.0f);
+
+    if (!entityManager) return;
+
+    gatherObservers(agents);
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (queryRadius_[i] < 0.f) continue;
+        ++stats_.observers;
+        auto start = std::chrono::high_resolution_clock::now();
+        testCandidates(static_cast<int>(i), entityManager, collisionManager != nullptr);
+        observerTime_[i] = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    }
+    resolveLineOfSight(collisionManager);
+    writeEvents();
+}
+
+std::size_t PerceptionBatch::eventCount(std::size_t slot) const {
+    return slot < ringCount_.size() ? ringCount_[slot] : 0;
+}
+
+int PerceptionBatch::candidateCount(std::size_t slot) const {
+    return slot < candidateCount_.size() ? candidateCount_[slot] : 0;
+}
+
+float PerceptionBatch::observerTime(std::size_t slot) const {
+    return slot < observerTime_.size() ? observerTime_[slot] : 0.0f;
+}
+
+const PerceptionEvent& PerceptionBatch::event(std::size_t slot, std::size_t index) const {
+    std::size_t capacity = config_.eventsPerAgent;
+    return events_[slot * capacity + (ringHead_[slot] + index) % capacity];
+}
+
+void PerceptionBatch::gatherObservers(const std::vector<AIAgent*>& agents) {
+    std::size_t count = agents.size();
+    observerEntity_.resize(count);
+    observerX_.resize(count);
+    observerY_.resize(count);
+    facingX_.resize(count);
+    facingY_.resize(count);
+    sightRange_.resize(count);
+    cosHalfAngle_.resize(count);
+    hearingRange_.resize(count);
+    proximityRange_.resize(count);
+    queryRadius_.resize(count);
+    sightLayerMask_.resize(count);
+    requiresLOS_.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        AIAgent* agent = agents[i];
+        entities::Entity* entity = agent ? agent->getEntity() : nullptr;
+        observerEntity_[i] = entity;
+        if (!entity || !entity->isActive()) {
+            queryRadius_[i] = -1.f;
+            continue;
+        }
+
+        const PerceptionConfig& perception = agent->getConfig().perception;
+        sf::Vector2f position = agent->getEntityPosition();
+        sf::Vector2f facing = agent->getFacingDirection();
+        float facingLength = std::sqrt(facing.x * facing.x + facing.y * facing.y);
+
+        observerX_[i] = position.x;
+        observerY_[i] = position.y;
+        sightRange_[i] = perception.sightRange;
+        hearingRange_[i] = perception.hearingRange;
+        proximityRange_[i] = perception.proximityRange;
+        queryRadius_[i] = std::max({perception.sightRange, perception.hearingRange, perception.proximityRange});
+        sightLayerMask_[i] = perception.sightLayerMask;
+        requiresLOS_[i] = perception.requiresLOS ? 1 : 0;
+
+        if (facingLength < 0.0001f) {
+            // No facing: the per-agent path treats every direction as inside the cone
+            facingX_[i] = 0.f;
+            facingY_[i] = 0.f;
+            cosHalfAngle_[i] = -2.f;
+        } else {
+            facingX_[i] = facing.x / facingLength;
+            facingY_[i] = facing.y / facingLength;
+            float halfAngle = std::min(perception.sightAngle * 0.5f, 180.0f) * static_cast<float>(M_PI) / 180.0f;
+            cosHalfAngle_[i] = std::cos(halfAngle);
+        }
+    }
+}
+
+void PerceptionBatch::testCandidates(int observer, entities::EntityManager* entityManager, bool lineOfSight) {
+    float ox = observerX_[observer];
+    float oy = observerY_[observer];
+    entityManager->queryRadius({ox, oy}, queryRadius_[observer], candidates_, observerEntity_[observer]);
+
+    std::size_t count = candidates_.size();
+    targetX_.resize(count);
+    targetY_.resize(count);
+    distanceSq_.resize(count);
+    dot_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const sf::Vector2f& position = candidates_[i]->position();
+        targetX_[i] = position.x;
+        targetY_[i] = position.y;
+    }
+    stats_.candidatePairs += static_cast<int>(count);
+    candidateCount_[observer] = static_cast<int>(count);
+
+    // Branch-free arithmetic over the SoA arrays (auto-vectorized)
+    float fx = facingX_[observer];
+    float fy = facingY_[observer];
+    const float* tx = targetX_.data();
+    const float* ty = targetY_.data();
+    float* d2 = distanceSq_.data();
+    float* dot = dot_.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        float dx = tx[i] - ox;
+        float dy = ty[i] - oy;
+        d2[i] = dx * dx + dy * dy;
+        dot[i] = dx * fx + dy * fy;
+    }
+
+    float sightSq = sightRange_[observer] * sightRange_[observer];
+    float hearingSq = hearingRange_[observer] * hearingRange_[observer];
+    float proximitySq = proximityRange_[observer] * proximityRange_[observer];
+    float cosHalf = cosHalfAngle_[observer];
+    bool needsRaycast = lineOfSight && requiresLOS_[observer];
+
+    for (std::size_t i = 0; i < count; ++i) {
+        float distance = std::sqrt(d2[i]);
+        // Cone test without acos: angle <= half-angle  <=>  dot >= cos(half) * |d|
+        bool inCone = d2[i] < 0.00000001f || dot[i] >= cosHalf * distance;
+        bool sight = d2[i] <= sightSq && inCone;
+        bool hearing = d2[i] <= hearingSq;
+        bool proximity = d2[i] <= proximitySq;
+        if (!sight && !hearing && !proximity) continue;
+
+        Pair pair;
+        pair.observer = observer;
+        pair.target = candidates_[i];
+        pair.position = {tx[i], ty[i]};
+        pair.distance = distance;
+        pair.sight = sight ? (needsRaycast ? 2 : 1) : 0;
+        pair.hearing = hearing;
+        pair.proximity = proximity;
+        pairs_.push_back(pair);
+    }
+}
+
+void PerceptionBatch::resolveLineOfSight(collisions::CollisionManager* collisionManager) {
+    if (!collisionManager) return;
+
+    int pending = 0;
+    for (const auto& pair : pairs_) {
+        if (pair.sight == 2) ++pending;
+    }
+    if (pending == 0) return;
+
+    // Pairs only read the world and write themselves, so the pass splits freely
+    auto resolveRange = [this, collisionManager](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (pairs_[i].sight == 2) resolvePair(pairs_[i], collisionManager);
+        }
+    };
+    if (threadPool_) {
+        threadPool_->parallelFor(pairs_.size(), resolveRange, 64);
+    } else {
+        resolveRange(0, pairs_.size());
+    }
+
+    for (auto& pair : pairs_) {
+        if (pair.sight == 3) {
+            ++stats_.tableHidden;
+            pair.sight = 0;
+        }
+    }
+    stats_.raycasts = pending - stats_.tableHidden;
+}
+
+void PerceptionBatch::resolvePair(Pair& pair, const collisions::CollisionManager* collisionManager) const {
+    int o = pair.observer;
+    sf::Vector2f from(observerX_[o], observerY_[o]);
+    if (visibilityTable_) {
+        if (visibilityTable_->query(from, pair.position) == VisibilityTable::Visibility::Hidden &&
+            (sightLayerMask_[o] & visibilityTable_->getConfig().staticLayerMask)) {
+            pair.sight = 3;
+            return;
+        }
+        bool visible = visibilityTable_->hasLineOfSight(from, pair.position, collisionManager,
+                                                        observerEntity_[o], sightLayerMask_[o]);
+        pair.sight = visible ? 1 : 0;
+        return;
+    }
+    bool blocked = collisionManager->segmentIntersectsAny(
+        from, pair.position, observerEntity_[o], sightLayerMask_[o]);
+    pair.sight = blocked ? 0 : 1;
+}
+
+void PerceptionBatch::writeEvents() {
+    // Same per-target order as PerceptionSystem::updatePerception: sight, hearing, proximity
+    for (const auto& pair : pairs_) {
+        std::size_t slot = static_cast<std::size_t>(pair.observer);
+        if (pair.sight == 1) {
+            float intensity = 1.0f - (pair.distance / sightRange_[slot]);
+            pushEvent(slot, PerceptionEvent(PerceptionType::SIGHT, pair.target, pair.position, intensity));
+        }
+        if (pair.hearing) {
+            float intensity = 1.0f - (pair.distance / hearingRange_[slot]);
+            pushEvent(slot, PerceptionEvent(PerceptionType::HEARING, pair.target, pair.position, intensity));
+        }
+        if (pair.proximity) {
+            float intensity = 1.0f - (pair.distance / proximityRange_[slot]);
+            pushEvent(slot, PerceptionEvent(PerceptionType::PROXIMITY, pair.target, pair.position, intensity));
+        }
+    }
+
+    // Sound fields are sampled in O(1) per observer and field
+    if (!soundPropagation_ || soundPropagation_->activeFields() == 0) return;
+    for (std::size_t slot = 0; slot < queryRadius_.size(); ++slot) {
+        if (queryRadius_[slot] < 0.f) continue;
+        soundSamples_.clear();
+        soundPropagation_->sampleAll({observerX_[slot], observerY_[slot]}, soundSamples_, observerEntity_[slot]);
+        for (const auto& sample : soundSamples_) {
+            pushEvent(slot, PerceptionEvent(PerceptionType::HEARING, sample.source, sample.origin,
+                                            std::min(sample.intensity, 1.0f)));
+        }
+    }
+}
+
+void PerceptionBatch::pushEvent(std::size_t slot, const PerceptionEvent& event) {
+    std::size_t capacity = config_.eventsPerAgent;
+    std::size_t& head = ringHead_[slot];
+    std::size_t& count = ringCount_[slot];
+    if (count < capacity) {
+        events_[slot * capacity + (head + count) % capacity] = event;
+        ++count;
+    } else {
+        events_[slot * capacity + head] = event;
+        head = (head + 1) % capacity;
+        ++stats_.droppedEvents;
+    }
+}
+
+} // namespace ai
@@ -0,0 +1,128 @@
+#ifndef ABYSSAL_STATION_SRC_AI_PERCEPTIONBATCH_H
+#define ABYSSAL_STATION_SRC_AI_PERCEPTIONBATCH_H
+
+#include "Perception.h"
+#include "SoundPropagation.h"
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace entities {
+    class Entity;
+    class EntityManager;
+}
+namespace collisions { class CollisionManager; }
+namespace core { class ThreadPool; }
+
+namespace ai {
+
+class AIAgent;
+class VisibilityTable;
+
+// Configuration for the manager-level perception stage
+struct PerceptionBatchConfig {
+    std::size_t eventsPerAgent = 32;   // Ring capacity per agent; oldest events are overwritten
+};
+
+// Perception for every agent in one sweep. Observer data is gathered into
+// SoA arrays, range/cone/proximity tests run as straight-line loops over
+// each observer's candidate targets (cosine threshold instead of acos, squared
+// distances), and pairs that still need line of sight are resolved together in
+// one raycast pass. Results land in a preallocated per-agent event ring that
+// agents consume on their next update.
+class PerceptionBatch {
+public:
+    explicit PerceptionBatch(const PerceptionBatchConfig& config = PerceptionBatchConfig{});
+
+    void run(const std::vector<AIAgent*>& agents,
+             entities::EntityManager* entityManager,
+             collisions::CollisionManager* collisionManager);
+
+    // Events produced for agents[slot] by the last run(), oldest first
+    std::size_t eventCount(std::size_t slot) const;
+    const PerceptionEvent& event(std::size_t slot, std::size_t index) const;
+    // Targets tested for agents[slot] and milliseconds spent testing them (LOS pass excluded)
+    int candidateCount(std::size_t slot) const;
+    float observerTime(std::size_t slot) const;
+
+    // Optional baked static visibility consulted before raycasting (not owned)
+    void setVisibilityTable(const VisibilityTable* table) { visibilityTable_ = table; }
+
+    // Optional sound fields sampled once per observer (not owned)
+    void setSoundPropagation(const SoundPropagation* sound) { soundPropagation_ = sound; }
+
+    // Optional pool for the raycast pass; each pair is resolved independently (not owned)
+    void setThreadPool(core::ThreadPool* pool) { threadPool_ = pool; }
+
+    const PerceptionBatchConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int observers = 0;
+        int candidatePairs = 0;     // Observer x target pairs tested
+        int raycasts = 0;           // Pairs that reached the LOS batch
+        int tableHidden = 0;        // LOS pairs rejected by the visibility table alone
+        int droppedEvents = 0;      // Overwritten because a ring was full
+    };
+    const Stats& getStats() const { return stats_; }
+
+private:
+    // Pair that passed at least one range test, pending LOS for sight
+    struct Pair {
+        int observer;
+        entities::Entity* target;
+        sf::Vector2f position;
+        float distance;
+        std::uint8_t sight;         // 0 = no, 1 = yes, 2 = pending LOS, 3 = hidden by table
+        bool hearing;
+        bool proximity;
+    };
+
+    PerceptionBatchConfig config_;
+    const VisibilityTable* visibilityTable_;
+    core::ThreadPool* threadPool_;
+    const SoundPropagation* soundPropagation_;
+    Stats stats_;
+
+    // Observer SoA (queryRadius_ < 0 marks an agent without an active entity)
+    std::vector<entities::Entity*> observerEntity_;
+    std::vector<float> observerX_;
+    std::vector<float> observerY_;
+    std::vector<float> facingX_;
+    std::vector<float> facingY_;
+    std::vector<float> sightRange_;
+    std::vector<float> cosHalfAngle_;
+    std::vector<float> hearingRange_;
+    std::vector<float> proximityRange_;
+    std::vector<float> queryRadius_;
+    std::vector<std::uint32_t> sightLayerMask_;
+    std::vector<std::uint8_t> requiresLOS_;
+
+    // Candidate target SoA for the observer being processed
+    std::vector<entities::Entity*> candidates_;
+    std::vector<float> targetX_;
+    std::vector<float> targetY_;
+    std::vector<float> distanceSq_;
+    std::vector<float> dot_;
+
+    std::vector<Pair> pairs_;
+    std::vector<SoundPropagation::Sample> soundSamples_;   // Reused across observers and frames
+
+    // Ring storage: slot s owns events_[s * capacity, (s + 1) * capacity)
+    std::vector<PerceptionEvent> events_;
+    std::vector<int> candidateCount_;       // Per slot
+    std::vector<float> observerTime_;
+    std::vector<std::size_t> ringHead_;
+    std::vector<std::size_t> ringCount_;
+
+    void gatherObservers(const std::vector<AIAgent*>& agents);
+    void testCandidates(int observer, entities::EntityManager* entityManager, bool lineOfSight);
+    void resolveLineOfSight(collisions::CollisionManager* collisionManager);
+    void resolvePair(Pair& pair, const collisions::CollisionManager* collisionManager) const;
+    void writeEvents();
+    void pushEvent(std::size_t slot, const PerceptionEvent& event);
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_PERCEPTIONBATCH_H
@@ -0,0 +1,135 @@
+#include "PerceptionMemory.h"
+#include <algorithm>
+#include <limits>
+
+namespace ai {
+
+PerceptionMemory::PerceptionMemory(const PerceptionMemoryConfig& config)
+    : capacity_(std::min<std::size_t>(std::max<std::size_t>(config.slotsPerAgent, 1),
+                                      std::numeric_limits<std::uint16_t>::max()))
+{
+}
+
+PerceptionMemory::Handle PerceptionMemory::allocate() {
+    Handle handle;
+    if (!freeBlocks_.empty()) {
+        handle = freeBlocks_.back();
+        freeBlocks_.pop_back();
+    } else {
+        handle = static_cast<Handle>(blocks_.size());
+        blocks_.emplace_back();
+        records_.resize(blocks_.size() * capacity_);
+    }
+    blocks_[static_cast<std::size_t>(handle)] = Block{0, 0, true, Stats{}};
+    return handle;
+}
+
+void PerceptionMemory::release(Handle handle) {
+    if (!valid(handle)) return;
+    Block& block = blocks_[static_cast<std::size_t>(handle)];
+    block.used = false;
+    releasedStats_.remembered += block.stats.remembered;
+    releasedStats_.refreshed += block.stats.refreshed;
+    releasedStats_.overwritten += block.stats.overwritten;
+    freeBlocks_.push_back(handle);
+}
+
+bool PerceptionMemory::valid(Handle handle) const {
+    return handle >= 0 && static_cast<std::size_t>(handle) < blocks_.size()
+        && blocks_[static_cast<std::size_t>(handle)].used;
+}
+
+void PerceptionMemory::remember(Handle handle, PerceptionType type, std::uint32_t targetId,
+                                const sf::Vector2f& position, float intensity, float time, float lifetime) {
+    if (!valid(handle)) return;
+    Block& block = blocks_[static_cast<std::size_t>(handle)];
+    Record* first = records_.data() + static_cast<std::size_t>(handle) * capacity_;
+
+    Record* slot = nullptr;
+    for (std::size_t i = 0; i < block.count; ++i) {
+        if (first[i].type == type && first[i].targetId == targetId) {
+            slot = first + i;
+            ++block.stats.refreshed;
+            break;
+        }
+    }
+    if (!slot) {
+        if (block.count < capacity_) {
+            slot = first + block.count++;
+        } else {
+            slot = first + block.head;
+            block.head = static_cast<std::uint16_t>((block.head + 1) % capacity_);
+            ++block.stats.overwritten;
+        }
+        ++block.stats.remembered;
+    }
+    *slot = Record{targetId, type, position, time, intensity, lifetime};
+}
+
+void PerceptionMemory::forget(Handle handle, std::uint32_t targetId) {
+    if (!valid(handle)) return;
+    Block& block = blocks_[static_cast<std::size_t>(handle)];
+    if (targetId == 0) {
+        block.count = 0;
+        block.head = 0;
+        return;
+    }
+    // Compact the block so records stay contiguous; the ring restarts after the survivors
+    Record* first = records_.data() + static_cast<std::size_t>(handle) * capacity_;
+    Record* last = std::remove_if(first, first + block.count,
+                                  [targetId](const Record& record) { return record.targetId == targetId; });
+    std::size_t kept = static_cast<std::size_t>(last - first);
+    if (kept != block.count) {
+        block.count = static_cast<std::uint16_t>(kept);
+        block.head = 0;
+    }
+}
+
+const PerceptionMemory::Record* PerceptionMemory::records(Handle handle) const {
+    if (!valid(handle)) return nullptr;
+    return records_.data() + static_cast<std::size_t>(handle) * capacity_;
+}
+
+std::size_t PerceptionMemory::size(Handle handle) const {
+    return valid(handle) ? blocks_[static_cast<std::size_t>(handle)].count : 0;
+}
+
+const PerceptionMemory::Record* PerceptionMemory::freshest(Handle handle, PerceptionType type, float now,
+                                                           std::uint32_t targetId) const {
+    const Record* first = records(handle);
+    const Record* best = nullptr;
+    for (std::size_t i = 0, count = size(handle); i < count; ++i) {
+        const Record& record = first[i];
+        if (record.type != type || (targetId != 0 && record.targetId != targetId)) continue;
+        if (now - record.timestamp > record.lifetime) continue;
+        if (!best || record.timestamp > best->timestamp) best = &record;
+    }
+    return best;
+}
+
+PerceptionMemory::Stats PerceptionMemory::getStats() const {
+    Stats total = releasedStats_;
+    for (const Block& block : blocks_) {
+        if (!block.used) continue;
+        total.remembered += block.stats.remembered;
+        total.refreshed += block.stats.refreshed;
+        total.overwritten += block.stats.overwritten;
+    }
+    return total;
+}
+
+void PerceptionMemory::resetStats() {
+    releasedStats_ = Stats{};
+    for (Block& block : blocks_) {
+        block.stats = Stats{};
+    }
+}
+
+float PerceptionMemory::confidence(const Record& record, float now) {
+    float age = now - record.timestamp;
+    if (age > record.lifetime) return 0.0f;
+    if (age <= 0.0f || record.lifetime <= 0.0f) return record.intensity;
+    return record.intensity * (1.0f - age / record.lifetime);
+}
+
+} // namespace ai
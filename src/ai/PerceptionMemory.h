@@ -0,0 +1,90 @@
+#ifndef ABYSSAL_STATION_SRC_AI_PERCEPTIONMEMORY_H
+#define ABYSSAL_STATION_SRC_AI_PERCEPTIONMEMORY_H
+
+#include "AIState.h"
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ai {
+
+// Configuration for the shared perception memory store
+struct PerceptionMemoryConfig {
+    std::size_t slotsPerAgent = 8;      // Ring capacity; the oldest entry is overwritten when full
+};
+
+// Perception memory for many agents in one contiguous array. Each agent owns
+// a fixed block of slotsPerAgent records used as a ring: a new (type, target)
+// pair takes the next slot, overwriting the oldest entry once the block is
+// full, while a known pair is refreshed in place. Records store when and how
+// strongly something was perceived; their confidence decays linearly to zero
+// over their lifetime, computed on read, so no per-tick pass is needed.
+// Handles are block indices recycled through a free list. Writes only touch
+// the handle's own block (counters included), so agents may remember into
+// their blocks concurrently.
+class PerceptionMemory {
+public:
+    using Handle = std::int32_t;
+    static constexpr Handle kInvalidHandle = -1;
+
+    struct Record {
+        std::uint32_t targetId = 0;     // Entity id, 0 when the source is unknown
+        PerceptionType type = PerceptionType::SIGHT;
+        sf::Vector2f position;
+        float timestamp = 0.0f;         // Agent clock when last perceived
+        float intensity = 0.0f;         // Strength when last perceived
+        float lifetime = 0.0f;          // Seconds until confidence reaches zero
+    };
+
+    explicit PerceptionMemory(const PerceptionMemoryConfig& config = PerceptionMemoryConfig{});
+
+    Handle allocate();
+    void release(Handle handle);
+    bool valid(Handle handle) const;
+
+    // Refresh the record for (type, targetId) or write a new one into the ring
+    void remember(Handle handle, PerceptionType type, std::uint32_t targetId, const sf::Vector2f& position,
+                  float intensity, float time, float lifetime);
+    // Drop every record about targetId (all records when targetId is 0)
+    void forget(Handle handle, std::uint32_t targetId = 0);
+
+    // Records of one agent, contiguous; expired ones stay until overwritten
+    const Record* records(Handle handle) const;
+    std::size_t size(Handle handle) const;
+
+    // Freshest record of a type that still has confidence (any target when targetId is 0)
+    const Record* freshest(Handle handle, PerceptionType type, float now, std::uint32_t targetId = 0) const;
+
+    // Decayed strength: intensity at the time of perception, zero after lifetime
+    static float confidence(const Record& record, float now);
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t agentCount() const { return blocks_.size() - freeBlocks_.size(); }
+
+    struct Stats {
+        int remembered = 0;     // New records written
+        int refreshed = 0;      // Existing records updated in place
+        int overwritten = 0;    // Records lost to a full ring
+    };
+    // Sum of every block's counters (call outside concurrent writes)
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    struct Block {
+        std::uint16_t count = 0;    // Records in use, from the block start
+        std::uint16_t head = 0;     // Next slot to overwrite once full
+        bool used = false;
+        Stats stats;                // This block's writes since the last reset
+    };
+
+    std::size_t capacity_;
+    std::vector<Record> records_;   // blocks_.size() * capacity_
+    std::vector<Block> blocks_;
+    std::vector<Handle> freeBlocks_;
+    Stats releasedStats_;           // Counters of blocks released since the last reset
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_PERCEPTIONMEMORY_H
@@ -0,0 +1,185 @@
+#include "SoundPropagation.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace ai {
+
+SoundPropagation::SoundPropagation(const SoundPropagationConfig& config)
+    : config_(config)
+    , grid_(nullptr)
+    , activeCount_(0)
+{
+    fields_.resize(std::max<std::size_t>(1, config_.maxFields));
+}
+
+void SoundPropagation::setGrid(const NavGrid* grid) {
+    grid_ = grid;
+    clear();
+}
+
+bool SoundPropagation::ready() const {
+    return grid_ && !grid_->empty();
+}
+
+void SoundPropagation::setConfig(const SoundPropagationConfig& config) {
+    config_ = config;
+    fields_.assign(std::max<std::size_t>(1, config_.maxFields), Field{});
+    activeCount_ = 0;
+}
+
+void SoundPropagation::clear() {
+    for (auto& field : fields_) {
+        field.active = false;
+    }
+    activeCount_ = 0;
+}
+
+int SoundPropagation::emit(const sf::Vector2f& position, float intensity, entities::Entity* source, float duration) {
+    if (!ready() || intensity <= 0.0f) return -1;
+
+    Field& field = acquireField();
+    field.active = true;
+    field.origin = position;
+    field.source = source;
+    field.intensity = intensity;
+    field.range = intensity * config_.rangePerIntensity;
+    field.remaining = duration >= 0.0f ? duration : config_.defaultDuration;
+    flood(field);
+    ++activeCount_;
+    return static_cast<int>(&field - fields_.data());
+}
+
+SoundPropagation::Field& SoundPropagation::acquireField() {
+    Field* quietest = nullptr;
+    for (auto& field : fields_) {
+        if (!field.active) return field;
+        if (!quietest || field.intensity * field.remaining < quietest->intensity * quietest->remaining) {
+            quietest = &field;
+        }
+    }
+    // Pool full: recycle the field with the least sound left in it
+    quietest->active = false;
+    --activeCount_;
+    ++stats_.recycled;
+    return *quietest;
+}
+
+void SoundPropagation::update(float deltaTime) {
+    for (auto& field : fields_) {
+        if (!field.active) continue;
+        field.remaining -= deltaTime;
+        if (field.remaining <= 0.0f) {
+            field.active = false;
+            --activeCount_;
+            ++stats_.expired;
+        }
+    }
+}
+
+void SoundPropagation::flood(Field& field) {
+    float cellSize = grid_->cellSize();
+    sf::Vector2i start = grid_->worldToCell(field.origin);
+    field.originX = start.x;
+    field.originY = start.y;
+    field.radius = static_cast<int>(std::ceil(field.range / cellSize));
+    int side = 2 * field.radius + 1;
+    field.pathLength.assign(static_cast<std::size_t>(side) * side, -1.0f);
+    ++stats_.floods;
+    if (!grid_->inBounds(start.x, start.y)) return;
+
+    auto local = [&field, side](int x, int y) {
+        return (y - field.originY + field.radius) * side + (x - field.originX + field.radius);
+    };
+    auto blocked = [this](int x, int y) { return grid_->isBlocked(x, y); };
+
+    // Dijkstra over 8-connected cells; settled cells hold their final path length
+    std::vector<float>& path = field.pathLength;
+    heap_.clear();
+    heap_.emplace_back(0.0f, local(start.x, start.y));
+    const std::greater<std::pair<float, int>> later;
+    const float diagonal = cellSize * 1.41421356f;
+    const int dx[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int dy[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        auto [length, cell] = heap_.back();
+        heap_.pop_back();
+        if (path[cell] >= 0.0f) continue;
+        path[cell] = length;
+        ++stats_.cellsVisited;
+
+        int x = field.originX + cell % side - field.radius;
+        int y = field.originY + cell / side - field.radius;
+        for (int i = 0; i < 8; ++i) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (std::abs(nx - field.originX) > field.radius || std::abs(ny - field.originY) > field.radius) continue;
+            if (!grid_->inBounds(nx, ny)) continue;
+            int next = local(nx, ny);
+            if (path[next] >= 0.0f) continue;
+
+            float step = i < 4 ? cellSize : diagonal;
+            // Diagonals never slip between two cells at a wall corner
+            if (i >= 4 && (blocked(x + dx[i], y) || blocked(x, y + dy[i]))) continue;
+            if (blocked(nx, ny)) {
+                if (config_.wallPenalty < 0.0f) continue;
+                step += config_.wallPenalty;
+            }
+            float nextLength = length + step;
+            if (nextLength > field.range) continue;
+            heap_.emplace_back(nextLength, next);
+            std::push_heap(heap_.begin(), heap_.end(), later);
+        }
+    }
+}
+
+float SoundPropagation::fieldIntensity(const Field& field, const sf::Vector2f& position) const {
+    if (!field.active || field.range <= 0.0f) return 0.0f;
+    sf::Vector2i cell = grid_->worldToCell(position);
+    int lx = cell.x - field.originX + field.radius;
+    int ly = cell.y - field.originY + field.radius;
+    int side = 2 * field.radius + 1;
+    if (lx < 0 || ly < 0 || lx >= side || ly >= side) return 0.0f;
+
+    float length = field.pathLength[static_cast<std::size_t>(ly) * side + lx];
+    if (length < 0.0f) return 0.0f;
+    float intensity = field.intensity * (1.0f - length / field.range);
+    return intensity >= config_.minAudibleIntensity ? intensity : 0.0f;
+}
+
+float SoundPropagation::sampleField(int id, const sf::Vector2f& position) const {
+    if (!grid_ || id < 0 || static_cast<std::size_t>(id) >= fields_.size()) return 0.0f;
+    return fieldIntensity(fields_[static_cast<std::size_t>(id)], position);
+}
+
+bool SoundPropagation::sampleLoudest(const sf::Vector2f& position, Sample& out,
+                                     const entities::Entity* exclude) const {
+    if (!grid_ || activeCount_ == 0) return false;
+    bool found = false;
+    for (const auto& field : fields_) {
+        if (!field.active || (exclude && field.source == exclude)) continue;
+        float intensity = fieldIntensity(field, position);
+        if (intensity > 0.0f && (!found || intensity > out.intensity)) {
+            out = Sample{intensity, field.origin, field.source};
+            found = true;
+        }
+    }
+    return found;
+}
+
+void SoundPropagation::sampleAll(const sf::Vector2f& position, std::vector<Sample>& out,
+                                 const entities::Entity* exclude) const {
+    if (!grid_ || activeCount_ == 0) return;
+    for (const auto& field : fields_) {
+        if (!field.active || (exclude && field.source == exclude)) continue;
+        float intensity = fieldIntensity(field, position);
+        if (intensity > 0.0f) {
+            out.push_back(Sample{intensity, field.origin, field.source});
+        }
+    }
+}
+
+} // namespace ai
@@ -0,0 +1,99 @@
+#ifndef ABYSSAL_STATION_SRC_AI_SOUNDPROPAGATION_H
+#define ABYSSAL_STATION_SRC_AI_SOUNDPROPAGATION_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace entities { class Entity; }
+
+namespace ai {
+
+class NavGrid;
+
+// Configuration for grid-based sound propagation
+struct SoundPropagationConfig {
+    float rangePerIntensity = 150.0f;   // Open-air reach of a unit-intensity sound
+    float wallPenalty = 200.0f;         // Extra path length per blocked cell crossed (< 0 = walls are opaque)
+    float defaultDuration = 0.5f;       // Seconds a field stays audible
+    float minAudibleIntensity = 0.05f;  // Quieter samples are reported as silence
+    std::size_t maxFields = 32;         // Pool size; when full the quietest field is recycled
+};
+
+// Sound as a field over the nav grid occupancy. Each emitted sound runs one
+// bounded Dijkstra flood from its cell: path length grows around walls and
+// crossing a blocked cell adds wallPenalty, so sounds bend through doorways
+// and are muffled by walls. Intensity falls off linearly with path length.
+// The per-cell path lengths are kept for the field's duration, so listeners
+// sample any field in O(1). Field storage is pooled and reused.
+class SoundPropagation {
+public:
+    explicit SoundPropagation(const SoundPropagationConfig& config = SoundPropagationConfig{});
+
+    // Occupancy the floods run on (not owned); clears active fields
+    void setGrid(const NavGrid* grid);
+    bool ready() const;
+
+    // Flood a new field; returns its id, or -1 without a grid. duration < 0 uses the default
+    int emit(const sf::Vector2f& position, float intensity, entities::Entity* source = nullptr,
+             float duration = -1.0f);
+    void update(float deltaTime);   // Age fields and release expired ones
+    void clear();
+
+    struct Sample {
+        float intensity;
+        sf::Vector2f origin;
+        entities::Entity* source;
+    };
+
+    // Intensity of one field at position (0 when silent, expired or unknown)
+    float sampleField(int id, const sf::Vector2f& position) const;
+    // Loudest audible field at position, skipping sounds made by exclude
+    bool sampleLoudest(const sf::Vector2f& position, Sample& out,
+                       const entities::Entity* exclude = nullptr) const;
+    // Every audible field at position, appended to out
+    void sampleAll(const sf::Vector2f& position, std::vector<Sample>& out,
+                   const entities::Entity* exclude = nullptr) const;
+
+    std::size_t activeFields() const { return activeCount_; }
+    void setConfig(const SoundPropagationConfig& config);
+    const SoundPropagationConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int floods = 0;
+        int cellsVisited = 0;   // Cells settled by floods
+        int recycled = 0;       // Fields evicted early because the pool was full
+        int expired = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    struct Field {
+        bool active = false;
+        sf::Vector2f origin{0.f, 0.f};
+        entities::Entity* source = nullptr;
+        float intensity = 0.0f;
+        float range = 0.0f;
+        float remaining = 0.0f;
+        int originX = 0;
+        int originY = 0;
+        int radius = 0;                 // Window half-size in cells
+        std::vector<float> pathLength;  // (2 * radius + 1)^2 window, negative = unreached
+    };
+
+    SoundPropagationConfig config_;
+    const NavGrid* grid_;
+    std::vector<Field> fields_;
+    std::size_t activeCount_;
+    std::vector<std::pair<float, int>> heap_;   // Flood frontier, reused
+    Stats stats_;
+
+    Field& acquireField();
+    void flood(Field& field);
+    float fieldIntensity(const Field& field, const sf::Vector2f& position) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_SOUNDPROPAGATION_H
@@ -0,0 +1,99 @@
+#include "StateBuckets.h"
+#include "AISystem.h"
+#include "entities/Entity.h"
+#include <cmath>
+
+namespace ai {
+
+void AgentStateBuckets::clear() {
+    for (auto& bucket : buckets_) {
+        bucket.agents.clear();
+        bucket.deltaTime.clear();
+    }
+    movers_.clear();
+    moverDeltaTime_.clear();
+    stats_ = Stats{};
+}
+
+void AgentStateBuckets::add(AIAgent* agent, float deltaTime) {
+    std::size_t state = static_cast<std::size_t>(agent->getCurrentState());
+    buckets_[state].agents.push_back(agent);
+    buckets_[state].deltaTime.push_back(deltaTime);
+    ++stats_.agentsPerState[state];
+}
+
+void AgentStateBuckets::addMover(AIAgent* agent, float deltaTime) {
+    movers_.push_back(agent);
+    moverDeltaTime_.push_back(deltaTime);
+}
+
+void AgentStateBuckets::executeStates(collisions::CollisionManager* collisionManager) {
+    for (std::size_t state = 0; state < kStateCount; ++state) {
+        Bucket& bucket = buckets_[state];
+        AIState bucketState = static_cast<AIState>(state);
+        AIAgent::StateBehavior behavior = AIAgent::behaviorFor(bucketState);
+        for (std::size_t i = 0; i < bucket.agents.size(); ++i) {
+            AIAgent* agent = bucket.agents[i];
+            // An earlier behavior in this pass (an alert, say) may have moved the agent on
+            if (agent->getCurrentState() == bucketState) {
+                agent->executeState(behavior, bucket.deltaTime[i], collisionManager);
+            } else {
+                agent->executeState(bucket.deltaTime[i], collisionManager);
+            }
+            addMover(agent, bucket.deltaTime[i]);
+        }
+    }
+}
+
+void AgentStateBuckets::integrateMovement() {
+    // Gather pending requests
+    moving_.clear();
+    for (std::size_t i = 0; i < movers_.size(); ++i) {
+        if (movers_[i]->hasMovementRequest()) moving_.push_back(i);
+    }
+    std::size_t count = moving_.size();
+    positionX_.resize(count);
+    positionY_.resize(count);
+    targetX_.resize(count);
+    targetY_.resize(count);
+    speed_.resize(count);
+    deltaTime_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        AIAgent* agent = movers_[moving_[i]];
+        sf::Vector2f position = agent->getEntityPosition();
+        const sf::Vector2f& target = agent->getMovementTarget();
+        positionX_[i] = position.x;
+        positionY_[i] = position.y;
+        targetX_[i] = target.x;
+        targetY_[i] = target.y;
+        speed_[i] = agent->getConfig().speed;
+        deltaTime_[i] = moverDeltaTime_[moving_[i]];
+    }
+
+    // Same arithmetic as AIAgent::applyMovement, one straight-line loop
+    float* px = positionX_.data();
+    float* py = positionY_.data();
+    const float* tx = targetX_.data();
+    const float* ty = targetY_.data();
+    const float* speed = speed_.data();
+    const float* dt = deltaTime_.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        float dx = tx[i] - px[i];
+        float dy = ty[i] - py[i];
+        float length = std::sqrt(dx * dx + dy * dy);
+        float inverse = length > 0.0f ? 1.0f : 0.0f;
+        float divisor = length > 0.0f ? length : 1.0f;
+        px[i] += (dx / divisor) * speed[i] * dt[i] * inverse;
+        py[i] += (dy / divisor) * speed[i] * dt[i] * inverse;
+    }
+
+    // Scatter (a zero-length request writes back the unchanged position)
+    for (std::size_t i = 0; i < count; ++i) {
+        AIAgent* agent = movers_[moving_[i]];
+        agent->clearMovementRequest();
+        agent->getEntity()->setPosition({px[i], py[i]});
+    }
+    stats_.moved = static_cast<int>(count);
+}
+
+} // namespace ai
@@ -0,0 +1,71 @@
+#ifndef ABYSSAL_STATION_SRC_AI_STATEBUCKETS_H
+#define ABYSSAL_STATION_SRC_AI_STATEBUCKETS_H
+
+#include "AIState.h"
+#include <array>
+#include <vector>
+#include <cstddef>
+
+namespace collisions { class CollisionManager; }
+
+namespace ai {
+
+class AIAgent;
+
+// State-grouped commit stage. After decisions are applied, agents are grouped
+// by AIState and each state's behavior is looked up once and run over its
+// whole batch, so the same code path executes back to back with no per-agent
+// state switch. Behaviors still run per agent on the agent's own fields.
+// They only request movement; the requests are copied into flat scratch
+// arrays (position, target, speed, dt), integrated in one straight-line loop
+// and written back.
+class AgentStateBuckets {
+public:
+    static constexpr std::size_t kStateCount = static_cast<std::size_t>(AIState::DEAD) + 1;
+
+    void clear();
+
+    // Full update: bucketed by the agent's current state
+    void add(AIAgent* agent, float deltaTime);
+    // Movement only (low-detail LOD ticks already stepped their behavior)
+    void addMover(AIAgent* agent, float deltaTime);
+
+    // Run each state's behavior over its bucket, in AIState order
+    void executeStates(collisions::CollisionManager* collisionManager);
+    // Integrate every pending movement request
+    void integrateMovement();
+
+    const std::vector<AIAgent*>& bucket(AIState state) const {
+        return buckets_[static_cast<std::size_t>(state)].agents;
+    }
+
+    struct Stats {
+        std::array<int, kStateCount> agentsPerState{};
+        int moved = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct Bucket {
+        std::vector<AIAgent*> agents;
+        std::vector<float> deltaTime;
+    };
+    std::array<Bucket, kStateCount> buckets_;
+
+    // Movement scratch, refilled by integrateMovement()
+    std::vector<AIAgent*> movers_;
+    std::vector<float> moverDeltaTime_;
+    std::vector<float> positionX_;
+    std::vector<float> positionY_;
+    std::vector<float> targetX_;
+    std::vector<float> targetY_;
+    std::vector<float> speed_;
+    std::vector<float> deltaTime_;
+    std::vector<std::size_t> moving_;
+
+    Stats stats_;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_STATEBUCKETS_H
@@ -0,0 +1,182 @@
+#include "StressScenario.h"
+#include "AIManager.h"
+#include "../entities/EntityManager.h"
+#include "../entities/Player.h"
+#include "../entities/Wall.h"
+#include "../collisions/CollisionManager.h"
+#include "../core/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ai {
+
+namespace {
+
+sf::Color profileColor(BehaviorProfile profile) {
+    switch (profile) {
+        case BehaviorProfile::AGGRESSIVE: return sf::Color(220, 60, 60);
+        case BehaviorProfile::DEFENSIVE:  return sf::Color(60, 120, 220);
+        case BehaviorProfile::PASSIVE:    return sf::Color(150, 150, 150);
+        case BehaviorProfile::GUARD:      return sf::Color(230, 160, 40);
+        case BehaviorProfile::SCOUT:      return sf::Color(170, 80, 210);
+        default:                          return sf::Color(230, 230, 90);
+    }
+}
+
+constexpr float kAgentSize = 20.0f;
+constexpr int kProfileCount = 6;
+
+} // namespace
+
+StressAgent::StressAgent(Id id, const sf::Vector2f& position, BehaviorProfile profile)
+    : Entity(id, position, {kAgentSize, kAgentSize})
+    , profile_(profile)
+{
+    setCollisionLayer(Layer::Enemy);
+    shape_.setSize(size_);
+    shape_.setFillColor(profileColor(profile));
+}
+
+void StressAgent::render(sf::RenderWindow& window) {
+    shape_.setPosition(position_);
+    window.draw(shape_);
+}
+
+StressScenario::StressScenario(const StressScenarioConfig& config)
+    : config_(config)
+    , columns_(0)
+    , rows_(0)
+    , rng_(config.seed)
+    , player_(nullptr)
+{
+    config_.cellSize = std::max(config_.cellSize, 8.0f);
+    config_.agentCount = std::max(config_.agentCount, 0);
+
+    // Square world big enough for the crowd, never smaller than 24 cells a side
+    float side = std::sqrt(std::max(config_.areaPerAgent, 1.0f) * static_cast<float>(config_.agentCount));
+    columns_ = std::max(24, static_cast<int>(std::ceil(side / config_.cellSize)));
+    rows_ = columns_;
+    bounds_ = sf::FloatRect({0.f, 0.f}, {columns_ * config_.cellSize, rows_ * config_.cellSize});
+    blocked_.assign(static_cast<std::size_t>(columns_) * rows_, 0);
+}
+
+void StressScenario::populate(entities::EntityManager& entityManager, collisions::CollisionManager& collisionManager,
+                              AIManager& aiManager) {
+    entities::Entity::Id nextId = 1;
+    std::vector<std::pair<entities::Entity*, sf::FloatRect>> colliders;
+
+    auto addWall = [&](int x, int y, int width, int height) {
+        for (int cy = y; cy < y + height; ++cy) {
+            for (int cx = x; cx < x + width; ++cx) {
+                blocked_[static_cast<std::size_t>(cy) * columns_ + cx] = 1;
+            }
+        }
+        sf::Vector2f position(x * config_.cellSize, y * config_.cellSize);
+        sf::Vector2f size(width * config_.cellSize, height * config_.cellSize);
+        auto wall = std::make_unique<entities::Wall>(nextId++, position, size);
+        colliders.emplace_back(wall.get(), wall->getBounds());
+        entityManager.addEntity(std::move(wall));
+        ++stats_.walls;
+    };
+
+    // Border
+    addWall(0, 0, columns_, 1);
+    addWall(0, rows_ - 1, columns_, 1);
+    addWall(0, 1, 1, rows_ - 2);
+    addWall(columns_ - 1, 1, 1, rows_ - 2);
+
+    // Random straight segments of 2-6 cells until the density is reached; the
+    // middle stays clear for the player
+    int centerX = columns_ / 2;
+    int centerY = rows_ / 2;
+    int interior = (columns_ - 2) * (rows_ - 2);
+    int wanted = static_cast<int>(interior * std::clamp(config_.wallDensity, 0.0f, 0.5f));
+    int covered = 0;
+    int attempts = wanted * 4;
+    while (covered < wanted && attempts-- > 0) {
+        int length = 2 + randomInt(5);
+        bool horizontal = randomInt(2) == 0;
+        int width = horizontal ? length : 1;
+        int height = horizontal ? 1 : length;
+        int x = 1 + randomInt(columns_ - 1 - width);
+        int y = 1 + randomInt(rows_ - 1 - height);
+        if (x <= centerX + 2 && x + width >= centerX - 2 && y <= centerY + 2 && y + height >= centerY - 2) continue;
+        addWall(x, y, width, height);
+        covered += length;
+    }
+    collisionManager.updateColliderBoundsBatch(colliders);
+
+    auto player = std::make_unique<entities::Player>(nextId++, cellCenter(centerX, centerY) - sf::Vector2f(16.f, 16.f));
+    player_ = player.get();
+    entityManager.addEntity(std::move(player));
+    aiManager.setPlayer(player_);
+
+    agents_.reserve(static_cast<std::size_t>(config_.agentCount));
+    int radiusCells = std::max(1, static_cast<int>(config_.patrolRadius / config_.cellSize));
+    for (int i = 0; i < config_.agentCount; ++i) {
+        int x = 0;
+        int y = 0;
+        if (!randomFreeCell(x, y)) break;
+
+        auto profile = static_cast<BehaviorProfile>(randomInt(kProfileCount));
+        sf::Vector2f half(kAgentSize * 0.5f, kAgentSize * 0.5f);
+        auto body = std::make_unique<StressAgent>(nextId++, cellCenter(x, y) - half, profile);
+        StressAgent* agent = body.get();
+        entityManager.addEntity(std::move(body));
+
+        AIAgentConfig agentConfig;
+        agentConfig.profile = profile;
+        agentConfig.speed = config_.agentSpeed;
+        aiManager.addAgent(agent, agentConfig);
+
+        // Patrol around the spawn point, over free cells only
+        std::vector<sf::Vector2f> route{agent->position()};
+        for (int p = 0; p < config_.patrolPoints; ++p) {
+            int px = std::clamp(x + randomInt(2 * radiusCells + 1) - radiusCells, 1, columns_ - 2);
+            int py = std::clamp(y + randomInt(2 * radiusCells + 1) - radiusCells, 1, rows_ - 2);
+            if (isBlocked(px, py)) continue;
+            route.push_back(cellCenter(px, py) - half);
+        }
+        if (route.size() > 1) {
+            aiManager.getAgent(agent)->setPatrolPoints(route);
+            stats_.patrolPoints += static_cast<int>(route.size());
+        }
+
+        agents_.push_back(agent);
+        ++stats_.profiles[static_cast<std::size_t>(profile)];
+    }
+    stats_.agents = static_cast<int>(agents_.size());
+
+    NavGridConfig gridConfig;
+    gridConfig.cellSize = config_.cellSize;
+    gridConfig.bounds = bounds_;
+    aiManager.rebuildNavGrid(&collisionManager, gridConfig);
+
+    core::Logger::instance().info("[AI] Stress scenario seed=" + std::to_string(config_.seed) +
+                                  " agents=" + std::to_string(stats_.agents) +
+                                  " walls=" + std::to_string(stats_.walls) +
+                                  " grid=" + std::to_string(columns_) + "x" + std::to_string(rows_));
+}
+
+int StressScenario::randomInt(int bound) {
+    return bound > 0 ? static_cast<int>(rng_() % static_cast<std::uint32_t>(bound)) : 0;
+}
+
+bool StressScenario::isBlocked(int x, int y) const {
+    return blocked_[static_cast<std::size_t>(y) * columns_ + x] != 0;
+}
+
+sf::Vector2f StressScenario::cellCenter(int x, int y) const {
+    return {(x + 0.5f) * config_.cellSize, (y + 0.5f) * config_.cellSize};
+}
+
+bool StressScenario::randomFreeCell(int& x, int& y) {
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        x = 1 + randomInt(columns_ - 2);
+        y = 1 + randomInt(rows_ - 2);
+        if (!isBlocked(x, y)) return true;
+    }
+    return false;
+}
+
+} // namespace ai
@@ -0,0 +1,98 @@
+#ifndef ABYSSAL_STATION_SRC_AI_STRESSSCENARIO_H
+#define ABYSSAL_STATION_SRC_AI_STRESSSCENARIO_H
+
+#include "AIState.h"
+#include "entities/Entity.h"
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace entities {
+    class EntityManager;
+    class Player;
+}
+namespace collisions { class CollisionManager; }
+
+namespace ai {
+
+class AIManager;
+
+// Configuration for a generated AI load scenario
+struct StressScenarioConfig {
+    std::uint32_t seed = 0xA15EEDu;
+    int agentCount = 100;
+    float areaPerAgent = 16000.0f;      // World area grows with the agent count (~126 px square each)
+    float cellSize = 32.0f;             // Wall layout and nav grid cell
+    float wallDensity = 0.06f;          // Share of cells covered by wall segments
+    int patrolPoints = 3;               // Per agent, besides the spawn point
+    float patrolRadius = 160.0f;
+    float agentSpeed = 80.0f;
+};
+
+// Body of a generated agent: a small square tinted by behavior profile
+class StressAgent : public entities::Entity {
+public:
+    StressAgent(Id id, const sf::Vector2f& position, BehaviorProfile profile);
+
+    void update(float /*deltaTime*/) override {}
+    void render(sf::RenderWindow& window) override;
+
+    BehaviorProfile getProfile() const { return profile_; }
+
+private:
+    BehaviorProfile profile_;
+    sf::RectangleShape shape_;
+};
+
+// Seeded AI stress scene: a square world sized for agentCount, border walls
+// plus random wall segments, one player in the middle and agentCount agents
+// with mixed BehaviorProfiles and patrol routes on free cells. The layout only
+// depends on the config (std::mt19937 reduced with modulo, as in the
+// pathfinding benchmark), so runs are comparable across machines.
+class StressScenario {
+public:
+    explicit StressScenario(const StressScenarioConfig& config = StressScenarioConfig{});
+
+    // Adds walls, the player and the agents, registers the agents with
+    // aiManager and bakes its nav grid. Wall colliders go in as one batch;
+    // agents get none, since only walls block sight and paths here.
+    void populate(entities::EntityManager& entityManager, collisions::CollisionManager& collisionManager,
+                  AIManager& aiManager);
+
+    const StressScenarioConfig& getConfig() const { return config_; }
+    const sf::FloatRect& getBounds() const { return bounds_; }
+    entities::Player* getPlayer() const { return player_; }
+    const std::vector<StressAgent*>& getAgents() const { return agents_; }
+
+    struct Stats {
+        int walls = 0;
+        int agents = 0;
+        int patrolPoints = 0;
+        std::array<int, 6> profiles{};     // Agents per BehaviorProfile
+    };
+    const Stats& getStats() const { return stats_; }
+
+private:
+    StressScenarioConfig config_;
+    sf::FloatRect bounds_;
+    int columns_;
+    int rows_;
+    std::vector<std::uint8_t> blocked_;     // Cells covered by a wall
+    std::mt19937 rng_;
+
+    entities::Player* player_;
+    std::vector<StressAgent*> agents_;
+    Stats stats_;
+
+    int randomInt(int bound);
+    bool isBlocked(int x, int y) const;
+    sf::Vector2f cellCenter(int x, int y) const;
+    bool randomFreeCell(int& x, int& y);
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_STRESSSCENARIO_H
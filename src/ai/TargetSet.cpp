@@ -0,0 +1,156 @@
+#include "TargetSet.h"
+#include <algorithm>
+
+namespace ai {
+
+TargetSet::TargetSet(int maxTargets)
+    : entries_{}
+    , count_(0)
+    , limit_(0)
+    , primary_(-1)
+{
+    setLimit(maxTargets);
+}
+
+void TargetSet::setLimit(int maxTargets) {
+    // Entries above a lowered limit stay until the owner removes them (see weakest())
+    limit_ = static_cast<std::uint8_t>(std::clamp<int>(maxTargets, 1, static_cast<int>(kCapacity)));
+}
+
+TargetSet::AddResult TargetSet::add(entities::Entity* target, Priority priority, float distance,
+                                    entities::Entity*& evicted) {
+    evicted = nullptr;
+    if (!target) return AddResult::Rejected;
+
+    int known = find(target);
+    if (known >= 0) {
+        Entry& entry = entries_[known];
+        entry.priority = std::max(entry.priority, priority);
+        entry.distance = distance;
+        selectPrimary();
+        return AddResult::Updated;
+    }
+
+    if (count_ >= limit_) {
+        std::size_t victim = static_cast<std::size_t>(weakestIndex());
+        if (priority < entries_[victim].priority ||
+            (priority == entries_[victim].priority && distance >= entries_[victim].distance)) {
+            return AddResult::Rejected;
+        }
+        evicted = entries_[victim].entity;
+        erase(victim);
+    }
+
+    entries_[count_++] = Entry{target, priority, distance};
+    selectPrimary();
+    return AddResult::Added;
+}
+
+bool TargetSet::remove(const entities::Entity* target) {
+    int index = find(target);
+    if (index < 0) return false;
+    erase(static_cast<std::size_t>(index));
+    selectPrimary();
+    return true;
+}
+
+void TargetSet::clear() {
+    count_ = 0;
+    primary_ = -1;
+}
+
+entities::Entity* TargetSet::weakest() const {
+    int index = weakestIndex();
+    return index >= 0 ? entries_[index].entity : nullptr;
+}
+
+int TargetSet::weakestIndex() const {
+    // Lowest priority, farthest on ties, newest after that
+    int weakest = count_ > 0 ? 0 : -1;
+    for (std::size_t i = 1; i < count_; ++i) {
+        const Entry& entry = entries_[i];
+        const Entry& current = entries_[weakest];
+        if (entry.priority < current.priority ||
+            (entry.priority == current.priority && entry.distance >= current.distance)) {
+            weakest = static_cast<int>(i);
+        }
+    }
+    return weakest;
+}
+
+int TargetSet::find(const entities::Entity* target) const {
+    for (std::size_t i = 0; i < count_; ++i) {
+        if (entries_[i].entity == target) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void TargetSet::erase(std::size_t index) {
+    // Shift rather than swap so insertion order (the last tie-break) is kept
+    for (std::size_t i = index + 1; i < count_; ++i) {
+        entries_[i - 1] = entries_[i];
+    }
+    --count_;
+}
+
+void TargetSet::selectPrimary() {
+    primary_ = -1;
+    for (std::size_t i = 0; i < count_; ++i) {
+        if (primary_ < 0) {
+            primary_ = static_cast<std::int8_t>(i);
+            continue;
+        }
+        const Entry& entry = entries_[i];
+        const Entry& best = entries_[primary_];
+        if (entry.priority > best.priority ||
+            (entry.priority == best.priority && entry.distance < best.distance)) {
+            primary_ = static_cast<std::int8_t>(i);
+        }
+    }
+}
+
+void TargetIndex::link(const entities::Entity* target, AIAgent* holder) {
+    if (!target || !holder) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<AIAgent*>& agents = holders_[target];
+    if (std::find(agents.begin(), agents.end(), holder) != agents.end()) return;
+    agents.push_back(holder);
+    ++stats_.links;
+}
+
+void TargetIndex::unlink(const entities::Entity* target, AIAgent* holder) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = holders_.find(target);
+    if (it == holders_.end()) return;
+    std::vector<AIAgent*>& agents = it->second;
+    auto held = std::find(agents.begin(), agents.end(), holder);
+    if (held == agents.end()) return;
+    agents.erase(held);
+    if (agents.empty()) holders_.erase(it);
+    ++stats_.unlinks;
+}
+
+void TargetIndex::holders(const entities::Entity* target, std::vector<AIAgent*>& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = holders_.find(target);
+    if (it != holders_.end()) out = it->second;
+}
+
+std::size_t TargetIndex::holderCount(const entities::Entity* target) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = holders_.find(target);
+    return it != holders_.end() ? it->second.size() : 0;
+}
+
+std::size_t TargetIndex::targetCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return holders_.size();
+}
+
+TargetIndex::Stats TargetIndex::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace ai
@@ -0,0 +1,112 @@
+#ifndef ABYSSAL_STATION_SRC_AI_TARGETSET_H
+#define ABYSSAL_STATION_SRC_AI_TARGETSET_H
+
+#include "AIState.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace entities { class Entity; }
+
+namespace ai {
+
+class AIAgent;
+
+// An agent's targets, stored inline: at most kCapacity entries (fewer when
+// the agent's maxTargets is lower), each with its priority and last known
+// distance. The primary target is the highest priority, nearest on ties,
+// oldest after that; it is recomputed when entries change, not when read.
+// When full, a new target only gets in by pushing out a weaker one.
+class TargetSet {
+public:
+    static constexpr std::size_t kCapacity = 8;
+
+    struct Entry {
+        entities::Entity* entity = nullptr;
+        Priority priority = Priority::LOW;
+        float distance = 0.0f;
+    };
+
+    enum class AddResult : std::uint8_t {
+        Rejected,       // Full and every entry outranks the new one
+        Added,
+        Updated,        // Already held; priority raised and distance refreshed
+    };
+
+    explicit TargetSet(int maxTargets = 3);
+
+    // evicted is set to the entry pushed out to make room, if any
+    AddResult add(entities::Entity* target, Priority priority, float distance, entities::Entity*& evicted);
+    bool remove(const entities::Entity* target);
+    void clear();
+
+    bool contains(const entities::Entity* target) const { return find(target) >= 0; }
+    // Refresh the stored distances (one call per entry) and the primary target
+    template <typename DistanceFn>
+    void updateDistances(DistanceFn&& distanceTo) {
+        for (std::size_t i = 0; i < count_; ++i) {
+            entries_[i].distance = distanceTo(entries_[i].entity);
+        }
+        selectPrimary();
+    }
+
+    entities::Entity* primary() const { return primary_ >= 0 ? entries_[primary_].entity : nullptr; }
+    const Entry* primaryEntry() const { return primary_ >= 0 ? &entries_[primary_] : nullptr; }
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    std::size_t limit() const { return limit_; }
+    // A lower limit only applies to new adds; the owner trims with weakest()
+    void setLimit(int maxTargets);
+    // The entry a full set gives up first, nullptr when empty
+    entities::Entity* weakest() const;
+
+    // Entries in insertion order
+    const Entry* begin() const { return entries_.data(); }
+    const Entry* end() const { return entries_.data() + count_; }
+    const Entry& operator[](std::size_t index) const { return entries_[index]; }
+
+private:
+    std::array<Entry, kCapacity> entries_;
+    std::uint8_t count_;
+    std::uint8_t limit_;
+    std::int8_t primary_;           // Index into entries_, -1 when empty
+
+    int find(const entities::Entity* target) const;
+    int weakestIndex() const;
+    void erase(std::size_t index);
+    void selectPrimary();
+};
+
+// Reverse index from a target entity to the agents holding it, so a death is
+// delivered only to those agents instead of to every agent. Agents keep it
+// up to date as their TargetSet changes; targets are added during the
+// parallel think phase, so links go through a lock (changes are rare).
+// Holder order follows link order, which is not deterministic under threads.
+class TargetIndex {
+public:
+    void link(const entities::Entity* target, AIAgent* holder);
+    void unlink(const entities::Entity* target, AIAgent* holder);
+
+    // Agents holding target, copied so callers may unlink while walking them
+    void holders(const entities::Entity* target, std::vector<AIAgent*>& out) const;
+    std::size_t holderCount(const entities::Entity* target) const;
+    std::size_t targetCount() const;
+
+    struct Stats {
+        int links = 0;
+        int unlinks = 0;
+    };
+    Stats getStats() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<const entities::Entity*, std::vector<AIAgent*>> holders_;
+    Stats stats_;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_TARGETSET_H
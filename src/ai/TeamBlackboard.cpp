@@ -0,0 +1,191 @@
+#include "TeamBlackboard.h"
+#include "../entities/Entity.h"
+#include <algorithm>
+
+namespace ai {
+
+TeamBlackboard::TeamBlackboard(const TeamBlackboardConfig& config)
+    : config_(config)
+    , time_(0.0f)
+    , version_(0)
+    , slotVersions_{}
+    , trimmedVersion_(0)
+    , nextAlertZone_(0)
+{
+}
+
+void TeamBlackboard::postTargetPosition(entities::Entity* target, const sf::Vector2f& position, std::uint32_t owner) {
+    if (!target) return;
+    Entry* known = find(Slot::TargetPosition, target->id());
+    if (known && known->active && known->entity == target) {
+        sf::Vector2f moved = position - known->position;
+        if (moved.x * moved.x + moved.y * moved.y < config_.minTargetMove * config_.minTargetMove) {
+            ++stats_.suppressed;
+            return;
+        }
+    }
+    Entry& entry = known ? *known : slotFor(Slot::TargetPosition, target->id());
+    entry.entity = target;
+    entry.position = position;
+    entry.owner = owner;
+    entry.active = true;
+    publish(entry);
+}
+
+void TeamBlackboard::clearTarget(const entities::Entity* target) {
+    if (!target) return;
+    Entry* entry = find(Slot::TargetPosition, target->id());
+    if (!entry || !entry->active) return;
+    entry->active = false;
+    entry->entity = nullptr;
+    publish(*entry);
+}
+
+void TeamBlackboard::postAlertZone(const sf::Vector2f& position, float radius, std::uint32_t owner) {
+    std::uint32_t zones = static_cast<std::uint32_t>(std::max(config_.maxAlertZones, 1));
+    Entry& entry = slotFor(Slot::AlertZone, nextAlertZone_ % zones);
+    nextAlertZone_ = (nextAlertZone_ + 1) % zones;
+    entry.position = position;
+    entry.radius = radius;
+    entry.owner = owner;
+    entry.active = true;
+    publish(entry);
+}
+
+bool TeamBlackboard::claimFlank(std::uint32_t agentId, const sf::Vector2f& position) {
+    float spacingSq = config_.flankSpacing * config_.flankSpacing;
+    for (const Entry& other : entries_) {
+        if (other.slot != Slot::FlankClaim || !other.active || other.key == agentId) continue;
+        sf::Vector2f offset = other.position - position;
+        if (offset.x * offset.x + offset.y * offset.y < spacingSq) {
+            ++stats_.rejectedClaims;
+            return false;
+        }
+    }
+    Entry& entry = slotFor(Slot::FlankClaim, agentId);
+    if (entry.active && entry.position == position) return true;
+    entry.position = position;
+    entry.owner = agentId;
+    entry.active = true;
+    publish(entry);
+    return true;
+}
+
+void TeamBlackboard::releaseFlank(std::uint32_t agentId) {
+    Entry* entry = find(Slot::FlankClaim, agentId);
+    if (!entry || !entry->active) return;
+    entry->active = false;
+    publish(*entry);
+}
+
+void TeamBlackboard::clear() {
+    // Versions keep counting so old cursors never look ahead of the board
+    entries_.clear();
+    index_.clear();
+    changes_.clear();
+    trimmedVersion_ = version_;
+    nextAlertZone_ = 0;
+}
+
+void TeamBlackboard::expire() {
+    for (Entry& entry : entries_) {
+        if (!entry.active) continue;
+        float lifetime = entry.slot == Slot::TargetPosition ? config_.targetLifetime
+                       : entry.slot == Slot::AlertZone ? config_.alertLifetime : -1.0f;
+        if (lifetime >= 0.0f && time_ - entry.time > lifetime) {
+            entry.active = false;
+            entry.entity = nullptr;
+            publish(entry);
+        }
+    }
+}
+
+TeamBlackboard::Version TeamBlackboard::latestVersion(Mask mask) const {
+    Version latest = 0;
+    for (std::size_t slot = 0; slot < kSlotCount; ++slot) {
+        if (mask & (1u << slot)) latest = std::max(latest, slotVersions_[slot]);
+    }
+    return latest;
+}
+
+TeamBlackboard::Version TeamBlackboard::changesSince(Version since, Mask mask, std::vector<const Entry*>& out) const {
+    out.clear();
+    if (since >= latestVersion(mask)) return version_;
+
+    if (since < trimmedVersion_) {
+        // The log no longer reaches back that far: scan the slots instead
+        ++stats_.fullScans;
+        for (const Entry& entry : entries_) {
+            if (entry.version > since && (mask & maskOf(entry.slot))) out.push_back(&entry);
+        }
+        std::sort(out.begin(), out.end(), [](const Entry* a, const Entry* b) { return a->version < b->version; });
+    } else {
+        auto first = std::upper_bound(changes_.begin(), changes_.end(), since,
+                                      [](Version version, const Change& change) { return version < change.version; });
+        for (auto it = first; it != changes_.end(); ++it) {
+            const Entry& entry = entries_[it->entry];
+            // Rewritten later: the newer change delivers it
+            if (entry.version != it->version || !(mask & maskOf(entry.slot))) continue;
+            out.push_back(&entry);
+        }
+    }
+    stats_.delivered += static_cast<int>(out.size());
+    return version_;
+}
+
+const TeamBlackboard::Entry* TeamBlackboard::targetPosition(const entities::Entity* target) const {
+    if (!target) return nullptr;
+    const Entry* entry = find(Slot::TargetPosition, target->id());
+    return entry && entry->active ? entry : nullptr;
+}
+
+const TeamBlackboard::Entry* TeamBlackboard::flankClaim(std::uint32_t agentId) const {
+    const Entry* entry = find(Slot::FlankClaim, agentId);
+    return entry && entry->active ? entry : nullptr;
+}
+
+void TeamBlackboard::collect(Slot slot, std::vector<const Entry*>& out) const {
+    out.clear();
+    for (const Entry& entry : entries_) {
+        if (entry.slot == slot && entry.active) out.push_back(&entry);
+    }
+}
+
+TeamBlackboard::Entry& TeamBlackboard::slotFor(Slot slot, std::uint32_t key) {
+    auto [it, inserted] = index_.try_emplace(makeKey(slot, key), static_cast<std::uint32_t>(entries_.size()));
+    if (inserted) {
+        Entry entry;
+        entry.slot = slot;
+        entry.key = key;
+        entries_.push_back(entry);
+    }
+    return entries_[it->second];
+}
+
+TeamBlackboard::Entry* TeamBlackboard::find(Slot slot, std::uint32_t key) {
+    auto it = index_.find(makeKey(slot, key));
+    return it != index_.end() ? &entries_[it->second] : nullptr;
+}
+
+const TeamBlackboard::Entry* TeamBlackboard::find(Slot slot, std::uint32_t key) const {
+    auto it = index_.find(makeKey(slot, key));
+    return it != index_.end() ? &entries_[it->second] : nullptr;
+}
+
+void TeamBlackboard::publish(Entry& entry) {
+    entry.time = time_;
+    entry.version = ++version_;
+    slotVersions_[static_cast<std::size_t>(entry.slot)] = version_;
+    changes_.push_back({version_, static_cast<std::uint32_t>(&entry - entries_.data())});
+    ++stats_.writes;
+
+    std::size_t capacity = std::max<std::size_t>(config_.changeLogCapacity, 2);
+    if (changes_.size() > capacity) {
+        // Drop the older half at once so trimming stays amortized
+        std::size_t dropped = changes_.size() / 2;
+        trimmedVersion_ = changes_[dropped - 1].version;
+        changes_.erase(changes_.begin(), changes_.begin() + static_cast<std::ptrdiff_t>(dropped));
+    }
+}
+
+} // namespace ai
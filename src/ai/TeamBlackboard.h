@@ -0,0 +1,131 @@
+#ifndef ABYSSAL_STATION_SRC_AI_TEAMBLACKBOARD_H
+#define ABYSSAL_STATION_SRC_AI_TEAMBLACKBOARD_H
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace entities { class Entity; }
+
+namespace ai {
+
+// Configuration for the shared team blackboard
+struct TeamBlackboardConfig {
+    float minTargetMove = 8.0f;         // Smaller moves of a known target are not published again
+    float targetLifetime = 10.0f;       // Seconds a target position stays without a new report
+    int maxAlertZones = 10;             // Alert zones kept; the oldest slot is reused
+    float alertLifetime = 10.0f;
+    float flankSpacing = 48.0f;         // Minimum distance between two claimed flanking positions
+    std::size_t changeLogCapacity = 1024;   // Readers further behind fall back to a full scan
+};
+
+// Shared coordination state for the whole team, stored as typed slots:
+// last known target positions (keyed by target id), alert zones (a small
+// ring) and claimed flanking positions (one per agent). Every write stamps
+// the entry with a new version and appends it to a change log, so a reader
+// that remembers the version it last saw only walks what changed since,
+// filtered by its subscription mask. Rewrites of the same entry show up once,
+// with their latest data; removals are delivered as inactive entries.
+class TeamBlackboard {
+public:
+    enum class Slot : std::uint8_t {
+        TargetPosition = 0,
+        AlertZone = 1,
+        FlankClaim = 2,
+    };
+    static constexpr std::size_t kSlotCount = 3;
+
+    using Mask = std::uint32_t;
+    using Version = std::uint64_t;
+    static constexpr Mask maskOf(Slot slot) { return 1u << static_cast<unsigned>(slot); }
+    static constexpr Mask kAllSlots = (1u << kSlotCount) - 1u;
+
+    struct Entry {
+        Slot slot = Slot::TargetPosition;
+        std::uint32_t key = 0;              // Target id, alert ring index or claiming agent id
+        std::uint32_t owner = 0;            // Entity id of the writer, 0 when unknown
+        entities::Entity* entity = nullptr; // Target of a TargetPosition entry
+        sf::Vector2f position;
+        float radius = 0.0f;                // Alert zone radius
+        float time = 0.0f;                  // Blackboard clock at the last write
+        Version version = 0;
+        bool active = false;
+    };
+
+    explicit TeamBlackboard(const TeamBlackboardConfig& config = TeamBlackboardConfig{});
+
+    // Clock used for timestamps and expiry (the AIManager advances it every frame)
+    void setTime(float time) { time_ = time; }
+    float getTime() const { return time_; }
+
+    // Writers. A target report that moved less than minTargetMove is dropped:
+    // it is not a change and does not refresh the entry, so a target that
+    // stands still expires after targetLifetime and its next report is new.
+    void postTargetPosition(entities::Entity* target, const sf::Vector2f& position, std::uint32_t owner = 0);
+    void clearTarget(const entities::Entity* target);
+    void postAlertZone(const sf::Vector2f& position, float radius, std::uint32_t owner = 0);
+    // Fails when another agent already holds a claim within flankSpacing;
+    // a new claim replaces the agent's previous one
+    bool claimFlank(std::uint32_t agentId, const sf::Vector2f& position);
+    void releaseFlank(std::uint32_t agentId);
+    void clear();
+
+    // Deactivate target positions and alert zones past their lifetime
+    void expire();
+
+    // Latest version among the masked slots: a reader whose cursor is not
+    // behind it has nothing to do
+    Version latestVersion(Mask mask = kAllSlots) const;
+    // Entries of the masked slots written after since, in version order.
+    // Returns the version to pass next time.
+    Version changesSince(Version since, Mask mask, std::vector<const Entry*>& out) const;
+
+    const Entry* targetPosition(const entities::Entity* target) const;
+    const Entry* flankClaim(std::uint32_t agentId) const;
+    // Active entries of one slot type, in storage order
+    void collect(Slot slot, std::vector<const Entry*>& out) const;
+
+    void setConfig(const TeamBlackboardConfig& config) { config_ = config; }
+    const TeamBlackboardConfig& getConfig() const { return config_; }
+
+    struct Stats {
+        int writes = 0;             // Versioned changes
+        int suppressed = 0;         // Target reports within minTargetMove
+        int delivered = 0;          // Entries handed to readers
+        int fullScans = 0;          // Readers older than the change log
+        int rejectedClaims = 0;
+    };
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    struct Change {
+        Version version;
+        std::uint32_t entry;
+    };
+
+    TeamBlackboardConfig config_;
+    float time_;
+    Version version_;
+    std::array<Version, kSlotCount> slotVersions_;
+    std::vector<Entry> entries_;        // Slots stay in place once created
+    std::unordered_map<std::uint64_t, std::uint32_t> index_;   // (slot, key) -> entries_
+    std::vector<Change> changes_;       // Ascending versions
+    Version trimmedVersion_;            // Changes up to this version were dropped from the log
+    std::uint32_t nextAlertZone_;
+    mutable Stats stats_;
+
+    static std::uint64_t makeKey(Slot slot, std::uint32_t key) {
+        return (static_cast<std::uint64_t>(slot) << 32) | key;
+    }
+    Entry& slotFor(Slot slot, std::uint32_t key);
+    Entry* find(Slot slot, std::uint32_t key);
+    const Entry* find(Slot slot, std::uint32_t key) const;
+    void publish(Entry& entry);
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_TEAMBLACKBOARD_H
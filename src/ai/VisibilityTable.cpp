@@ -0,0 +1,516 @@
+#include "VisibilityTable.h"
+#include "NavGrid.h"
+#include "collisions/CollisionManager.h"
+#include "core/Logger.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace ai {
+
+namespace {
+constexpr int kSerializationVersion = 2;
+constexpr int kVisibleSet = 0;
+constexpr int kHiddenSet = 1;
+// Cells closer than this to the hull count as touching it
+constexpr float kTouchEpsilon = 1e-3f;
+
+// Geometry below is in occupancy cell units: cell (x, y) covers [x, x+1] x [y, y+1]
+struct Point {
+    float x;
+    float y;
+};
+
+// Inclusive range of occupancy cells
+struct CellSpan {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+CellSpan blockSpan(int cx, int cy, int block, int gridWidth, int gridHeight) {
+    return CellSpan{cx * block, cy * block,
+                    std::min((cx + 1) * block, gridWidth) - 1, std::min((cy + 1) * block, gridHeight) - 1};
+}
+
+float cross(const Point& o, const Point& a, const Point& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Convex hull of both blocks (monotone chain, counter-clockwise): every
+// segment from a point of one block to a point of the other lies inside it
+std::vector<Point> pairHull(const CellSpan& a, const CellSpan& b) {
+    std::vector<Point> points;
+    points.reserve(8);
+    for (const CellSpan* span : {&a, &b}) {
+        float x0 = static_cast<float>(span->x0);
+        float y0 = static_cast<float>(span->y0);
+        float x1 = static_cast<float>(span->x1 + 1);
+        float y1 = static_cast<float>(span->y1 + 1);
+        points.push_back({x0, y0});
+        points.push_back({x1, y0});
+        points.push_back({x0, y1});
+        points.push_back({x1, y1});
+    }
+    std::sort(points.begin(), points.end(), [](const Point& l, const Point& r) {
+        return l.x < r.x || (l.x == r.x && l.y < r.y);
+    });
+
+    std::vector<Point> hull(2 * points.size());
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0f) --k;
+        hull[k++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0f) --k;
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+// Separating axis test between a closed cell and the closed hull. The cell's
+// own axes are covered by the caller's box, so only hull edge normals remain.
+bool cellTouchesHull(const std::vector<Point>& hull, int x, int y) {
+    const Point corners[4] = {{static_cast<float>(x), static_cast<float>(y)},
+                              {static_cast<float>(x + 1), static_cast<float>(y)},
+                              {static_cast<float>(x), static_cast<float>(y + 1)},
+                              {static_cast<float>(x + 1), static_cast<float>(y + 1)}};
+    for (std::size_t i = 0; i < hull.size(); ++i) {
+        const Point& p = hull[i];
+        const Point& q = hull[(i + 1) % hull.size()];
+        // Counter-clockwise hull: the outward side of edge pq has cross < 0
+        bool outside = true;
+        for (const Point& corner : corners) {
+            if (cross(p, q, corner) / std::hypot(q.x - p.x, q.y - p.y) >= -kTouchEpsilon) {
+                outside = false;
+                break;
+            }
+        }
+        if (outside) return false;
+    }
+    return true;
+}
+
+// Summed-area table, so empty boxes are rejected without visiting their cells
+class GridCounts {
+public:
+    GridCounts(const std::vector<std::uint8_t>& cells, int width, int height)
+        : width_(width + 1)
+        , sums_(static_cast<std::size_t>(width + 1) * (height + 1), 0)
+    {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                sums_[index(x + 1, y + 1)] = cells[static_cast<std::size_t>(y) * width + x] +
+                                             sums_[index(x, y + 1)] + sums_[index(x + 1, y)] - sums_[index(x, y)];
+            }
+        }
+    }
+
+    int count(const CellSpan& span) const {
+        return sums_[index(span.x1 + 1, span.y1 + 1)] - sums_[index(span.x0, span.y1 + 1)] -
+               sums_[index(span.x1 + 1, span.y0)] + sums_[index(span.x0, span.y0)];
+    }
+
+private:
+    std::size_t index(int x, int y) const { return static_cast<std::size_t>(y) * width_ + x; }
+
+    int width_;
+    std::vector<int> sums_;
+};
+
+bool anyCellTouchesHull(const std::vector<std::uint8_t>& cells, const GridCounts& counts, int gridWidth,
+                        const CellSpan& box, const std::vector<Point>& hull) {
+    if (counts.count(box) == 0) return false;
+    for (int y = box.y0; y <= box.y1; ++y) {
+        for (int x = box.x0; x <= box.x1; ++x) {
+            if (cells[static_cast<std::size_t>(y) * gridWidth + x] && cellTouchesHull(hull, x, y)) return true;
+        }
+    }
+    return false;
+}
+
+bool touchesSpan(int x, int y, const CellSpan& span) {
+    return x >= span.x0 - 1 && x <= span.x1 + 1 && y >= span.y0 - 1 && y <= span.y1 + 1;
+}
+
+// Flood fill over non-solid cells touching the hull, from the cells touching
+// block a. A clear segment only crosses such cells, and consecutive cells
+// along it share at least a corner, so no connection means no clear segment.
+bool freeCorridorConnects(const std::vector<std::uint8_t>& solid, int gridWidth, const CellSpan& box,
+                          const std::vector<Point>& hull, const CellSpan& a, const CellSpan& b,
+                          std::vector<int>& visited, std::vector<sf::Vector2i>& frontier) {
+    const int boxWidth = box.x1 - box.x0 + 1;
+    const int boxHeight = box.y1 - box.y0 + 1;
+    // 0 unvisited, 1 closed (solid or outside the hull), 2 reached
+    visited.assign(static_cast<std::size_t>(boxWidth) * boxHeight, 0);
+    frontier.clear();
+    auto open = [&](int x, int y) -> bool {
+        int& state = visited[static_cast<std::size_t>(y - box.y0) * boxWidth + (x - box.x0)];
+        if (state != 0) return false;
+        bool free = !solid[static_cast<std::size_t>(y) * gridWidth + x] && cellTouchesHull(hull, x, y);
+        state = free ? 2 : 1;
+        return free;
+    };
+
+    for (int y = std::max(box.y0, a.y0 - 1); y <= std::min(box.y1, a.y1 + 1); ++y) {
+        for (int x = std::max(box.x0, a.x0 - 1); x <= std::min(box.x1, a.x1 + 1); ++x) {
+            if (open(x, y)) frontier.push_back({x, y});
+        }
+    }
+    while (!frontier.empty()) {
+        sf::Vector2i cell = frontier.back();
+        frontier.pop_back();
+        if (touchesSpan(cell.x, cell.y, b)) return true;
+        for (int ny = std::max(box.y0, cell.y - 1); ny <= std::min(box.y1, cell.y + 1); ++ny) {
+            for (int nx = std::max(box.x0, cell.x - 1); nx <= std::min(box.x1, cell.x + 1); ++nx) {
+                if (open(nx, ny)) frontier.push_back({nx, ny});
+            }
+        }
+    }
+    return false;
+}
+}
+
+VisibilityTable::VisibilityTable(const VisibilityTableConfig& config)
+    : config_(config)
+    , width_(0)
+    , height_(0)
+    , windowRadius_(0)
+    , wordsPerSet_(0)
+    , signature_(0)
+{
+}
+
+void VisibilityTable::build(const collisions::CollisionManager* collisionManager, const VisibilityTableConfig& config) {
+    config_ = config;
+    build(collisionManager);
+}
+
+void VisibilityTable::build(const collisions::CollisionManager* collisionManager) {
+    NavGrid occupancy;
+    std::vector<std::uint8_t> solid;
+    sampleGeometry(collisionManager, config_, occupancy, solid);
+    build(occupancy, solid);
+    signature_ = occupancySignature(occupancy, solid);
+}
+
+void VisibilityTable::build(const NavGrid& occupancy) {
+    std::vector<std::uint8_t> solid(static_cast<std::size_t>(occupancy.width()) * occupancy.height(), 0);
+    for (int y = 0; y < occupancy.height(); ++y) {
+        for (int x = 0; x < occupancy.width(); ++x) {
+            solid[static_cast<std::size_t>(y) * occupancy.width() + x] = occupancy.isBlocked(x, y) ? 1 : 0;
+        }
+    }
+    build(occupancy, solid);
+    signature_ = occupancySignature(occupancy);
+}
+
+void VisibilityTable::sampleGeometry(const collisions::CollisionManager* collisionManager,
+                                     const VisibilityTableConfig& config, NavGrid& occupancy,
+                                     std::vector<std::uint8_t>& solid) {
+    NavGridConfig occupancyConfig;
+    occupancyConfig.cellSize = config.sampleCellSize;
+    occupancyConfig.bounds = config.bounds;
+    occupancyConfig.obstacleLayerMask = config.staticLayerMask;
+    occupancy.rebuild(collisionManager, occupancyConfig);
+
+    // Occupancy marks any overlap; Hidden needs the cells a wall covers completely
+    solid.assign(static_cast<std::size_t>(occupancy.width()) * occupancy.height(), 0);
+    if (!collisionManager) return;
+    const float size = occupancy.cellSize();
+    const sf::Vector2f origin = occupancyConfig.bounds.position;
+    for (const auto& wall : collisionManager->collectBounds(config.staticLayerMask)) {
+        int x0 = std::max(0, static_cast<int>(std::ceil((wall.position.x - origin.x) / size)));
+        int y0 = std::max(0, static_cast<int>(std::ceil((wall.position.y - origin.y) / size)));
+        int x1 = std::min(occupancy.width(),
+                          static_cast<int>(std::floor((wall.position.x + wall.size.x - origin.x) / size)));
+        int y1 = std::min(occupancy.height(),
+                          static_cast<int>(std::floor((wall.position.y + wall.size.y - origin.y) / size)));
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                solid[static_cast<std::size_t>(y) * occupancy.width() + x] = 1;
+            }
+        }
+    }
+}
+
+std::uint64_t VisibilityTable::geometrySignature(const collisions::CollisionManager* collisionManager,
+                                                 const VisibilityTableConfig& config) {
+    NavGrid occupancy;
+    std::vector<std::uint8_t> solid;
+    sampleGeometry(collisionManager, config, occupancy, solid);
+    return occupancySignature(occupancy, solid);
+}
+
+bool VisibilityTable::isCurrent(const collisions::CollisionManager* collisionManager,
+                                const VisibilityTableConfig& config) const {
+    if (empty() || config.sampleCellSize <= 0.0f) return false;
+    // build() rounds the coarse cell to whole sample cells
+    float block = std::max(1.0f, std::round(config.cellSize / config.sampleCellSize));
+    auto same = [](float a, float b) { return std::abs(a - b) < 0.01f; };
+    return same(config_.sampleCellSize, config.sampleCellSize) &&
+           same(config_.cellSize, block * config.sampleCellSize) &&
+           same(config_.maxDistance, config.maxDistance) &&
+           config_.staticLayerMask == config.staticLayerMask &&
+           signature_ == geometrySignature(collisionManager, config);
+}
+
+void VisibilityTable::build(const NavGrid& occupancy, const std::vector<std::uint8_t>& solid) {
+    clear();
+    if (occupancy.empty() || config_.cellSize <= 0.0f) return;
+
+    // Coarse cells are whole blocks of occupancy cells
+    config_.sampleCellSize = occupancy.cellSize();
+    config_.bounds = occupancy.getConfig().bounds;
+    int block = std::max(1, static_cast<int>(std::round(config_.cellSize / config_.sampleCellSize)));
+    config_.cellSize = block * config_.sampleCellSize;
+
+    const int gridWidth = occupancy.width();
+    const int gridHeight = occupancy.height();
+    width_ = (gridWidth + block - 1) / block;
+    height_ = (gridHeight + block - 1) / block;
+    windowRadius_ = std::max(0, static_cast<int>(std::ceil(config_.maxDistance / config_.cellSize)));
+    int windowSide = 2 * windowRadius_ + 1;
+    wordsPerSet_ = (windowSide * windowSide + 63) / 64;
+    bits_.assign(static_cast<std::size_t>(width_) * height_ * 2 * wordsPerSet_, 0);
+
+    std::vector<std::uint8_t> blocked(solid.size(), 0);
+    for (int y = 0; y < gridHeight; ++y) {
+        for (int x = 0; x < gridWidth; ++x) {
+            blocked[static_cast<std::size_t>(y) * gridWidth + x] = occupancy.isBlocked(x, y) ? 1 : 0;
+        }
+    }
+    const GridCounts blockedCounts(blocked, gridWidth, gridHeight);
+    const GridCounts solidCounts(solid, gridWidth, gridHeight);
+    std::vector<int> visited;
+    std::vector<sf::Vector2i> frontier;
+
+    // Visibility is symmetric: classify each unordered pair once, store both directions
+    int visiblePairs = 0;
+    int hiddenPairs = 0;
+    for (int ay = 0; ay < height_; ++ay) {
+        for (int ax = 0; ax < width_; ++ax) {
+            int a = ay * width_ + ax;
+            const CellSpan spanA = blockSpan(ax, ay, block, gridWidth, gridHeight);
+
+            for (int dy = 0; dy <= windowRadius_; ++dy) {
+                for (int dx = -windowRadius_; dx <= windowRadius_; ++dx) {
+                    if (dy == 0 && dx < 0) continue;
+                    int bx = ax + dx;
+                    int by = ay + dy;
+                    if (bx < 0 || by >= height_ || bx >= width_) continue;
+                    int b = by * width_ + bx;
+                    const CellSpan spanB = blockSpan(bx, by, block, gridWidth, gridHeight);
+
+                    const std::vector<Point> hull = pairHull(spanA, spanB);
+                    // The hull lies inside the union box grown by one cell; only cells there can touch it
+                    CellSpan box{std::max(0, std::min(spanA.x0, spanB.x0) - 1),
+                                 std::max(0, std::min(spanA.y0, spanB.y0) - 1),
+                                 std::min(gridWidth - 1, std::max(spanA.x1, spanB.x1) + 1),
+                                 std::min(gridHeight - 1, std::max(spanA.y1, spanB.y1) + 1)};
+
+                    int set = -1;
+                    if (!anyCellTouchesHull(blocked, blockedCounts, gridWidth, box, hull)) {
+                        set = kVisibleSet;
+                        ++visiblePairs;
+                    } else if (solidCounts.count(box) > 0 &&
+                               !freeCorridorConnects(solid, gridWidth, box, hull, spanA, spanB, visited, frontier)) {
+                        set = kHiddenSet;
+                        ++hiddenPairs;
+                    }
+                    if (set < 0) continue;
+                    setBit(a, set, windowBit(dx, dy));
+                    setBit(b, set, windowBit(-dx, -dy));
+                }
+            }
+        }
+    }
+
+    core::Logger::instance().info("[AI] VisibilityTable built " + std::to_string(width_) + "x" +
+                                  std::to_string(height_) + " cells, " + std::to_string(visiblePairs) +
+                                  " visible / " + std::to_string(hiddenPairs) + " hidden pairs, " +
+                                  std::to_string(memoryBytes()) + " bytes");
+}
+
+void VisibilityTable::clear() {
+    width_ = 0;
+    height_ = 0;
+    windowRadius_ = 0;
+    wordsPerSet_ = 0;
+    signature_ = 0;
+    bits_.clear();
+}
+
+std::uint64_t VisibilityTable::occupancySignature(const NavGrid& occupancy, const std::vector<std::uint8_t>& solid) {
+    // FNV-1a over the grid layout, the blocked bitmap and the solid mask, if any
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    const auto& bounds = occupancy.getConfig().bounds;
+    mix(static_cast<std::uint64_t>(occupancy.width()));
+    mix(static_cast<std::uint64_t>(occupancy.height()));
+    mix(static_cast<std::uint64_t>(std::lround(occupancy.cellSize() * 1000.0f)));
+    mix(static_cast<std::uint64_t>(std::llround(bounds.position.x * 1000.0f)));
+    mix(static_cast<std::uint64_t>(std::llround(bounds.position.y * 1000.0f)));
+    for (int y = 0; y < occupancy.height(); ++y) {
+        for (int x = 0; x < occupancy.width(); ++x) {
+            hash ^= occupancy.isBlocked(x, y) ? 1u : 0u;
+            hash *= 1099511628211ull;
+        }
+    }
+    for (std::uint8_t cell : solid) {
+        hash ^= cell;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool VisibilityTable::cellOf(const sf::Vector2f& position, int& x, int& y) const {
+    sf::Vector2f local = position - config_.bounds.position;
+    // Cells past the bounds are outside the occupancy grid the table was proven on
+    if (local.x < 0.0f || local.y < 0.0f || local.x >= config_.bounds.size.x || local.y >= config_.bounds.size.y) {
+        return false;
+    }
+    x = static_cast<int>(local.x / config_.cellSize);
+    y = static_cast<int>(local.y / config_.cellSize);
+    return x < width_ && y < height_;
+}
+
+void VisibilityTable::setBit(int cell, int set, int bit) {
+    std::size_t word = (static_cast<std::size_t>(cell) * 2 + set) * wordsPerSet_ + bit / 64;
+    bits_[word] |= std::uint64_t(1) << (bit % 64);
+}
+
+bool VisibilityTable::testBit(int cell, int set, int bit) const {
+    std::size_t word = (static_cast<std::size_t>(cell) * 2 + set) * wordsPerSet_ + bit / 64;
+    return (bits_[word] >> (bit % 64)) & 1u;
+}
+
+VisibilityTable::Visibility VisibilityTable::query(const sf::Vector2f& from, const sf::Vector2f& to) const {
+    if (empty()) return Visibility::Unknown;
+    int ax, ay, bx, by;
+    if (!cellOf(from, ax, ay) || !cellOf(to, bx, by)) return Visibility::Unknown;
+    int dx = bx - ax;
+    int dy = by - ay;
+    if (std::abs(dx) > windowRadius_ || std::abs(dy) > windowRadius_) return Visibility::Unknown;
+
+    int cell = ay * width_ + ax;
+    int bit = windowBit(dx, dy);
+    if (testBit(cell, kVisibleSet, bit)) return Visibility::Visible;
+    if (testBit(cell, kHiddenSet, bit)) return Visibility::Hidden;
+    return Visibility::Unknown;
+}
+
+bool VisibilityTable::hasLineOfSight(const sf::Vector2f& from, const sf::Vector2f& to,
+                                     const collisions::CollisionManager* collisionManager,
+                                     entities::Entity* exclude, std::uint32_t layerMask) const {
+    std::uint32_t mask = layerMask;
+    if (layerMask & config_.staticLayerMask) {
+        Visibility visibility = query(from, to);
+        if (visibility == Visibility::Hidden) return false;
+        if (visibility == Visibility::Visible) {
+            // Static geometry already cleared; only dynamic blockers remain
+            mask &= ~config_.staticLayerMask;
+            if (mask == 0) return true;
+        }
+    }
+    if (!collisionManager) return true;
+    return !collisionManager->segmentIntersectsAny(from, to, exclude, mask);
+}
+
+std::string VisibilityTable::serialize() const {
+    json j;
+    j["version"] = kSerializationVersion;
+    j["cellSize"] = config_.cellSize;
+    j["sampleCellSize"] = config_.sampleCellSize;
+    j["maxDistance"] = config_.maxDistance;
+    j["bounds"] = {config_.bounds.position.x, config_.bounds.position.y,
+                   config_.bounds.size.x, config_.bounds.size.y};
+    j["staticLayerMask"] = config_.staticLayerMask;
+    j["width"] = width_;
+    j["height"] = height_;
+    j["windowRadius"] = windowRadius_;
+    j["signature"] = signature_;
+    j["bits"] = bits_;
+    return j.dump();
+}
+
+bool VisibilityTable::deserialize(const std::string& data) {
+    try {
+        json j = json::parse(data);
+        if (j.value("version", 0) != kSerializationVersion) {
+            core::Logger::instance().warning("[AI] VisibilityTable: unsupported table version");
+            return false;
+        }
+
+        VisibilityTableConfig config;
+        config.cellSize = j.at("cellSize").get<float>();
+        config.sampleCellSize = j.at("sampleCellSize").get<float>();
+        config.maxDistance = j.at("maxDistance").get<float>();
+        const auto& bounds = j.at("bounds");
+        config.bounds = sf::FloatRect({bounds.at(0).get<float>(), bounds.at(1).get<float>()},
+                                      {bounds.at(2).get<float>(), bounds.at(3).get<float>()});
+        config.staticLayerMask = j.at("staticLayerMask").get<std::uint32_t>();
+
+        int width = j.at("width").get<int>();
+        int height = j.at("height").get<int>();
+        int windowRadius = j.at("windowRadius").get<int>();
+        int windowSide = 2 * windowRadius + 1;
+        int wordsPerSet = (windowSide * windowSide + 63) / 64;
+        auto bits = j.at("bits").get<std::vector<std::uint64_t>>();
+        if (width < 0 || height < 0 || windowRadius < 0 || config.cellSize <= 0.0f ||
+            bits.size() != static_cast<std::size_t>(width) * height * 2 * wordsPerSet) {
+            core::Logger::instance().warning("[AI] VisibilityTable: table size mismatch");
+            return false;
+        }
+
+        config_ = config;
+        width_ = width;
+        height_ = height;
+        windowRadius_ = windowRadius;
+        wordsPerSet_ = wordsPerSet;
+        signature_ = j.at("signature").get<std::uint64_t>();
+        bits_ = std::move(bits);
+        return true;
+    } catch (const std::exception& ex) {
+        core::Logger::instance().error(std::string("[AI] VisibilityTable: failed to parse table: ") + ex.what());
+        return false;
+    }
+}
+
+bool VisibilityTable::saveToFile(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.good()) {
+        core::Logger::instance().error("[AI] VisibilityTable: failed to open for writing: " + path);
+        return false;
+    }
+    out << serialize();
+    core::Logger::instance().info("[AI] VisibilityTable saved to " + path);
+    return true;
+}
+
+bool VisibilityTable::loadFromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.good()) {
+        core::Logger::instance().warning("[AI] VisibilityTable: file not found: " + path);
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!deserialize(data)) return false;
+
+    core::Logger::instance().info("[AI] VisibilityTable loaded from " + path + " (" +
+                                  std::to_string(width_) + "x" + std::to_string(height_) + " cells)");
+    return true;
+}
+
+} // namespace ai
@@ -0,0 +1,103 @@
+#ifndef ABYSSAL_STATION_SRC_AI_VISIBILITYTABLE_H
+#define ABYSSAL_STATION_SRC_AI_VISIBILITYTABLE_H
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "entities/Entity.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace collisions { class CollisionManager; }
+
+namespace ai {
+
+class NavGrid;
+
+// Configuration for the static potentially-visible-set table
+struct VisibilityTableConfig {
+    float cellSize = 64.0f;                     // Coarse PVS cell
+    float sampleCellSize = 16.0f;               // Occupancy resolution of the sample rays
+    float maxDistance = 320.0f;                 // Longer pairs are not stored (raycast fallback)
+    sf::FloatRect bounds{{0.f, 0.f}, {2048.f, 2048.f}};
+    std::uint32_t staticLayerMask = entities::kLayerMaskWall; // Geometry baked into the table
+};
+
+// Cell-to-cell line of sight through static geometry, baked at level load.
+// Each coarse cell stores two bitsets over the window of cells within
+// maxDistance, kept as plain uint64 words (no compression). Both answers are
+// proven for every segment between the two cells, not sampled:
+//  - Visible: no blocked occupancy cell touches the convex hull of the two
+//    cells. Occupancy marks every cell a wall overlaps, so no wall does either.
+//  - Hidden: the free cells inside that hull do not connect the two cells,
+//    counting only cells wholly covered by one wall as closed. Any segment
+//    between them has to cross such a cell, i.e. the wall itself.
+// Everything else, and pairs outside the window, is Unknown and falls back to
+// a full raycast. build(NavGrid) has no wall shapes, so it treats the
+// occupancy grid as exact and uses blocked cells for both tests.
+class VisibilityTable {
+public:
+    enum class Visibility : std::uint8_t { Unknown, Visible, Hidden };
+
+    explicit VisibilityTable(const VisibilityTableConfig& config = VisibilityTableConfig{});
+
+    void build(const collisions::CollisionManager* collisionManager);
+    void build(const collisions::CollisionManager* collisionManager, const VisibilityTableConfig& config);
+    void build(const NavGrid& occupancy); // Occupancy cell size is used as the sample size
+    void clear();
+
+    // Cached tables; signature() identifies the static geometry they were built from
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+    std::string serialize() const;
+    bool deserialize(const std::string& data);
+    std::uint64_t signature() const { return signature_; }
+    // solid, when given, is the wholly-covered mask build(CollisionManager) proves Hidden with
+    static std::uint64_t occupancySignature(const NavGrid& occupancy, const std::vector<std::uint8_t>& solid = {});
+    // Signature build(collisionManager) would give for config
+    static std::uint64_t geometrySignature(const collisions::CollisionManager* collisionManager,
+                                           const VisibilityTableConfig& config);
+    // True when this table was built with config's settings from the same
+    // geometry, so a cached copy can stand in for a rebuild
+    bool isCurrent(const collisions::CollisionManager* collisionManager, const VisibilityTableConfig& config) const;
+
+    Visibility query(const sf::Vector2f& from, const sf::Vector2f& to) const;
+
+    // Table-first sight test: Hidden skips the raycast, Visible only casts
+    // against layers outside staticLayerMask, Unknown casts against everything
+    bool hasLineOfSight(const sf::Vector2f& from, const sf::Vector2f& to,
+                        const collisions::CollisionManager* collisionManager,
+                        entities::Entity* exclude, std::uint32_t layerMask) const;
+
+    bool empty() const { return width_ == 0 || height_ == 0; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int windowRadius() const { return windowRadius_; }
+    std::size_t memoryBytes() const { return bits_.size() * sizeof(std::uint64_t); }
+    const VisibilityTableConfig& getConfig() const { return config_; }
+
+private:
+    VisibilityTableConfig config_;
+    int width_;
+    int height_;
+    int windowRadius_;
+    int wordsPerSet_;              // 64-bit words per window bitset
+    std::uint64_t signature_;
+
+    // Per cell: visible bitset followed by hidden bitset, wordsPerSet_ words each
+    std::vector<std::uint64_t> bits_;
+
+    // solid: occupancy cells wholly covered by static geometry (proves Hidden)
+    void build(const NavGrid& occupancy, const std::vector<std::uint8_t>& solid);
+    static void sampleGeometry(const collisions::CollisionManager* collisionManager,
+                               const VisibilityTableConfig& config, NavGrid& occupancy,
+                               std::vector<std::uint8_t>& solid);
+    bool cellOf(const sf::Vector2f& position, int& x, int& y) const;
+    int windowBit(int dx, int dy) const { return (dy + windowRadius_) * (2 * windowRadius_ + 1) + dx + windowRadius_; }
+    void setBit(int cell, int set, int bit);
+    bool testBit(int cell, int set, int bit) const;
+};
+
+} // namespace ai
+
+#endif // ABYSSAL_STATION_SRC_AI_VISIBILITYTABLE_H
@@ -89,6 +89,36 @@ void CollisionManager::updateColliderBounds(entities::Entity* owner, const sf::F
     addCollider(owner, bounds);
 }
 
+void CollisionManager::updateColliderBoundsBatch(const std::vector<std::pair<entities::Entity*, sf::FloatRect>>& updates) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::unordered_map<const entities::Entity*, std::size_t> index;
+    index.reserve(colliders_.size());
+    for (std::size_t i = 0; i < colliders_.size(); ++i) {
+        index.emplace(colliders_[i].owner(), i);
+    }
+
+    for (const auto& [owner, bounds] : updates) {
+        if (!owner) continue;
+        auto it = index.find(owner);
+        if (it != index.end()) {
+            colliders_[it->second].setBounds(bounds);
+            colliders_[it->second].setLayer(owner->collisionLayer());
+        } else {
+            colliders_.emplace_back(owner, bounds);
+            colliders_.back().setLayer(owner->collisionLayer());
+            colliders_.back().setDynamicResize(true);
+            index.emplace(owner, colliders_.size() - 1);
+        }
+    }
+    updateSpatialPartition();
+
+    if (config_.enableProfiling) {
+        auto endTime = std::chrono::high_resolution_clock::now();
+        profileData_.totalTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+    }
+}
+
 void CollisionManager::removeCollider(entities::Entity* owner) {
     if (!owner) return;
     
@@ -253,6 +283,35 @@ entities::Entity* CollisionManager::firstColliderForBounds(const sf::FloatRect&
     return nullptr;
 }
 
+void CollisionManager::queryBounds(const sf::FloatRect& region, std::vector<const CollisionBox*>& out,
+                                   std::uint32_t allowedLayers) const {
+    out.clear();
+    auto keep = [&region, allowedLayers](const CollisionBox& cb) {
+        if (allowedLayers != 0xFFFFFFFFu && (cb.layer() & allowedLayers) == 0) return false;
+        return region.findIntersection(cb.getBounds()).has_value();
+    };
+
+    if (spatialPartition_) {
+        for (const auto* cb : spatialPartition_->query(region)) {
+            if (keep(*cb)) out.push_back(cb);
+        }
+    } else {
+        for (const auto& cb : colliders_) {
+            if (keep(cb)) out.push_back(&cb);
+        }
+    }
+}
+
+std::vector<sf::FloatRect> CollisionManager::collectBounds(std::uint32_t allowedLayers) const {
+    std::vector<sf::FloatRect> result;
+    for (const auto& cb : colliders_) {
+        if (allowedLayers != 0xFFFFFFFFu && (cb.layer() & allowedLayers) == 0) continue;
+        auto bounds = cb.getAllBounds();
+        result.insert(result.end(), bounds.begin(), bounds.end());
+    }
+    return result;
+}
+
 RaycastHit CollisionManager::raycast(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance, 
                                     entities::Entity* exclude, std::uint32_t allowedLayers) const {
     sf::Vector2f endPoint = origin + direction * maxDistance;
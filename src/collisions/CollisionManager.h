@@ -58,6 +58,9 @@ public:
     // Update collider bounds for an entity if it exists, otherwise add it
     void updateColliderBounds(entities::Entity* owner, const sf::FloatRect& bounds);
 
+    // Update many colliders (adding missing ones) and rebuild the spatial partition once
+    void updateColliderBoundsBatch(const std::vector<std::pair<entities::Entity*, sf::FloatRect>>& updates);
+
     // Remove collider for an entity
     void removeCollider(entities::Entity* owner);
 
@@ -75,6 +78,13 @@ public:
     // If allowedLayers != 0, only colliders whose layer bit intersects allowedLayers are considered
     entities::Entity* firstColliderForBounds(const sf::FloatRect& bounds, entities::Entity* exclude = nullptr, std::uint32_t allowedLayers = 0xFFFFFFFFu) const;
 
+    // Colliders overlapping region whose layer intersects allowedLayers, from one broad-phase query
+    void queryBounds(const sf::FloatRect& region, std::vector<const CollisionBox*>& out,
+                     std::uint32_t allowedLayers = 0xFFFFFFFFu) const;
+
+    // Bounds of every collider whose layer intersects allowedLayers (e.g. static walls for navmesh baking)
+    std::vector<sf::FloatRect> collectBounds(std::uint32_t allowedLayers = 0xFFFFFFFFu) const;
+
     // Enhanced raycast with hit information
     RaycastHit raycast(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance = 1000.f, 
                       entities::Entity* exclude = nullptr, std::uint32_t allowedLayers = 0xFFFFFFFFu) const;
@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace core {
+
+ThreadPool::ThreadPool(std::size_t workerCount)
+    : stopping_(false)
+    , body_(nullptr)
+    , count_(0)
+    , chunk_(1)
+    , next_(0)
+    , generation_(0)
+    , activeWorkers_(0)
+{
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::defaultWorkerCount() {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body,
+                             std::size_t minChunk) {
+    if (count == 0) return;
+
+    // Roughly four chunks per thread keeps uneven work balanced
+    std::size_t threads = workers_.size() + 1;
+    std::size_t chunk = std::max(std::max<std::size_t>(1, minChunk), count / (threads * 4));
+    if (workers_.empty() || count <= chunk) {
+        body(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        chunk_ = chunk;
+        next_.store(0, std::memory_order_relaxed);
+        error_ = nullptr;
+        activeWorkers_ = workers_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runChunks();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return activeWorkers_ == 0; });
+        body_ = nullptr;
+        error = error_;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::runChunks() {
+    for (;;) {
+        std::size_t begin = next_.fetch_add(chunk_, std::memory_order_relaxed);
+        if (begin >= count_) return;
+        std::size_t end = std::min(begin + chunk_, count_);
+        try {
+            (*body_)(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    std::size_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seenGeneration] { return stopping_ || generation_ != seenGeneration; });
+            if (stopping_) return;
+            seenGeneration = generation_;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--activeWorkers_ == 0) done_.notify_one();
+        }
+    }
+}
+
+} // namespace core
@@ -0,0 +1,60 @@
+#ifndef ABYSSAL_STATION_SRC_CORE_THREADPOOL_H
+#define ABYSSAL_STATION_SRC_CORE_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+// Fixed set of worker threads for data-parallel loops. parallelFor splits
+// [0, count) into chunks claimed from a shared counter; the calling thread
+// works on chunks too and the call returns once every chunk has finished.
+// With zero workers everything runs inline on the caller.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t workerCount);
+    ~ThreadPool();
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Calls body(begin, end) over disjoint ranges covering [0, count).
+    // The first exception thrown by a chunk is rethrown on the caller.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body,
+                     std::size_t minChunk = 1);
+
+    std::size_t workerCount() const noexcept { return workers_.size(); }
+
+    // hardware_concurrency() - 1, never negative (the caller is the extra thread)
+    static std::size_t defaultWorkerCount();
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stopping_;
+
+    // Current job, published under mutex_ with a new generation
+    const std::function<void(std::size_t, std::size_t)>* body_;
+    std::size_t count_;
+    std::size_t chunk_;
+    std::atomic<std::size_t> next_;
+    std::size_t generation_;
+    std::size_t activeWorkers_;
+    std::exception_ptr error_;
+
+    void workerLoop();
+    void runChunks();
+};
+
+} // namespace core
+
+#endif // ABYSSAL_STATION_SRC_CORE_THREADPOOL_H
@@ -31,6 +31,13 @@ bool EntityDebug::loadFont(const std::string& fontPath) {
     return false;
 }
 
+void EntityDebug::setFont(const sf::Font& font) {
+    font_ = font;
+    hasFont_ = true;
+    debugText_ = std::make_unique<sf::Text>(font_, "", static_cast<unsigned int>(config_.textSize));
+    debugText_->setFillColor(config_.textColor);
+}
+
 void EntityDebug::renderEntityDebug(sf::RenderWindow& window, Entity* entity) {
     if (!enabled_ || !entity) return;
 
@@ -82,14 +89,44 @@ void EntityDebug::renderPerformanceOverlay(sf::RenderWindow& window, EntityManag
     ss << "Render Time: " << stats.lastRenderTime << "ms";
 
     debugText_->setString(ss.str());
-    debugText_->setPosition(overlayPos);
     debugText_->setCharacterSize(14);
     debugText_->setFillColor(sf::Color::Yellow);
+    drawOverlayText(window, overlayPos);
+}
+
+void EntityDebug::renderTextOverlay(sf::RenderWindow& window, const std::string& title,
+                                    const std::vector<std::string>& lines) {
+    if (!hasFont_ || !debugText_) return;
+
+    auto view = window.getView();
+    auto viewSize = view.getSize();
+    auto viewCenter = view.getCenter();
+
+    // Top-left corner; the entity performance overlay uses the top-right
+    sf::Vector2f overlayPos(
+        viewCenter.x - viewSize.x * 0.5f + 10.f,
+        viewCenter.y - viewSize.y * 0.5f + 10.f
+    );
+
+    std::stringstream ss;
+    ss << title;
+    for (const auto& line : lines) {
+        ss << "\n" << line;
+    }
+
+    debugText_->setString(ss.str());
+    debugText_->setCharacterSize(12);
+    debugText_->setFillColor(sf::Color::Cyan);
+    drawOverlayText(window, overlayPos);
+}
+
+void EntityDebug::drawOverlayText(sf::RenderWindow& window, const sf::Vector2f& position) {
+    debugText_->setPosition(position);
 
     // Draw background
     sf::FloatRect textBounds = debugText_->getLocalBounds();
     sf::RectangleShape background;
-    background.setPosition(overlayPos);
+    background.setPosition(position);
     background.setSize({textBounds.size.x + 10.f, textBounds.size.y + 10.f});
     background.setFillColor(sf::Color(0, 0, 0, 150));
     window.draw(background);
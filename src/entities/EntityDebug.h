@@ -5,6 +5,7 @@
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -54,10 +55,13 @@ public:
     void renderEntityDebug(sf::RenderWindow& window, Entity* entity);
     void renderManagerDebug(sf::RenderWindow& window, EntityManager* manager);
     void renderPerformanceOverlay(sf::RenderWindow& window, EntityManager* manager);
+    // Titled list in the top-left corner, for other systems' stats (e.g. the AI's slowest agents)
+    void renderTextOverlay(sf::RenderWindow& window, const std::string& title, const std::vector<std::string>& lines);
 
     // Font management
     bool loadFont(const std::string& fontPath);
-    void setFont(const sf::Font& font) { font_ = font; hasFont_ = true; }
+    void setFont(const sf::Font& font);
+    bool hasFont() const { return hasFont_; }
 
 private:
     DebugConfig config_;
@@ -70,6 +74,7 @@ private:
     // Helper methods
     void renderBounds(sf::RenderWindow& window, Entity* entity);
     void renderEntityInfo(sf::RenderWindow& window, Entity* entity);
+    void drawOverlayText(sf::RenderWindow& window, const sf::Vector2f& position);
     std::string getCollisionLayerName(std::uint32_t layer) const;
     sf::Color getLayerColor(std::uint32_t layer) const;
 };
@@ -1,5 +1,6 @@
 #include "EntityManager.h"
 #include <algorithm>
+#include <cmath>
 #include <chrono>
 #include "../core/Logger.h"
 #include "../collisions/CollisionManager.h"
@@ -14,6 +15,7 @@ void EntityManager::addEntity(std::unique_ptr<Entity> entity) {
     // Keep pointer to newly added entity so we can register collider after moving into container
     Entity* raw = entity.get();
     entities_.push_back(std::move(entity));
+    spatialIndexDirty_ = true;
 
     // Register collider if collision manager is set
     if (collisionManager_ && raw) {
@@ -36,6 +38,7 @@ bool EntityManager::removeEntity(Entity::Id id) {
     // If collision manager is set, remove collider for this entity
     if (collisionManager_) collisionManager_->removeCollider(it->get());
     entities_.erase(it);
+    spatialIndexDirty_ = true;
     return true;
 }
 
@@ -69,6 +72,8 @@ void EntityManager::updateAll(float deltaTime) {
         }
     }
     
+    spatialIndexDirty_ = true;
+    
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     
@@ -171,6 +176,7 @@ void EntityManager::clearAllEntities() {
     std::size_t count = entities_.size();
     entities_.clear();
     markedForRemoval_.clear();
+    spatialIndexDirty_ = true;
     core::Logger::instance().info("[EntityManager] Cleared all " + std::to_string(count) + " entities");
 }
 
@@ -186,6 +192,103 @@ std::vector<Entity*> EntityManager::allEntities() const
     return out;
 }
 
+void EntityManager::setSpatialCellSize(float cellSize) {
+    if (cellSize > 0.f) {
+        spatialCellSize_ = cellSize;
+        spatialIndexDirty_ = true;
+    }
+}
+
+void EntityManager::rebuildSpatialIndex() const {
+    spatialIndexDirty_ = false;
+    if (entities_.empty()) {
+        spatialColumns_ = spatialRows_ = 0;
+        cellStart_.assign(1, 0);
+        cellEntities_.clear();
+        return;
+    }
+
+    sf::Vector2f minPos = entities_.front()->position();
+    sf::Vector2f maxPos = minPos;
+    for (const auto& e : entities_) {
+        const sf::Vector2f& p = e->position();
+        minPos.x = std::min(minPos.x, p.x);
+        minPos.y = std::min(minPos.y, p.y);
+        maxPos.x = std::max(maxPos.x, p.x);
+        maxPos.y = std::max(maxPos.y, p.y);
+    }
+
+    // Widen cells for sparse, far-flung worlds so the grid stays bounded
+    constexpr float kMaxCellsPerAxis = 512.f;
+    float extent = std::max(maxPos.x - minPos.x, maxPos.y - minPos.y);
+    spatialIndexCellSize_ = std::max(spatialCellSize_, extent / kMaxCellsPerAxis);
+    spatialOrigin_ = minPos;
+    spatialColumns_ = static_cast<int>((maxPos.x - minPos.x) / spatialIndexCellSize_) + 1;
+    spatialRows_ = static_cast<int>((maxPos.y - minPos.y) / spatialIndexCellSize_) + 1;
+
+    std::size_t cellCount = static_cast<std::size_t>(spatialColumns_) * spatialRows_;
+    cellStart_.assign(cellCount + 1, 0);
+    entityCell_.resize(entities_.size());
+    for (std::size_t i = 0; i < entities_.size(); ++i) {
+        const sf::Vector2f& p = entities_[i]->position();
+        int cx = std::min(static_cast<int>((p.x - minPos.x) / spatialIndexCellSize_), spatialColumns_ - 1);
+        int cy = std::min(static_cast<int>((p.y - minPos.y) / spatialIndexCellSize_), spatialRows_ - 1);
+        entityCell_[i] = cy * spatialColumns_ + cx;
+        ++cellStart_[entityCell_[i] + 1];
+    }
+    for (std::size_t c = 0; c < cellCount; ++c) {
+        cellStart_[c + 1] += cellStart_[c];
+    }
+    // Scatter using cellStart_ as write cursors, then shift the starts back
+    cellEntities_.resize(entities_.size());
+    for (std::size_t i = 0; i < entities_.size(); ++i) {
+        cellEntities_[cellStart_[entityCell_[i]]++] = entities_[i].get();
+    }
+    for (std::size_t c = cellCount; c > 0; --c) {
+        cellStart_[c] = cellStart_[c - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+void EntityManager::queryRadius(const sf::Vector2f& center, float radius, std::vector<Entity*>& out,
+                                const Entity* exclude) const {
+    out.clear();
+    if (radius < 0.f) return;
+    if (spatialIndexDirty_) rebuildSpatialIndex();
+    if (spatialColumns_ == 0) return;
+
+    auto toCell = [this](float value, float origin, int limit) {
+        int cell = static_cast<int>(std::floor((value - origin) / spatialIndexCellSize_));
+        return std::max(0, std::min(cell, limit - 1));
+    };
+    // Early out when the query circle misses the occupied area entirely
+    float maxX = spatialOrigin_.x + spatialColumns_ * spatialIndexCellSize_;
+    float maxY = spatialOrigin_.y + spatialRows_ * spatialIndexCellSize_;
+    if (center.x + radius < spatialOrigin_.x || center.y + radius < spatialOrigin_.y ||
+        center.x - radius > maxX || center.y - radius > maxY) {
+        return;
+    }
+
+    int x0 = toCell(center.x - radius, spatialOrigin_.x, spatialColumns_);
+    int x1 = toCell(center.x + radius, spatialOrigin_.x, spatialColumns_);
+    int y0 = toCell(center.y - radius, spatialOrigin_.y, spatialRows_);
+    int y1 = toCell(center.y + radius, spatialOrigin_.y, spatialRows_);
+    float radiusSquared = radius * radius;
+
+    for (int y = y0; y <= y1; ++y) {
+        int row = y * spatialColumns_;
+        for (int i = cellStart_[row + x0]; i < cellStart_[row + x1 + 1]; ++i) {
+            Entity* entity = cellEntities_[i];
+            if (entity == exclude) continue;
+            // Exact test against the live position (the cell is only a candidate filter)
+            sf::Vector2f delta = entity->position() - center;
+            if (delta.x * delta.x + delta.y * delta.y <= radiusSquared) {
+                out.push_back(entity);
+            }
+        }
+    }
+}
+
 auto EntityManager::findEntityById(Entity::Id id) const {
     return std::find_if(entities_.begin(), entities_.end(), [id](const std::unique_ptr<Entity>& e) {
         return e && e->id() == id;
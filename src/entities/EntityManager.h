@@ -43,6 +43,16 @@ public:
     std::vector<Entity*> allEntities() const;
     // Get entities by collision layer (for optimization)
     std::vector<Entity*> getEntitiesByLayer(Entity::Layer layer) const;
+    // Entities whose position lies within radius of center, written into out
+    // (cleared first). Backed by a uniform grid of entity positions that is
+    // rebuilt lazily after add/remove/update; call invalidateSpatialIndex()
+    // when entities are moved outside updateAll().
+    void queryRadius(const sf::Vector2f& center, float radius, std::vector<Entity*>& out,
+                     const Entity* exclude = nullptr) const;
+    void invalidateSpatialIndex() noexcept { spatialIndexDirty_ = true; }
+    // Rebuild now if dirty, so concurrent queryRadius() calls only read
+    void updateSpatialIndex() const { if (spatialIndexDirty_) rebuildSpatialIndex(); }
+    void setSpatialCellSize(float cellSize);
     // Get entities by type (using dynamic_cast)
     template<typename T>
     std::vector<T*> getEntitiesOfType() const;
@@ -74,6 +84,20 @@ private:
     std::vector<Entity::Id> markedForRemoval_;
     PerformanceStats performanceStats_;
 
+    // Position grid for radius queries: entities sorted by cell (counting
+    // sort), cellStart_[c]..cellStart_[c + 1] indexes the entities of cell c
+    float spatialCellSize_{128.f};
+    mutable bool spatialIndexDirty_{true};
+    mutable sf::Vector2f spatialOrigin_{0.f, 0.f};
+    mutable int spatialColumns_{0};
+    mutable int spatialRows_{0};
+    mutable float spatialIndexCellSize_{128.f};
+    mutable std::vector<int> cellStart_;
+    mutable std::vector<int> entityCell_;
+    mutable std::vector<Entity*> cellEntities_;
+
+    void rebuildSpatialIndex() const;
+
     // Helper to find entity iterator by id
     auto findEntityById(Entity::Id id) const;
 };
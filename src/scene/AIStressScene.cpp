@@ -0,0 +1,95 @@
+#include "AIStressScene.h"
+#include "SceneManager.h"
+#include "../core/Logger.h"
+#include "../core/FontHelper.h"
+#include "../entities/EntityDebug.h"
+#include "../entities/EntityManager.h"
+#include "../collisions/CollisionManager.h"
+#include "../ai/AIManager.h"
+#include <cstdio>
+
+namespace scene {
+
+using core::Logger;
+
+AIStressScene::AIStressScene(SceneManager* manager, const ai::StressScenarioConfig& config)
+    : m_manager(manager)
+    , m_config(config)
+{
+}
+
+AIStressScene::~AIStressScene() = default;
+
+void AIStressScene::onEnter()
+{
+    Logger::instance().info("AIStressScene: onEnter");
+    m_entityManager = std::make_unique<entities::EntityManager>();
+    m_collisionManager = std::make_unique<collisions::CollisionManager>();
+    // Fixed ticks seeded from the scenario, so runs compare across frame rates
+    ai::CoordinationConfig coordination;
+    coordination.deterministic.enabled = true;
+    coordination.deterministic.seed = m_config.seed;
+    m_aiManager = std::make_unique<ai::AIManager>(coordination);
+    m_scenario = std::make_unique<ai::StressScenario>(m_config);
+    m_scenario->populate(*m_entityManager, *m_collisionManager, *m_aiManager);
+    // Sight checks go through the baked table; the cache is rebuilt whenever the seed changes the walls
+    ai::VisibilityTableConfig visibility;
+    visibility.bounds = m_scenario->getBounds();
+    m_aiManager->buildVisibilityTable(m_collisionManager.get(), visibility, "ai_stress_visibility.json");
+
+    auto& debug = entities::getEntityDebugInstance();
+    if (!debug.hasFont()) {
+        debug.loadFont(core::findFontFile());
+    }
+}
+
+void AIStressScene::onExit()
+{
+    Logger::instance().info("AIStressScene: onExit");
+    // Agents hold entity pointers: drop them before the entities
+    m_aiManager.reset();
+    m_scenario.reset();
+    m_entityManager.reset();
+    m_collisionManager.reset();
+}
+
+void AIStressScene::handleEvent(sf::Event& event)
+{
+    if (auto kp = event.getIf<sf::Event::KeyPressed>()) {
+        if (kp->code == sf::Keyboard::Key::Escape && m_manager) {
+            m_manager->pop();
+        } else if (kp->code == sf::Keyboard::Key::F9 && m_aiManager) {
+            m_aiManager->writeAgentProfile("ai_profile.json");
+            char hash[64];
+            std::snprintf(hash, sizeof(hash), "step %llu state hash %016llx",
+                          static_cast<unsigned long long>(m_aiManager->getFixedStepClock().steps()),
+                          static_cast<unsigned long long>(m_aiManager->getStateHash()));
+            Logger::instance().info(std::string("AIStressScene: ") + hash);
+        }
+    }
+}
+
+void AIStressScene::update(float dt)
+{
+    if (!m_aiManager) return;
+    m_aiManager->updateAll(dt, m_entityManager.get(), m_collisionManager.get());
+}
+
+void AIStressScene::render(sf::RenderWindow& window)
+{
+    if (!m_entityManager || !m_scenario) return;
+    sf::View previous = window.getView();
+    window.setView(sf::View(m_scenario->getBounds()));
+    m_entityManager->renderAll(window);
+    window.setView(previous);
+
+    if (m_aiManager) {
+        std::vector<std::string> lines;
+        for (const auto& sample : m_aiManager->getAgentProfiler().getSlowest()) {
+            lines.push_back(ai::AgentProfiler::describe(sample));
+        }
+        entities::getEntityDebugInstance().renderTextOverlay(window, "Slowest AI agents (F9: ai_profile.json)", lines);
+    }
+}
+
+} // namespace scene
@@ -0,0 +1,42 @@
+#ifndef ABYSSAL_STATION_SRC_SCENE_AISTRESSSCENE_H
+#define ABYSSAL_STATION_SRC_SCENE_AISTRESSSCENE_H
+
+#include "Scene.h"
+#include "../ai/StressScenario.h"
+#include <SFML/Graphics.hpp>
+#include <memory>
+
+namespace scene { class SceneManager; }
+namespace entities { class EntityManager; }
+namespace collisions { class CollisionManager; }
+namespace ai { class AIManager; }
+
+namespace scene {
+
+// Debug scene: a generated StressScenario run by the AIManager, with the
+// whole map in view and the slowest agent ticks in the debug overlay. F9
+// writes them to ai_profile.json; Escape leaves the scene.
+class AIStressScene : public Scene {
+public:
+    AIStressScene(SceneManager* manager, const ai::StressScenarioConfig& config = ai::StressScenarioConfig{});
+    ~AIStressScene() override;
+
+    void handleEvent(sf::Event& event) override;
+    void update(float dt) override;
+    void render(sf::RenderWindow& window) override;
+
+    void onEnter() override;
+    void onExit() override;
+
+private:
+    SceneManager* m_manager{nullptr};
+    ai::StressScenarioConfig m_config;
+    std::unique_ptr<entities::EntityManager> m_entityManager;
+    std::unique_ptr<collisions::CollisionManager> m_collisionManager;
+    std::unique_ptr<ai::AIManager> m_aiManager;
+    std::unique_ptr<ai::StressScenario> m_scenario;
+};
+
+} // namespace scene
+
+#endif // ABYSSAL_STATION_SRC_SCENE_AISTRESSSCENE_H
@@ -2,6 +2,7 @@
 #include "SceneManager.h"
 #include "PlayScene.h"
 #include "LoadingScene.h"
+#include "AIStressScene.h"
 #include "../core/Logger.h"
 #include "../core/FontHelper.h"
 
@@ -86,6 +87,10 @@ void MenuScene::handleEvent(sf::Event& event) {
             if (kp->code == sf::Keyboard::Key::Escape) {
                 Logger::instance().info("MenuScene: Escape pressed -> popping scene");
                 if (m_manager) m_manager->pop();
+            } else if (kp->code == sf::Keyboard::Key::F8) {
+                // Debug entry: AI stress scenario with the default population
+                Logger::instance().info("MenuScene: F8 pressed -> AIStressScene");
+                if (m_manager) m_manager->push(std::make_unique<scene::AIStressScene>(m_manager));
             }
         }
     }
@@ -9,6 +9,7 @@
 #include "../entities/Player.h"
 #include "../entities/Wall.h"
 #include "../entities/EntityFactory.h"
+#include "../entities/EntityDebug.h"
 #include "../ai/Enemy.h"
 #include "../collisions/CollisionManager.h"
 #include "../collisions/CollisionSystem.h"
@@ -196,14 +197,17 @@ void PlayScene::onEnter() {
     ai::Enemy* enemy4Ptr = enemy4.get();
     m_entityManager->addEntity(std::move(enemy4));
     
-    // Create EnemyManager and register all enemies for centralized planning
-    m_enemyManager = std::make_unique<ai::EnemyManager>();
+    // Register all enemies with the AI manager, which runs them as one pipeline stage
+    m_aiManager = std::make_unique<ai::AIManager>();
+    m_aiManager->setPlayer(m_player);
     if (auto e1 = dynamic_cast<ai::Enemy*>(m_entityManager->getEntity(3u))) {
-        m_enemyManager->addEnemyPointer(e1);
+        m_aiManager->addEnemyPointer(e1);
     }
-    m_enemyManager->addEnemyPointer(enemy2Ptr);
-    m_enemyManager->addEnemyPointer(enemy3Ptr);
-    m_enemyManager->addEnemyPointer(enemy4Ptr);
+    m_aiManager->addEnemyPointer(enemy2Ptr);
+    m_aiManager->addEnemyPointer(enemy3Ptr);
+    m_aiManager->addEnemyPointer(enemy4Ptr);
+    // Static sight table over the walls above, loaded from disk while the layout is unchanged
+    m_aiManager->buildVisibilityTable(m_collisionManager.get(), ai::VisibilityTableConfig{}, "visibility_table.json");
     
     Logger::instance().info("PlayScene: Created entities using Factory Pattern with configurations");
 
@@ -385,8 +389,8 @@ void PlayScene::onEnter() {
 
     // --- Spawn an item for each enemy automatically ---
     uint32_t spawnItemId = 200;
-    if (m_enemyManager) {
-        for (auto enemyPtr : m_enemyManager->enemies()) {
+    if (m_aiManager) {
+        for (auto enemyPtr : m_aiManager->getEnemyPipeline().enemies()) {
             if (!enemyPtr) continue;
             sf::Vector2f spawnPos = enemyPtr->position();
             auto it = std::make_unique<gameplay::Item>(spawnItemId++, spawnPos, sf::Vector2f(16.f, 16.f), gameplay::ItemType::Collectible, m_collisionManager.get());
@@ -413,6 +417,14 @@ void PlayScene::handleEvent(sf::Event& event) {
                 } else if (m_uiManager) {
                     m_uiManager->pushMenu(new ui::PauseMenu(m_manager, m_uiManager.get()));
                 }
+            } else if (kp->code == sf::Keyboard::Key::F3) {
+                m_showAIProfile = !m_showAIProfile;
+                auto& debug = entities::getEntityDebugInstance();
+                if (m_showAIProfile && !debug.hasFont()) {
+                    debug.loadFont(core::findFontFile());
+                }
+            } else if (kp->code == sf::Keyboard::Key::F9 && m_aiManager) {
+                m_aiManager->writeAgentProfile("ai_profile.json");
             }
         }
     }
@@ -487,17 +499,13 @@ void PlayScene::update(float dt) {
         m_collisionSystem->resolve(m_player, dt);
     }
 
-    // Centralized enemy planning & commit via EnemyManager
-    if (m_enemyManager) {
-        // Run FSM updates for all enemies
-        if (m_player) m_enemyManager->updateAll(dt, m_player->position());
-        // Plan movement (collision-aware)
-        m_enemyManager->planAllMovement(dt, m_collisionManager.get());
-        // Commit moves after collision checks
-        m_enemyManager->commitAllMoves(m_collisionManager.get());
+    // AI pipeline (sense -> decide -> plan -> steer -> commit), once per frame.
+    // Registered enemies skip their own tick in EntityManager::updateAll.
+    if (m_aiManager) {
+        m_aiManager->updateAll(dt, m_entityManager.get(), m_collisionManager.get());
         // Resolve residual collisions for each enemy
         if (m_collisionSystem) {
-            for (auto& ep : m_enemyManager->enemies()) {
+            for (auto ep : m_aiManager->getEnemyPipeline().enemies()) {
                 if (ep) m_collisionSystem->resolve(ep, dt);
             }
         }
@@ -570,6 +578,15 @@ void PlayScene::render(sf::RenderWindow& window) {
     if (m_itemManager) m_itemManager->renderAll(window);
     if (m_puzzleManager) m_puzzleManager->renderAll(window);
 
+    if (m_showAIProfile && m_aiManager) {
+        std::vector<std::string> lines;
+        for (const auto& sample : m_aiManager->getAgentProfiler().getSlowest()) {
+            lines.push_back(ai::AgentProfiler::describe(sample));
+        }
+        if (lines.empty()) lines.push_back("no agent ticks recorded");
+        entities::getEntityDebugInstance().renderTextOverlay(window, "Slowest AI agents (F9: ai_profile.json)", lines);
+    }
+
     // Render menus on top
     if (m_uiManager) m_uiManager->render(window);
 
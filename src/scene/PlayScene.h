@@ -3,7 +3,7 @@
 
 #include "Scene.h"
 #include <SFML/Graphics.hpp>
-#include "../ai/EnemyManager.h"
+#include "../ai/AIManager.h"
 #include "../gameplay/ItemManager.h"
 #include "../gameplay/PuzzleManager.h"
 #include "../gameplay/AchievementManager.h"
@@ -41,8 +41,10 @@ private:
     std::unique_ptr<collisions::CollisionSystem> m_collisionSystem;
     // keep a raw pointer to player if needed
     entities::Player* m_player{nullptr};
-    // Enemy manager for AI planning
-    std::unique_ptr<ai::EnemyManager> m_enemyManager;
+    // AI manager: sole owner of the enemy pipeline
+    std::unique_ptr<ai::AIManager> m_aiManager;
+    // F3 shows the slowest agent ticks in the debug overlay; F9 writes them to ai_profile.json
+    bool m_showAIProfile{false};
     // Gameplay managers
     std::unique_ptr<gameplay::ItemManager> m_itemManager;
     std::unique_ptr<gameplay::PuzzleManager> m_puzzleManager;
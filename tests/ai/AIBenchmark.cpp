@@ -0,0 +1,287 @@
+// Headless AI benchmark: a seeded StressScenario stepped through
+// AIManager::updateAll for a fixed number of frames at 60 Hz, no window.
+// Not registered with CTest; run manually and diff the CSV between builds.
+//
+//   AIBenchmark [--quick] [--agents N[,N...]] [--frames K] [--seed S] [--threads T] [--csv results.csv]
+//
+// Stage columns are mean / max milliseconds per frame from
+// AIManager::PerformanceMetrics; the first frames (nav and cache warm-up) are
+// not measured. The AI runs in deterministic mode with one fixed tick per
+// frame, so the final state hash must not change between builds unless
+// behavior did. Peak memory is the process high-water mark, so agent counts
+// run in ascending order.
+
+#include "ai/AIManager.h"
+#include "ai/StressScenario.h"
+#include "collisions/CollisionManager.h"
+#include "entities/EntityManager.h"
+#include "entities/Player.h"
+#include "core/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Global allocation counter (every operator new in the process goes through here)
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr float kFrameTime = 1.0f / 60.0f;
+constexpr int kWarmupFrames = 10;
+
+// Peak resident set in MiB, or a negative value when the platform gives none
+double peakMemoryMiB() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::atof(line.c_str() + 6) / 1024.0;   // Reported in kB
+        }
+    }
+#if defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss / (1024.0 * 1024.0);   // Bytes
+#elif defined(__unix__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss / 1024.0;              // kB
+#endif
+    return -1.0;
+}
+
+struct Stage {
+    double sum = 0.0;
+    double max = 0.0;
+
+    void add(double ms) {
+        sum += ms;
+        max = std::max(max, ms);
+    }
+    double mean(int frames) const { return frames > 0 ? sum / frames : 0.0; }
+};
+
+struct Row {
+    int agents = 0;
+    int walls = 0;
+    int frames = 0;
+    Stage perception;
+    Stage decision;
+    Stage behavior;
+    Stage pathfinding;
+    Stage movement;
+    Stage total;            // AIManager::updateAll wall time
+    double allocationsPerFrame = 0.0;
+    double fullUpdates = 0.0;       // Per frame, by LOD outcome
+    double lowDetailUpdates = 0.0;
+    double skippedUpdates = 0.0;
+    int pendingPathRequests = 0;    // After the last frame
+    int pathCacheHits = 0;
+    int pathCacheMisses = 0;
+    double peakMiB = -1.0;
+    std::string slowestAgent;       // Worst agent tick of the last profiler window
+    std::uint64_t stateHash = 0;    // After the last frame
+};
+
+Row run(int agentCount, int frames, std::uint32_t seed, int threads) {
+    ai::StressScenarioConfig scenarioConfig;
+    scenarioConfig.seed = seed;
+    scenarioConfig.agentCount = agentCount;
+
+    ai::CoordinationConfig coordination;
+    coordination.workerThreads = threads;
+    coordination.deterministic.enabled = true;
+    coordination.deterministic.fixedTimeStep = kFrameTime;
+    coordination.deterministic.seed = seed;
+
+    entities::EntityManager entityManager;
+    collisions::CollisionManager collisionManager;
+    ai::AIManager aiManager(coordination);
+    ai::StressScenario scenario(scenarioConfig);
+    scenario.populate(entityManager, collisionManager, aiManager);
+
+    // The player circles the middle of the map so sight, alerts and chases keep changing
+    entities::Player* player = scenario.getPlayer();
+    sf::Vector2f center = player->position();
+    float orbit = std::min(scenario.getBounds().size.x * 0.25f, 400.0f);
+
+    Row row;
+    row.agents = scenario.getStats().agents;
+    row.walls = scenario.getStats().walls;
+    row.frames = frames;
+
+    using clock = std::chrono::steady_clock;
+    for (int frame = -kWarmupFrames; frame < frames; ++frame) {
+        float angle = (frame + kWarmupFrames) * kFrameTime * 0.5f;
+        player->setPosition(center + sf::Vector2f(std::cos(angle) * orbit, std::sin(angle) * orbit));
+
+        std::size_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+        auto begin = clock::now();
+        aiManager.updateAll(kFrameTime, &entityManager, &collisionManager);
+        auto end = clock::now();
+        if (frame < 0) continue;
+
+        const auto metrics = aiManager.getPerformanceMetrics();
+        row.allocationsPerFrame += static_cast<double>(g_allocations.load(std::memory_order_relaxed) - allocationsBefore);
+        row.total.add(std::chrono::duration<double, std::milli>(end - begin).count());
+        row.perception.add(metrics.perceptionTime);
+        row.decision.add(metrics.decisionTime);
+        row.behavior.add(metrics.behaviorTime);
+        row.pathfinding.add(metrics.pathfindingTime);
+        row.movement.add(metrics.movementTime);
+        row.fullUpdates += metrics.lodFullUpdates;
+        row.lowDetailUpdates += metrics.lodLowDetailUpdates;
+        row.skippedUpdates += metrics.lodSkippedUpdates;
+    }
+
+    const auto metrics = aiManager.getPerformanceMetrics();
+    double n = std::max(frames, 1);
+    row.allocationsPerFrame /= n;
+    row.fullUpdates /= n;
+    row.lowDetailUpdates /= n;
+    row.skippedUpdates /= n;
+    row.pendingPathRequests = metrics.pendingPathRequests;
+    row.pathCacheHits = metrics.pathCacheHits;
+    row.pathCacheMisses = metrics.pathCacheMisses;
+    row.peakMiB = peakMemoryMiB();
+    row.stateHash = aiManager.getStateHash();
+    const auto& slowest = aiManager.getAgentProfiler().getSlowest();
+    if (!slowest.empty()) row.slowestAgent = ai::AgentProfiler::describe(slowest.front());
+    return row;
+}
+
+std::vector<int> parseCounts(const char* text) {
+    std::vector<int> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int count = std::atoi(item.c_str());
+        if (count > 0) counts.push_back(count);
+    }
+    std::sort(counts.begin(), counts.end());
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<int> counts{100, 1000, 10000};
+    int frames = 300;
+    std::uint32_t seed = ai::StressScenarioConfig{}.seed;
+    int threads = 0;
+    std::string csvPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            counts = {100, 1000};
+            frames = 60;
+        } else if (std::strcmp(argv[i], "--agents") == 0 && i + 1 < argc) {
+            counts = parseCounts(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--quick] [--agents N[,N...]] [--frames K] [--seed S] [--threads T] [--csv file]\n";
+            return 1;
+        }
+    }
+    if (counts.empty()) {
+        std::cerr << "no agent count given\n";
+        return 1;
+    }
+
+    core::Logger::instance().enableConsole(false);
+    std::vector<Row> rows;
+    for (int count : counts) {
+        rows.push_back(run(count, frames, seed, threads));
+    }
+
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+    std::printf("AI benchmark (seed 0x%X, %d frames, %d worker threads, %s build)\n",
+                seed, frames, threads, buildType);
+    std::printf("%6s %6s %13s %13s %13s %13s %13s %13s %10s %17s %9s %9s\n",
+                "agents", "walls", "perception", "decision", "behavior", "pathfinding", "movement", "total",
+                "allocs/f", "full/low/skip", "paths", "peakMiB");
+    for (const auto& row : rows) {
+        auto stage = [&row](const Stage& s) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3f/%.2f", s.mean(row.frames), s.max);
+            return std::string(text);
+        };
+        char lod[32];
+        std::snprintf(lod, sizeof(lod), "%.0f/%.0f/%.0f", row.fullUpdates, row.lowDetailUpdates, row.skippedUpdates);
+        std::printf("%6d %6d %13s %13s %13s %13s %13s %13s %10.1f %17s %9d %9.1f\n",
+                    row.agents, row.walls, stage(row.perception).c_str(), stage(row.decision).c_str(),
+                    stage(row.behavior).c_str(), stage(row.pathfinding).c_str(), stage(row.movement).c_str(),
+                    stage(row.total).c_str(),
+                    row.allocationsPerFrame, lod, row.pendingPathRequests, row.peakMiB);
+    }
+    for (const auto& row : rows) {
+        std::printf("%6d state hash %016llx\n", row.agents, static_cast<unsigned long long>(row.stateHash));
+        if (!row.slowestAgent.empty()) std::printf("%6d slowest: %s\n", row.agents, row.slowestAgent.c_str());
+    }
+
+    if (!csvPath.empty()) {
+        std::ofstream csv(csvPath);
+        if (!csv.good()) {
+            std::cerr << "cannot write " << csvPath << "\n";
+            return 1;
+        }
+        csv << "agents,walls,frames,perception_ms,perception_max_ms,decision_ms,decision_max_ms,"
+               "behavior_ms,behavior_max_ms,pathfinding_ms,pathfinding_max_ms,movement_ms,movement_max_ms,total_ms,total_max_ms,"
+               "allocs_per_frame,lod_full,lod_low,lod_skipped,pending_paths,path_cache_hits,path_cache_misses,"
+               "peak_mib,state_hash\n";
+        for (const auto& row : rows) {
+            char hash[24];
+            std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(row.stateHash));
+            csv << row.agents << ',' << row.walls << ',' << row.frames << ','
+                << row.perception.mean(row.frames) << ',' << row.perception.max << ','
+                << row.decision.mean(row.frames) << ',' << row.decision.max << ','
+                << row.behavior.mean(row.frames) << ',' << row.behavior.max << ','
+                << row.pathfinding.mean(row.frames) << ',' << row.pathfinding.max << ','
+                << row.movement.mean(row.frames) << ',' << row.movement.max << ','
+                << row.total.mean(row.frames) << ',' << row.total.max << ','
+                << row.allocationsPerFrame << ',' << row.fullUpdates << ',' << row.lowDetailUpdates << ','
+                << row.skippedUpdates << ',' << row.pendingPathRequests << ',' << row.pathCacheHits << ','
+                << row.pathCacheMisses << ',' << row.peakMiB << ',' << hash << '\n';
+        }
+    }
+    return 0;
+}
@@ -1,12 +1,39 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <random>
 #include "ai/AIState.h"
 #include "ai/Perception.h"
+#include "ai/PerceptionMemory.h"
 #include "ai/Pathfinding.h"
 #include "ai/AISystem.h"
 #include "ai/AIManager.h"
+#include "ai/NavGrid.h"
+#include "ai/PathRequestQueue.h"
+#include "ai/PathCache.h"
+#include "ai/IncrementalPlanner.h"
+#include "ai/NavMesh.h"
+#include "ai/PerceptionBatch.h"
+#include "ai/VisibilityTable.h"
+#include "ai/LODScheduler.h"
+#include "ai/SoundPropagation.h"
+#include "ai/StateBuckets.h"
+#include "ai/BehaviorTree.h"
+#include "ai/CrowdSteering.h"
+#include "ai/Enemy.h"
+#include "ai/EnemyManager.h"
+#include "ai/StressScenario.h"
+#include "ai/TeamBlackboard.h"
+#include "ai/AgentProfiler.h"
+#include "ai/TargetSet.h"
+#include "ai/DeterministicStep.h"
 #include "entities/Entity.h"
 #include "entities/Player.h"
+#include "entities/EntityManager.h"
 #include "collisions/CollisionManager.h"
+#include "core/ThreadPool.h"
+#include <atomic>
+#include <nlohmann/json.hpp>
 
 namespace ai {
 namespace test {
@@ -138,6 +165,164 @@ TEST_F(PerceptionTest, MemorySystem) {
     EXPECT_FALSE(perceptionSystem_->hasValidMemory(&observer, currentTime + 1.0f));
 }
 
+TEST_F(PerceptionTest, MemoryRingRefreshesDecaysAndStaysBounded) {
+    PerceptionMemoryConfig config;
+    config.slotsPerAgent = 4;
+    PerceptionMemory memory(config);
+    PerceptionMemory::Handle a = memory.allocate();
+    PerceptionMemory::Handle b = memory.allocate();
+    
+    // Same target and type refreshes in place; new targets fill the ring, then overwrite the oldest
+    memory.remember(a, PerceptionType::SIGHT, 7, {10.f, 0.f}, 1.0f, 0.0f, 4.0f);
+    memory.remember(a, PerceptionType::SIGHT, 7, {20.f, 0.f}, 1.0f, 1.0f, 4.0f);
+    EXPECT_EQ(memory.size(a), 1u);
+    for (std::uint32_t id = 8; id <= 12; ++id) {
+        memory.remember(a, PerceptionType::HEARING, id, {0.f, 0.f}, 0.5f, 2.0f, 4.0f);
+    }
+    EXPECT_EQ(memory.size(a), 4u);
+    EXPECT_EQ(memory.getStats().overwritten, 2);
+    EXPECT_EQ(memory.freshest(a, PerceptionType::SIGHT, 2.0f), nullptr);    // Target 7 was the oldest entry
+    EXPECT_EQ(memory.size(b), 0u);
+    
+    // Linear decay to zero over the lifetime
+    memory.remember(b, PerceptionType::SIGHT, 3, {5.f, 5.f}, 0.8f, 10.0f, 4.0f);
+    const PerceptionMemory::Record* record = memory.freshest(b, PerceptionType::SIGHT, 12.0f, 3);
+    ASSERT_NE(record, nullptr);
+    EXPECT_NEAR(PerceptionMemory::confidence(*record, 12.0f), 0.4f, 1e-5f);
+    EXPECT_EQ(memory.freshest(b, PerceptionType::SIGHT, 14.5f), nullptr);
+    
+    // Released blocks are reused; the store never grows past its peak agent count
+    memory.release(a);
+    PerceptionMemory::Handle c = memory.allocate();
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(memory.size(c), 0u);
+    EXPECT_EQ(memory.agentCount(), 2u);
+}
+
+TEST_F(PerceptionTest, AgentsShareOneMemoryStoreInManager) {
+    MockEntity first(1, {0.0f, 0.0f});
+    MockEntity second(2, {500.0f, 0.0f});
+    MockEntity target(9, {40.0f, 0.0f});
+    AIManager manager;
+    manager.addAgent(&first);
+    manager.addAgent(&second);
+    EXPECT_EQ(manager.getPerceptionMemory().agentCount(), 2u);
+    
+    // A sighting lands in the agent's block of the shared store
+    AIAgent* agent = manager.getAgent(&first);
+    PerceptionSystem& perception = agent->getPerceptionSystem();
+    perception.remember(PerceptionEvent(PerceptionType::SIGHT, &target, target.position(), 0.9f), 0.0f);
+    EXPECT_EQ(perception.getMemoryStore(), &manager.getPerceptionMemory());
+    EXPECT_TRUE(perception.hasValidMemory(&target, 1.0f));
+    EXPECT_FALSE(manager.getAgent(&second)->getPerceptionSystem().hasValidMemory(&target, 1.0f));
+    
+    std::vector<PerceptionEvent> events;
+    perception.appendMemoryEvent(&first, events, 1.0f);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, PerceptionType::MEMORY);
+    EXPECT_EQ(events[0].source, nullptr);
+    EXPECT_LT(events[0].intensity, 0.9f);
+    
+    manager.removeAgent(&first);
+    EXPECT_EQ(manager.getPerceptionMemory().agentCount(), 1u);
+}
+
+TEST_F(PerceptionTest, SpatialQueryFindsOnlyEntitiesInRadius) {
+    entities::EntityManager entityManager;
+    entityManager.setSpatialCellSize(64.0f);
+    for (int i = 0; i < 20; ++i) {
+        entityManager.addEntity(std::make_unique<MockEntity>(i + 1, sf::Vector2f(i * 40.0f, 0.0f)));
+    }
+    
+    std::vector<entities::Entity*> nearby;
+    entities::Entity* self = entityManager.getEntity(6); // x = 200
+    entityManager.queryRadius({200.0f, 0.0f}, 80.0f, nearby, self);
+    std::vector<entities::Entity::Id> ids;
+    for (auto* entity : nearby) ids.push_back(entity->id());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<entities::Entity::Id>{4, 5, 7, 8}));
+    
+    // Moving an entity outside updateAll needs an explicit invalidation
+    entityManager.getEntity(20)->setPosition({210.0f, 10.0f});
+    entityManager.invalidateSpatialIndex();
+    entityManager.queryRadius({200.0f, 0.0f}, 80.0f, nearby, self);
+    EXPECT_EQ(nearby.size(), 5u);
+}
+
+TEST_F(PerceptionTest, BatchMatchesPerAgentPerception) {
+    entities::EntityManager entityManager;
+    collisions::CollisionManager collisionManager;
+    entityManager.setCollisionManager(&collisionManager);
+    
+    // Two observers facing right, targets in/out of cone and range, one behind a wall
+    auto addEntity = [&](entities::Entity::Id id, sf::Vector2f pos) {
+        entityManager.addEntity(std::make_unique<MockEntity>(id, pos, sf::Vector2f(4, 4)));
+        return entityManager.getEntity(id);
+    };
+    entities::Entity* observerA = addEntity(1, {0, 0});
+    entities::Entity* observerB = addEntity(2, {300, 0});
+    addEntity(3, {60, 5});
+    addEntity(4, {0, 70});
+    addEntity(5, {20, 0});
+    addEntity(6, {380, 0});
+    entities::Entity* wall = addEntity(7, {340, -20});
+    wall->setCollisionLayer(entities::Entity::Layer::Wall);
+    collisionManager.addCollider(wall, sf::FloatRect({340, -20}, {4, 40}));
+    
+    AIAgentConfig agentConfig;
+    agentConfig.perception = config_;
+    AIAgent agentA(observerA, agentConfig);
+    AIAgent agentB(observerB, agentConfig);
+    std::vector<AIAgent*> agents{&agentA, &agentB};
+    
+    PerceptionBatch batch;
+    batch.run(agents, &entityManager, &collisionManager);
+    
+    for (std::size_t slot = 0; slot < agents.size(); ++slot) {
+        PerceptionSystem reference(config_);
+        auto expected = reference.updatePerception(agents[slot]->getEntity(), agents[slot]->getEntityPosition(),
+                                                   agents[slot]->getFacingDirection(), &entityManager,
+                                                   &collisionManager, 0.0f);
+        // The per-agent pass also appends a MEMORY event after a sighting
+        expected.erase(std::remove_if(expected.begin(), expected.end(),
+                       [](const PerceptionEvent& e) { return e.type == PerceptionType::MEMORY; }),
+                       expected.end());
+        auto key = [](const PerceptionEvent& e) { return std::make_pair(e.source, static_cast<int>(e.type)); };
+        std::vector<std::pair<entities::Entity*, int>> expectedKeys, actualKeys;
+        for (const auto& e : expected) expectedKeys.push_back(key(e));
+        for (std::size_t i = 0; i < batch.eventCount(slot); ++i) {
+            const PerceptionEvent& e = batch.event(slot, i);
+            actualKeys.push_back(key(e));
+            auto match = std::find_if(expected.begin(), expected.end(),
+                                      [&](const PerceptionEvent& x) { return key(x) == key(e); });
+            ASSERT_NE(match, expected.end());
+            EXPECT_NEAR(match->intensity, e.intensity, 1e-4f);
+        }
+        std::sort(expectedKeys.begin(), expectedKeys.end());
+        std::sort(actualKeys.begin(), actualKeys.end());
+        EXPECT_EQ(expectedKeys, actualKeys);
+    }
+    EXPECT_GT(batch.getStats().raycasts, 0);
+}
+
+TEST_F(PerceptionTest, UpdatePerceptionUsesSpatialQuery) {
+    entities::EntityManager entityManager;
+    auto observer = std::make_unique<MockEntity>(1, sf::Vector2f(0.0f, 0.0f));
+    entities::Entity* observerPtr = observer.get();
+    entityManager.addEntity(std::move(observer));
+    entityManager.addEntity(std::make_unique<MockEntity>(2, sf::Vector2f(20.0f, 0.0f)));
+    entityManager.addEntity(std::make_unique<MockEntity>(3, sf::Vector2f(5000.0f, 0.0f)));
+    
+    auto events = perceptionSystem_->updatePerception(observerPtr, {0.0f, 0.0f}, {1.0f, 0.0f},
+                                                      &entityManager, nullptr, 0.0f);
+    bool sawNear = false;
+    for (const auto& event : events) {
+        ASSERT_NE(event.source, entityManager.getEntity(3));
+        if (event.type == PerceptionType::SIGHT && event.source == entityManager.getEntity(2)) sawNear = true;
+    }
+    EXPECT_TRUE(sawNear);
+}
+
 class PathfindingTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -182,6 +367,516 @@ TEST_F(PathfindingTest, SimplePath) {
     EXPECT_EQ(path.back(), goal);
 }
 
+class NavGridTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        NavGridConfig config;
+        config.cellSize = 32.0f;
+        config.bounds = sf::FloatRect({0.f, 0.f}, {320.f, 320.f});
+        grid_ = std::make_unique<NavGrid>(config);
+        
+        // Vertical wall at column 5 with a gap at the bottom row
+        grid_->markRect(sf::FloatRect({160.f, 0.f}, {32.f, 288.f}));
+    }
+    
+    std::unique_ptr<NavGrid> grid_;
+};
+
+TEST_F(NavGridTest, MarksCellsCoveredByRect) {
+    EXPECT_EQ(grid_->width(), 10);
+    EXPECT_EQ(grid_->height(), 10);
+    EXPECT_TRUE(grid_->isBlocked(5, 0));
+    EXPECT_TRUE(grid_->isBlocked(5, 8));
+    EXPECT_FALSE(grid_->isBlocked(5, 9));
+    EXPECT_FALSE(grid_->isBlocked(4, 0));
+    EXPECT_TRUE(grid_->isBlocked(-1, 0));  // Out of bounds counts as blocked
+}
+
+TEST_F(NavGridTest, VersionChangesOnlyOnEdit) {
+    auto version = grid_->version();
+    grid_->setBlocked(5, 0, true);   // Already blocked
+    EXPECT_EQ(grid_->version(), version);
+    grid_->setBlocked(5, 0, false);
+    EXPECT_GT(grid_->version(), version);
+}
+
+TEST_F(NavGridTest, GridPathRoutesThroughGap) {
+    PathfindingSystem pathfinding;
+    auto result = pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_);
+    
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.path.front(), sf::Vector2f(48.f, 48.f));
+    EXPECT_EQ(result.path.back(), sf::Vector2f(272.f, 48.f));
+    
+    // Route must dip down to the gap in the last row
+    float lowestY = 0.0f;
+    for (const auto& point : result.path) {
+        lowestY = std::max(lowestY, point.y);
+        EXPECT_FALSE(grid_->isBlocked(point));
+    }
+    EXPECT_GT(lowestY, 288.0f);
+}
+
+TEST_F(NavGridTest, QueueSpreadsSearchAcrossFrames) {
+    PathRequestQueueConfig queueConfig;
+    queueConfig.expansionsPerSlice = 4;
+    queueConfig.maxExpansionsPerFrame = 4;
+    PathRequestQueue queue(queueConfig);
+    queue.setNavGrid(grid_.get());
+    
+    auto id = queue.submit(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), Priority::MEDIUM, PathfindingConfig{});
+    EXPECT_EQ(queue.status(id), PathRequestStatus::Pending);
+    
+    queue.process();
+    EXPECT_EQ(queue.status(id), PathRequestStatus::InProgress);
+    EXPECT_LE(queue.getStats().expansionsLastFrame, 4);
+    
+    int frames = 1;
+    while (queue.status(id) == PathRequestStatus::InProgress && frames < 200) {
+        queue.process();
+        ++frames;
+    }
+    EXPECT_GT(frames, 1);
+    
+    PathfindingResult result;
+    EXPECT_EQ(queue.poll(id, result), PathRequestStatus::Ready);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(queue.status(id), PathRequestStatus::Invalid);  // Released after poll
+}
+
+TEST_F(NavGridTest, QueueHonorsPriorityAndCancellation) {
+    PathRequestQueueConfig queueConfig;
+    queueConfig.maxExpansionsPerFrame = 1;
+    PathRequestQueue queue(queueConfig);
+    queue.setNavGrid(grid_.get());
+    
+    auto low = queue.submit(sf::Vector2f(48.f, 48.f), sf::Vector2f(80.f, 48.f), Priority::LOW, PathfindingConfig{});
+    auto high = queue.submit(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), Priority::HIGH, PathfindingConfig{});
+    
+    queue.process();
+    EXPECT_EQ(queue.status(high), PathRequestStatus::InProgress);
+    EXPECT_EQ(queue.status(low), PathRequestStatus::Pending);
+    
+    queue.cancel(high);
+    EXPECT_EQ(queue.status(high), PathRequestStatus::Invalid);
+    EXPECT_EQ(queue.getStats().cancelled, 1);
+    
+    queue.process();
+    EXPECT_EQ(queue.status(low), PathRequestStatus::InProgress);
+}
+
+TEST_F(NavGridTest, ClearanceGatesAgentsBySize) {
+    // Gap cell is squeezed between the wall above and the grid edge below
+    EXPECT_FLOAT_EQ(grid_->clearance(5, 9), 16.0f);
+    EXPECT_FLOAT_EQ(grid_->clearance(2, 4), 80.0f);
+    EXPECT_FLOAT_EQ(grid_->clearance(5, 0), 0.0f);
+    
+    PathfindingConfig config;
+    config.agentRadius = 16.0f;
+    PathfindingSystem pathfinding(config);
+    EXPECT_TRUE(pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_).success);
+    
+    config.agentRadius = 20.0f;
+    pathfinding.setConfig(config);
+    EXPECT_FALSE(pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_).success);
+    
+    // A per-query radius applies to that search only
+    PathfindingConfig query = config;
+    query.agentRadius = 16.0f;
+    EXPECT_TRUE(pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_, query).success);
+    EXPECT_FLOAT_EQ(pathfinding.getConfig().agentRadius, 20.0f);
+    
+    // Widening the gap to three cells updates clearance on the next query
+    grid_->setBlocked(5, 8, false);
+    grid_->setBlocked(5, 7, false);
+    EXPECT_FLOAT_EQ(grid_->clearance(5, 8), 48.0f);
+    EXPECT_TRUE(pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_).success);
+}
+
+TEST_F(NavGridTest, AnyAnglePathsUseGridLineOfSight) {
+    EXPECT_FALSE(grid_->hasLineOfSight({1, 1}, {8, 1}));
+    EXPECT_TRUE(grid_->hasLineOfSight({1, 1}, {4, 8}));
+    EXPECT_TRUE(grid_->hasLineOfSight({1, 9}, {8, 9}));
+    
+    PathfindingSystem pathfinding;
+    auto result = pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_);
+    ASSERT_TRUE(result.success);
+    
+    // Taut path: only a couple of corners around the gap, each leg unobstructed
+    EXPECT_LE(result.path.size(), 5u);
+    for (std::size_t i = 1; i < result.path.size(); ++i) {
+        EXPECT_TRUE(grid_->hasLineOfSight(grid_->worldToCell(result.path[i - 1]),
+                                          grid_->worldToCell(result.path[i])));
+    }
+    
+    PathfindingConfig gridConfig;
+    gridConfig.anyAngle = false;
+    pathfinding.setConfig(gridConfig);
+    auto gridResult = pathfinding.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f), *grid_);
+    ASSERT_TRUE(gridResult.success);
+    EXPECT_LT(result.totalCost, gridResult.totalCost);
+}
+
+TEST_F(NavGridTest, PathCacheServesRepeatAndSuffixRoutes) {
+    PathCache cache;
+    PathfindingSystem pathfinding;
+    pathfinding.setPathCache(&cache);
+    
+    sf::Vector2f goal(272.f, 48.f);
+    auto first = pathfinding.findPath(sf::Vector2f(48.f, 48.f), goal, *grid_);
+    ASSERT_TRUE(first.success);
+    EXPECT_FALSE(first.fromCache);
+    
+    auto repeat = pathfinding.findPath(sf::Vector2f(48.f, 48.f), goal, *grid_);
+    ASSERT_TRUE(repeat.fromCache);
+    EXPECT_EQ(repeat.path, first.path);
+    
+    // The gap cell lies on the cached route, so only the remaining suffix is needed
+    sf::Vector2f gap = grid_->cellToWorld(5, 9);
+    auto suffix = pathfinding.findPath(gap, goal, *grid_);
+    ASSERT_TRUE(suffix.fromCache);
+    EXPECT_EQ(suffix.path.front(), gap);
+    EXPECT_EQ(suffix.path.back(), goal);
+    EXPECT_EQ(cache.getStats().hits, 1);
+    EXPECT_EQ(cache.getStats().partialHits, 1);
+}
+
+TEST_F(NavGridTest, PathCacheDropsRoutesWhenGridChanges) {
+    PathCache cache;
+    PathRequestQueue queue;
+    queue.setNavGrid(grid_.get());
+    queue.setPathCache(&cache);
+    
+    sf::Vector2f start(48.f, 48.f);
+    sf::Vector2f goal(272.f, 48.f);
+    PathfindingResult result;
+    auto id = queue.submit(start, goal, Priority::LOW, PathfindingConfig{});
+    queue.process();
+    ASSERT_EQ(queue.poll(id, result), PathRequestStatus::Ready);
+    
+    // Identical request completes on submit without a search
+    id = queue.submit(start, goal, Priority::LOW, PathfindingConfig{});
+    EXPECT_EQ(queue.status(id), PathRequestStatus::Ready);
+    EXPECT_EQ(queue.getStats().cacheHits, 1);
+    queue.poll(id, result);
+    
+    grid_->setBlocked(5, 9, true);
+    id = queue.submit(start, goal, Priority::LOW, PathfindingConfig{});
+    EXPECT_EQ(queue.status(id), PathRequestStatus::Pending);
+    EXPECT_EQ(cache.getStats().invalidations, 1);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(NavGridTest, IncrementalPlannerRepairsAroundToggledCells) {
+    IncrementalPlannerConfig plannerConfig;
+    plannerConfig.maxExpansionsPerUpdate = 0;
+    IncrementalPlanner planner(plannerConfig);
+    planner.setGrid(grid_.get());
+    
+    sf::Vector2f start(48.f, 48.f);
+    sf::Vector2f goal(272.f, 48.f);
+    ASSERT_EQ(planner.update(start, goal), IncrementalPlanner::Status::Ready);
+    int initialExpansions = planner.getStats().expansionsLastUpdate;
+    
+    // Close the gap: no route left
+    grid_->setBlocked(5, 9, true);
+    EXPECT_EQ(planner.update(start, goal), IncrementalPlanner::Status::NoPath);
+    
+    // Open a door near the top; the repair touches far fewer cells than the first search
+    grid_->setBlocked(5, 1, false);
+    ASSERT_EQ(planner.update(start, goal), IncrementalPlanner::Status::Ready);
+    EXPECT_LT(planner.getStats().expansionsLastUpdate, initialExpansions);
+    EXPECT_EQ(planner.getStats().fullReplans, 1);
+    EXPECT_EQ(planner.getStats().repairs, 2);
+    EXPECT_LE(planner.path().size(), 4u);
+    
+    // Target drifting one cell keeps the search root
+    ASSERT_EQ(planner.update(start, sf::Vector2f(272.f, 80.f)), IncrementalPlanner::Status::Ready);
+    EXPECT_EQ(planner.getStats().fullReplans, 1);
+    EXPECT_EQ(planner.path().back(), sf::Vector2f(272.f, 80.f));
+}
+
+class NavMeshTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        NavMeshConfig config;
+        config.bounds = sf::FloatRect({0.f, 0.f}, {320.f, 320.f});
+        config.agentRadius = 8.0f;
+        mesh_ = std::make_unique<NavMesh>(config);
+        
+        // Same layout as the grid tests: wall with a gap along the bottom edge
+        mesh_->build(std::vector<sf::FloatRect>{sf::FloatRect({160.f, 0.f}, {32.f, 288.f})});
+    }
+    
+    std::unique_ptr<NavMesh> mesh_;
+};
+
+TEST_F(NavMeshTest, FunnelPathHugsInflatedCorners) {
+    EXPECT_EQ(mesh_->findPolygon(sf::Vector2f(170.f, 100.f)), -1);
+    EXPECT_GE(mesh_->findPolygon(sf::Vector2f(48.f, 48.f)), 0);
+    
+    auto result = mesh_->findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f));
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(result.path.size(), 4u);
+    EXPECT_EQ(result.path[1], sf::Vector2f(152.f, 296.f));
+    EXPECT_EQ(result.path[2], sf::Vector2f(200.f, 296.f));
+}
+
+TEST_F(NavMeshTest, SerializedMeshProducesSamePaths) {
+    NavMesh loaded;
+    ASSERT_TRUE(loaded.deserialize(mesh_->serialize()));
+    EXPECT_EQ(loaded.polygons().size(), mesh_->polygons().size());
+    EXPECT_EQ(loaded.portals().size(), mesh_->portals().size());
+    
+    auto original = mesh_->findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f));
+    auto restored = loaded.findPath(sf::Vector2f(48.f, 48.f), sf::Vector2f(272.f, 48.f));
+    EXPECT_EQ(restored.path, original.path);
+    
+    EXPECT_FALSE(loaded.deserialize("{\"version\": 99}"));
+}
+
+class VisibilityTableTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        NavGridConfig gridConfig;
+        gridConfig.cellSize = 16.0f;
+        gridConfig.bounds = sf::FloatRect({0.f, 0.f}, {320.f, 320.f});
+        occupancy_ = NavGrid(gridConfig);
+        // Same wall as the navigation tests, gap along the bottom edge
+        occupancy_.markRect(sf::FloatRect({160.f, 0.f}, {32.f, 288.f}));
+        
+        VisibilityTableConfig config;
+        config.cellSize = 64.0f;
+        config.maxDistance = 320.0f;
+        table_ = VisibilityTable(config);
+        table_.build(occupancy_);
+    }
+    
+    NavGrid occupancy_;
+    VisibilityTable table_;
+};
+
+TEST_F(VisibilityTableTest, ClassifiesCellPairsThroughStaticWalls) {
+    using Visibility = VisibilityTable::Visibility;
+    EXPECT_EQ(table_.query({40.f, 40.f}, {280.f, 40.f}), Visibility::Hidden);
+    EXPECT_EQ(table_.query({280.f, 40.f}, {40.f, 40.f}), Visibility::Hidden);
+    EXPECT_EQ(table_.query({40.f, 40.f}, {100.f, 100.f}), Visibility::Visible);
+    // Bottom row: some segments pass under the wall, others hit it
+    EXPECT_EQ(table_.query({40.f, 300.f}, {280.f, 300.f}), Visibility::Unknown);
+    
+    // Hidden needs no raycast; Visible only casts against dynamic layers
+    EXPECT_FALSE(table_.hasLineOfSight({40.f, 40.f}, {280.f, 40.f}, nullptr, nullptr, entities::kLayerMaskAll));
+    collisions::CollisionManager collisionManager;
+    MockEntity crate(2, {60.f, 60.f}, {16.f, 16.f});
+    crate.setCollisionLayer(entities::Entity::Layer::Item);
+    collisionManager.addCollider(&crate, sf::FloatRect({60.f, 60.f}, {16.f, 16.f}));
+    EXPECT_FALSE(table_.hasLineOfSight({40.f, 40.f}, {100.f, 100.f}, &collisionManager, nullptr,
+                                       entities::kLayerMaskAll));
+    EXPECT_TRUE(table_.hasLineOfSight({40.f, 40.f}, {100.f, 100.f}, &collisionManager, nullptr,
+                                      entities::kLayerMaskWall));
+}
+
+TEST_F(VisibilityTableTest, SerializedTableKeepsSignatureAndAnswers) {
+    VisibilityTable loaded;
+    ASSERT_TRUE(loaded.deserialize(table_.serialize()));
+    EXPECT_EQ(loaded.signature(), VisibilityTable::occupancySignature(occupancy_));
+    EXPECT_EQ(loaded.query({40.f, 40.f}, {280.f, 40.f}), VisibilityTable::Visibility::Hidden);
+    EXPECT_EQ(loaded.query({40.f, 40.f}, {100.f, 100.f}), VisibilityTable::Visibility::Visible);
+    
+    // Editing the geometry changes the signature, so a cached table would be rebuilt
+    occupancy_.setBlocked(2, 2, true);
+    EXPECT_NE(loaded.signature(), VisibilityTable::occupancySignature(occupancy_));
+}
+
+TEST_F(VisibilityTableTest, AnswersHoldForEverySegmentBetweenCells) {
+    // Scattered pillars, so sampled rays could slip past them
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cell(0, occupancy_.width() - 1);
+    for (int i = 0; i < 24; ++i) occupancy_.setBlocked(cell(rng), cell(rng), true);
+    table_.build(occupancy_);
+    
+    // Closed segment against closed cell, so touching a corner counts as blocked
+    auto touchesBlocked = [this](sf::Vector2f p0, sf::Vector2f p1) {
+        for (int y = 0; y < occupancy_.height(); ++y) {
+            for (int x = 0; x < occupancy_.width(); ++x) {
+                if (!occupancy_.isBlocked(x, y)) continue;
+                float t0 = 0.0f, t1 = 1.0f;
+                sf::Vector2f d = p1 - p0;
+                const float lo[2] = {x * 16.0f, y * 16.0f};
+                const float hi[2] = {lo[0] + 16.0f, lo[1] + 16.0f};
+                const float p[2] = {p0.x, p0.y};
+                const float v[2] = {d.x, d.y};
+                bool hit = true;
+                for (int axis = 0; axis < 2 && hit; ++axis) {
+                    if (v[axis] == 0.0f) {
+                        hit = p[axis] >= lo[axis] && p[axis] <= hi[axis];
+                        continue;
+                    }
+                    float a = (lo[axis] - p[axis]) / v[axis];
+                    float b = (hi[axis] - p[axis]) / v[axis];
+                    t0 = std::max(t0, std::min(a, b));
+                    t1 = std::min(t1, std::max(a, b));
+                    hit = t0 <= t1;
+                }
+                if (hit) return true;
+            }
+        }
+        return false;
+    };
+    
+    std::uniform_real_distribution<float> coord(0.0f, 319.0f);
+    int visible = 0, hidden = 0;
+    for (int i = 0; i < 4000; ++i) {
+        sf::Vector2f from(coord(rng), coord(rng));
+        sf::Vector2f to(coord(rng), coord(rng));
+        auto answer = table_.query(from, to);
+        if (answer == VisibilityTable::Visibility::Visible) {
+            ++visible;
+            EXPECT_FALSE(touchesBlocked(from, to)) << from.x << "," << from.y << " -> " << to.x << "," << to.y;
+        } else if (answer == VisibilityTable::Visibility::Hidden) {
+            ++hidden;
+            EXPECT_TRUE(touchesBlocked(from, to)) << from.x << "," << from.y << " -> " << to.x << "," << to.y;
+        }
+    }
+    EXPECT_GT(visible, 0);
+    EXPECT_GT(hidden, 0);
+}
+
+TEST_F(VisibilityTableTest, ManagerReusesCacheUntilGeometryOrSettingsChange) {
+    const std::string path = "test_visibility_table.json";
+    std::filesystem::remove(path);
+    collisions::CollisionManager collisionManager;
+    MockEntity wall(10, {160.f, 0.f}, {32.f, 288.f});
+    wall.setCollisionLayer(entities::Entity::Layer::Wall);
+    collisionManager.addCollider(&wall, sf::FloatRect({160.f, 0.f}, {32.f, 288.f}));
+    VisibilityTableConfig config;
+    config.bounds = sf::FloatRect({0.f, 0.f}, {320.f, 320.f});
+    
+    AIManager baked;
+    baked.buildVisibilityTable(&collisionManager, config, path);
+    EXPECT_FALSE(baked.visibilityTableFromCache());
+    EXPECT_EQ(baked.getVisibilityTable().query({40.f, 40.f}, {280.f, 40.f}), VisibilityTable::Visibility::Hidden);
+    
+    AIManager cached;
+    cached.buildVisibilityTable(&collisionManager, config, path);
+    EXPECT_TRUE(cached.visibilityTableFromCache());
+    EXPECT_EQ(cached.getVisibilityTable().signature(), baked.getVisibilityTable().signature());
+    EXPECT_EQ(cached.getVisibilityTable().query({40.f, 40.f}, {280.f, 40.f}), VisibilityTable::Visibility::Hidden);
+    
+    // Narrowing the wall inside its occupancy cells still changes what is wholly covered
+    collisionManager.removeCollider(&wall);
+    collisionManager.addCollider(&wall, sf::FloatRect({160.f, 0.f}, {30.f, 288.f}));
+    AIManager narrowed;
+    narrowed.buildVisibilityTable(&collisionManager, config, path);
+    EXPECT_FALSE(narrowed.visibilityTableFromCache());
+    EXPECT_NE(narrowed.getVisibilityTable().signature(), baked.getVisibilityTable().signature());
+    
+    // Same geometry at another resolution is rebaked too
+    VisibilityTableConfig finer = config;
+    finer.cellSize = 32.0f;
+    AIManager resized;
+    resized.buildVisibilityTable(&collisionManager, finer, path);
+    EXPECT_FALSE(resized.visibilityTableFromCache());
+    EXPECT_FLOAT_EQ(resized.getVisibilityTable().getConfig().cellSize, 32.0f);
+    AIManager reloaded;
+    reloaded.buildVisibilityTable(&collisionManager, finer, path);
+    EXPECT_TRUE(reloaded.visibilityTableFromCache());
+    std::filesystem::remove(path);
+}
+
+TEST_F(VisibilityTableTest, GapNarrowerThanSampleCellIsNotHidden) {
+    // 4 px gap at y = 150..154, inside one 16 px occupancy row
+    collisions::CollisionManager collisionManager;
+    MockEntity upper(10, {160.f, 0.f}, {16.f, 150.f});
+    MockEntity lower(11, {160.f, 154.f}, {16.f, 166.f});
+    upper.setCollisionLayer(entities::Entity::Layer::Wall);
+    lower.setCollisionLayer(entities::Entity::Layer::Wall);
+    collisionManager.addCollider(&upper, sf::FloatRect({160.f, 0.f}, {16.f, 150.f}));
+    collisionManager.addCollider(&lower, sf::FloatRect({160.f, 154.f}, {16.f, 166.f}));
+    VisibilityTableConfig config;
+    config.bounds = sf::FloatRect({0.f, 0.f}, {320.f, 320.f});
+    
+    AIManager manager;
+    manager.buildVisibilityTable(&collisionManager, config);
+    const VisibilityTable& table = manager.getVisibilityTable();
+    EXPECT_NE(table.query({40.f, 152.f}, {280.f, 152.f}), VisibilityTable::Visibility::Hidden);
+    EXPECT_TRUE(table.hasLineOfSight({40.f, 152.f}, {280.f, 152.f}, &collisionManager, nullptr,
+                                     entities::kLayerMaskAll));
+    // Away from the gap the wall still hides
+    EXPECT_EQ(table.query({40.f, 40.f}, {280.f, 40.f}), VisibilityTable::Visibility::Hidden);
+    
+    // Occupancy alone marks the gap row blocked and would close it
+    NavGridConfig gridConfig;
+    gridConfig.cellSize = config.sampleCellSize;
+    gridConfig.bounds = config.bounds;
+    NavGrid occupancy(gridConfig);
+    occupancy.rebuild(&collisionManager);
+    VisibilityTable occupancyOnly(config);
+    occupancyOnly.build(occupancy);
+    EXPECT_EQ(occupancyOnly.query({40.f, 152.f}, {280.f, 152.f}), VisibilityTable::Visibility::Hidden);
+}
+
+class SoundPropagationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        NavGridConfig gridConfig;
+        gridConfig.cellSize = 16.0f;
+        gridConfig.bounds = sf::FloatRect({0.f, 0.f}, {320.f, 320.f});
+        grid_ = NavGrid(gridConfig);
+        // Wall with a doorway along the bottom edge
+        grid_.markRect(sf::FloatRect({160.f, 0.f}, {32.f, 288.f}));
+    }
+    
+    NavGrid grid_;
+};
+
+TEST_F(SoundPropagationTest, WallsBendSoundThroughDoorways) {
+    SoundPropagationConfig config;
+    config.wallPenalty = -1.0f;  // Opaque walls
+    SoundPropagation sound(config);
+    sound.setGrid(&grid_);
+    
+    sf::Vector2f emitter(136.f, 104.f);
+    sf::Vector2f listener(216.f, 104.f);
+    int id = sound.emit(emitter, 4.0f);
+    ASSERT_GE(id, 0);
+    
+    float openAir = 4.0f * (1.0f - 80.0f / (4.0f * config.rangePerIntensity));
+    float heard = sound.sampleField(id, listener);
+    EXPECT_GT(heard, 0.0f);           // Around through the doorway
+    EXPECT_LT(heard, openAir * 0.5f); // Much quieter than straight through the wall
+    EXPECT_NEAR(sound.sampleField(id, emitter + sf::Vector2f(0.f, 16.f)), 4.0f * (1.0f - 16.0f / 600.0f), 1e-3f);
+    
+    // Closing the door leaves the far room silent
+    grid_.markRect(sf::FloatRect({160.f, 288.f}, {32.f, 32.f}));
+    sound.setGrid(&grid_);
+    id = sound.emit(emitter, 4.0f);
+    EXPECT_EQ(sound.sampleField(id, listener), 0.0f);
+    SoundPropagation::Sample sample{};
+    EXPECT_FALSE(sound.sampleLoudest(listener, sample));
+}
+
+TEST_F(SoundPropagationTest, FieldsExpireAndPoolIsRecycled) {
+    SoundPropagationConfig config;
+    config.maxFields = 2;
+    SoundPropagation sound(config);
+    sound.setGrid(&grid_);
+    
+    sound.emit({40.f, 40.f}, 1.0f, nullptr, 2.0f);
+    sound.emit({60.f, 40.f}, 1.0f, nullptr, 0.2f);
+    sound.emit({80.f, 40.f}, 1.0f, nullptr, 2.0f);   // Evicts the shortest field
+    EXPECT_EQ(sound.activeFields(), 2u);
+    EXPECT_EQ(sound.getStats().recycled, 1);
+    
+    SoundPropagation::Sample sample{};
+    ASSERT_TRUE(sound.sampleLoudest({80.f, 40.f}, sample));
+    EXPECT_EQ(sample.origin, sf::Vector2f(80.f, 40.f));
+    
+    sound.update(2.5f);
+    EXPECT_EQ(sound.activeFields(), 0u);
+    EXPECT_EQ(sound.getStats().expired, 2);
+}
+
 class AIAgentTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -243,6 +938,94 @@ TEST_F(AIAgentTest, TargetManagement) {
     EXPECT_EQ(agent_->getPrimaryTarget(), nullptr);
 }
 
+TEST_F(AIAgentTest, TargetSetKeepsStrongestTargetsWithinLimit) {
+    MockEntity nearby(2, sf::Vector2f(150, 100));
+    MockEntity distant(3, sf::Vector2f(400, 100));
+    MockEntity middle(4, sf::Vector2f(200, 100));
+    MockEntity minor(5, sf::Vector2f(110, 100));
+    MockEntity threat(6, sf::Vector2f(500, 100));
+    
+    // Equal priority: the nearest target leads
+    agent_->addTarget(&distant, Priority::MEDIUM);
+    agent_->addTarget(&nearby, Priority::MEDIUM);
+    agent_->addTarget(&middle, Priority::MEDIUM);
+    EXPECT_EQ(agent_->getAllTargets().size(), 3u);
+    EXPECT_EQ(agent_->getPrimaryTarget(), &nearby);
+    
+    // Full (maxTargets = 3): a weaker target is turned away, a stronger one
+    // replaces the farthest of the weakest
+    agent_->addTarget(&minor, Priority::LOW);
+    EXPECT_FALSE(agent_->getAllTargets().contains(&minor));
+    agent_->addTarget(&threat, Priority::HIGH);
+    EXPECT_EQ(agent_->getAllTargets().size(), 3u);
+    EXPECT_FALSE(agent_->getAllTargets().contains(&distant));
+    EXPECT_EQ(agent_->getPrimaryTarget(), &threat);
+    
+    // Adding a held target again only raises its priority
+    agent_->addTarget(&middle, Priority::CRITICAL);
+    EXPECT_EQ(agent_->getAllTargets().size(), 3u);
+    EXPECT_EQ(agent_->getPrimaryTarget(), &middle);
+    
+    agent_->removeTarget(&middle);
+    EXPECT_EQ(agent_->getPrimaryTarget(), &threat);
+}
+
+TEST_F(AIAgentTest, SteersDirectlyWhileWaitingForQueuedPath) {
+    NavGrid grid;
+    PathRequestQueue queue;
+    queue.setNavGrid(&grid);
+    agent_->setPathRequestQueue(&queue);
+    
+    MockEntity target(2, sf::Vector2f(400, 100));
+    agent_->addTarget(&target, Priority::HIGH);
+    agent_->changeState(AIState::CHASE, "Test");
+    
+    sf::Vector2f before = entity_->position();
+    agent_->update(0.1f, nullptr, nullptr);
+    
+    EXPECT_TRUE(agent_->isWaitingForPath());
+    EXPECT_GT(entity_->position().x, before.x);  // Moved toward target without a path
+    
+    queue.process();
+    agent_->update(0.1f, nullptr, nullptr);
+    EXPECT_FALSE(agent_->isWaitingForPath());
+    EXPECT_FALSE(agent_->getDebugInfo().currentPath.empty());
+}
+
+TEST_F(AIAgentTest, CountsQueuedPathCacheMisses) {
+    NavGridConfig gridConfig;
+    gridConfig.cellSize = 32.0f;
+    gridConfig.bounds = sf::FloatRect({0.f, 0.f}, {640.f, 320.f});
+    NavGrid grid(gridConfig);
+    PathCache cache;
+    PathRequestQueue queue;
+    queue.setNavGrid(&grid);
+    queue.setPathCache(&cache);
+    agent_->setPathRequestQueue(&queue);
+    
+    MockEntity target(2, sf::Vector2f(400, 100));
+    agent_->addTarget(&target, Priority::HIGH);
+    agent_->changeState(AIState::CHASE, "Test");
+    agent_->update(0.1f, nullptr, nullptr);
+    EXPECT_EQ(agent_->getPerformanceStats().pathCacheMisses, 1);
+    EXPECT_EQ(agent_->getPerformanceStats().pathCacheHits, 0);
+    queue.process();
+    agent_->update(0.1f, nullptr, nullptr);
+    ASSERT_FALSE(agent_->isWaitingForPath());
+    
+    // A second agent asking for the same route is served without a search
+    MockEntity follower(3, sf::Vector2f(100, 100));
+    AIAgent second(&follower, AIAgentConfig{});
+    second.setPathRequestQueue(&queue);
+    second.addTarget(&target, Priority::HIGH);
+    second.changeState(AIState::CHASE, "Test");
+    second.update(0.1f, nullptr, nullptr);
+    second.update(0.1f, nullptr, nullptr);
+    EXPECT_EQ(second.getPerformanceStats().pathCacheMisses, 0);
+    EXPECT_EQ(second.getPerformanceStats().pathCacheHits, 1);
+    EXPECT_EQ(second.getPerformanceStats().pathfindingRequests, 1);
+}
+
 TEST_F(AIAgentTest, DebugInfo) {
     auto debugInfo = agent_->getDebugInfo();
     EXPECT_EQ(debugInfo.currentState, AIState::IDLE);
@@ -250,6 +1033,322 @@ TEST_F(AIAgentTest, DebugInfo) {
     EXPECT_GE(debugInfo.timeInCurrentState, 0.0f);
 }
 
+class BehaviorTreeTest : public ::testing::Test {
+protected:
+    // Aggressive profile plus a utility pick and a blackboard counter
+    const std::string treeJson_ = R"({
+        "root": {"selector": [
+            {"sequence": [{"if": "shouldFlee", "value": 1},
+                          {"action": "FLEE", "priority": "CRITICAL", "moveTo": "flee", "reason": "Low health"}]},
+            {"sequence": [{"if": "targetDistance", "op": "<=", "value": "attackRange"},
+                          {"if": "canAttack", "value": 1},
+                          {"action": "ATTACK", "priority": "HIGH", "targetEntity": true}]},
+            {"sequence": [{"if": "targetPriority", "op": ">=", "value": "MEDIUM"},
+                          {"action": "CHASE", "priority": "HIGH", "moveTo": "target", "reason": "Chasing"}]},
+            {"sequence": [{"if": "state", "value": "IDLE"},
+                          {"set": "idleTicks", "value": 1, "add": true},
+                          {"if": "bb.idleTicks", "op": ">=", "value": 3},
+                          {"set": "idleTicks", "value": 0},
+                          {"utility": [
+                              {"score": {"fact": "hasPatrol", "curve": "step", "min": 1, "weight": 2},
+                               "node": {"action": "PATROL", "priority": "LOW", "reason": "Bored"}},
+                              {"score": {"fact": "alertTimer", "curve": "linear", "min": 0, "max": 10},
+                               "node": {"action": "ALERT", "priority": "LOW"}}]}]}
+        ]}
+    })";
+    
+    BehaviorContext idleContext() const {
+        BehaviorContext context;
+        context[BehaviorFact::TargetDistance] = 1.0e9f;
+        context[BehaviorFact::AttackRange] = 32.0f;
+        context[BehaviorFact::State] = static_cast<float>(AIState::IDLE);
+        return context;
+    }
+};
+
+TEST_F(BehaviorTreeTest, CompilesFlatTreeAndEvaluatesPerAgentBlackboard) {
+    BehaviorTree tree;
+    ASSERT_TRUE(tree.loadFromString(treeJson_));
+    EXPECT_EQ(tree.nodeCount(), 21u);
+    ASSERT_EQ(tree.blackboardSlot("idleTicks"), 0);
+    
+    BehaviorTree::Blackboard blackboard;
+    BehaviorTree::Result result;
+    BehaviorContext context = idleContext();
+    context[BehaviorFact::HasTarget] = 1.0f;
+    context[BehaviorFact::TargetDistance] = 20.0f;
+    context[BehaviorFact::TargetPriority] = static_cast<float>(Priority::HIGH);
+    context[BehaviorFact::CanAttack] = 1.0f;
+    tree.evaluate(context, blackboard, result);
+    EXPECT_TRUE(result.decided);
+    EXPECT_EQ(result.state, AIState::ATTACK);
+    EXPECT_TRUE(result.targetEntity);
+    
+    context[BehaviorFact::TargetDistance] = 200.0f;
+    tree.evaluate(context, blackboard, result);
+    EXPECT_EQ(result.state, AIState::CHASE);
+    EXPECT_EQ(result.moveTo, BehaviorTree::MoveTo::Target);
+    EXPECT_EQ(tree.reason(result.reason), "Chasing");
+    
+    // Idle: the counter lives in the blackboard, so two agents count independently
+    BehaviorTree::Blackboard other;
+    context = idleContext();
+    context[BehaviorFact::HasPatrol] = 1.0f;
+    context[BehaviorFact::AlertTimer] = 5.0f;
+    for (int tick = 0; tick < 2; ++tick) {
+        tree.evaluate(context, blackboard, result);
+        EXPECT_FALSE(result.decided);
+    }
+    tree.evaluate(context, other, result);
+    EXPECT_FALSE(result.decided);
+    tree.evaluate(context, blackboard, result);
+    ASSERT_TRUE(result.decided);
+    EXPECT_EQ(result.state, AIState::PATROL);   // Step score 2 beats linear 0.5
+    EXPECT_FLOAT_EQ(blackboard.slots[0], 0.0f);
+    EXPECT_FLOAT_EQ(other.slots[0], 1.0f);
+    
+    EXPECT_FALSE(tree.loadFromString(R"({"root": {"if": "unknownFact", "value": 1}})"));
+    EXPECT_FALSE(tree.loadFromString(R"({"root": {"action": "DANCE"}})"));
+    EXPECT_EQ(tree.nodeCount(), 21u);   // A failed load keeps the previous tree
+}
+
+TEST_F(BehaviorTreeTest, ManagerSharesTreeBetweenAgents) {
+    AIManager manager;
+    ASSERT_TRUE(manager.loadBehaviorTreeFromString("restless", treeJson_));
+    const BehaviorTree* tree = manager.getBehaviorTree("restless");
+    ASSERT_NE(tree, nullptr);
+    
+    MockEntity first(1, {0.0f, 0.0f});
+    MockEntity second(2, {500.0f, 0.0f});
+    MockEntity plain(3, {900.0f, 0.0f});
+    AIAgentConfig config;
+    config.behaviorTree = "restless";
+    manager.addAgent(&first, config);
+    manager.addAgent(&second, config);
+    manager.addAgent(&plain);
+    manager.getAgent(&first)->setPatrolPoints({{0.0f, 0.0f}, {100.0f, 0.0f}});
+    
+    EXPECT_EQ(manager.getAgent(&first)->getBehaviorTree(), tree);
+    EXPECT_EQ(manager.getAgent(&second)->getBehaviorTree(), tree);
+    EXPECT_EQ(manager.getAgent(&plain)->getBehaviorTree(), nullptr);
+    
+    for (int tick = 0; tick < 3; ++tick) {
+        manager.updateAll(1.0f / 60.0f, nullptr, nullptr);
+    }
+    EXPECT_EQ(manager.getAgent(&first)->getCurrentState(), AIState::PATROL);
+    EXPECT_EQ(manager.getAgent(&second)->getCurrentState(), AIState::IDLE);    // Utility scores 0: no action
+    EXPECT_EQ(manager.getAgent(&plain)->getCurrentState(), AIState::IDLE);
+}
+
+class CrowdSteeringTest : public ::testing::Test {
+protected:
+    // Two enemies walking head-on through each other's start; returns final x positions
+    std::pair<float, float> crossEnemies(bool steering) {
+        collisions::CollisionManager collisionManager;
+        Enemy left(1, {100.f, 200.f}, {32.f, 32.f}, 100.f);
+        Enemy right(2, {400.f, 200.f}, {32.f, 32.f}, 100.f);
+        EnemyManager manager;
+        CrowdSteeringConfig config;
+        config.enabled = steering;
+        manager.crowdSteering().setConfig(config);
+        manager.addEnemyPointer(&left);
+        manager.addEnemyPointer(&right);
+        
+        const float dt = 1.0f / 60.0f;
+        for (int tick = 0; tick < 300; ++tick) {
+            for (Enemy* e : {&left, &right}) {
+                collisionManager.updateColliderBounds(e, sf::FloatRect(e->position(), e->size()));
+            }
+            left.moveTowards({500.f, 200.f}, dt);
+            right.moveTowards({0.f, 200.f}, dt);
+            manager.steerAllMoves(dt);
+            manager.commitAllMoves(&collisionManager);
+        }
+        return {left.position().x, right.position().x};
+    }
+};
+
+TEST_F(CrowdSteeringTest, CrossingGroupsKeepApartWithLocalQueries) {
+    CrowdSteeringConfig config;
+    config.cellSize = 96.0f;
+    config.neighborRadius = 96.0f;
+    config.timeHorizon = 0.6f;
+    CrowdSteering crowd(config);
+    
+    // Head-on pair sidesteps in opposite directions
+    crowd.add({0.f, 0.f}, {100.f, 0.f}, 10.f, 100.f);
+    crowd.add({60.f, 0.f}, {-100.f, 0.f}, 10.f, 100.f);
+    crowd.solve();
+    EXPECT_LT(crowd.velocity(0).y * crowd.velocity(1).y, 0.0f);
+    
+    // Two 10x10 blocks swapping places
+    const int side = 10;
+    std::vector<sf::Vector2f> positions;
+    std::vector<sf::Vector2f> goals;
+    for (int i = 0; i < side * side; ++i) {
+        float y = (i % side) * 60.f;
+        float x = (i / side) * 60.f;
+        positions.push_back({x, y});
+        goals.push_back({x + 900.f, y});
+        positions.push_back({x + 900.f, y + 30.f});
+        goals.push_back({x, y + 30.f});
+    }
+    
+    const float dt = 1.0f / 30.0f;
+    float closest = 1.0e9f;
+    int mostTested = 0;
+    for (int tick = 0; tick < 240; ++tick) {
+        crowd.clear();
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            sf::Vector2f toGoal = goals[i] - positions[i];
+            float length = std::sqrt(toGoal.x * toGoal.x + toGoal.y * toGoal.y);
+            sf::Vector2f desired = length > 1.0f ? toGoal / length * 80.f : sf::Vector2f(0.f, 0.f);
+            crowd.add(positions[i], desired, 10.f, 80.f);
+        }
+        crowd.resetStats();
+        crowd.solve();
+        mostTested = std::max(mostTested, crowd.getStats().neighborsTested);
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            positions[i] += crowd.velocity(i) * dt;
+        }
+        if (tick >= 120) continue;  // Closest approach happens while crossing
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            for (std::size_t j = i + 1; j < positions.size(); ++j) {
+                sf::Vector2f d = positions[j] - positions[i];
+                closest = std::min(closest, std::sqrt(d.x * d.x + d.y * d.y));
+            }
+        }
+    }
+    EXPECT_GT(closest, 10.0f);   // Never more than half overlapped
+    // Neighbor tests stay local instead of scanning all n * (n - 1) pairs
+    int pairs = static_cast<int>(positions.size() * (positions.size() - 1));
+    EXPECT_LT(mostTested, pairs / 3) << mostTested;
+}
+
+TEST_F(CrowdSteeringTest, EnemiesPassInsteadOfStalling) {
+    auto stalled = crossEnemies(false);
+    EXPECT_LT(stalled.first, stalled.second);     // Moves clipped at contact: stuck face to face
+    
+    auto crossed = crossEnemies(true);
+    EXPECT_GT(crossed.first, 400.f);
+    EXPECT_LT(crossed.second, 100.f);
+}
+
+TEST_F(CrowdSteeringTest, BatchedCommitClipsConflictsRegardlessOfOrder) {
+    struct Outcome {
+        sf::Vector2f left, right, diagonal;
+        EnemyManager::CommitStats stats;
+    };
+    auto commit = [](bool reversed) {
+        collisions::CollisionManager collisionManager;
+        MockEntity wall(10, {340.f, 200.f});
+        wall.setCollisionLayer(entities::Entity::Layer::Wall);
+        collisionManager.addCollider(&wall, sf::FloatRect({340.f, 200.f}, {8.f, 300.f}));
+        
+        Enemy left(1, {100.f, 200.f}, {32.f, 32.f}, 100.f);
+        Enemy right(2, {164.f, 200.f}, {32.f, 32.f}, 100.f);
+        Enemy diagonal(3, {300.f, 300.f}, {32.f, 32.f}, 100.f);
+        EnemyManager manager;
+        for (Enemy* e : reversed ? std::vector<Enemy*>{&diagonal, &right, &left}
+                                 : std::vector<Enemy*>{&left, &right, &diagonal}) {
+            manager.addEnemyPointer(e);
+        }
+        left.moveTowards({300.f, 216.f}, 0.5f);
+        right.moveTowards({0.f, 216.f}, 0.5f);
+        diagonal.moveTowards({400.f, 400.f}, 0.5f);
+        manager.commitAllMoves(&collisionManager);
+        
+        // Colliders follow the committed positions
+        std::vector<const collisions::CollisionBox*> hits;
+        collisionManager.queryBounds(sf::FloatRect(diagonal.position(), diagonal.size()), hits,
+                                     entities::kLayerMaskEnemy);
+        EXPECT_EQ(hits.size(), 1u);
+        return Outcome{left.position(), right.position(), diagonal.position(), manager.getCommitStats()};
+    };
+    
+    Outcome forward = commit(false);
+    Outcome backward = commit(true);
+    EXPECT_EQ(forward.left, backward.left);
+    EXPECT_EQ(forward.right, backward.right);
+    EXPECT_EQ(forward.diagonal, backward.diagonal);
+    
+    // Both halves of the head-on pair advance to contact and no further
+    EXPECT_GT(forward.left.x, 100.f);
+    EXPECT_LT(forward.right.x, 164.f);
+    EXPECT_LE(forward.left.x + 32.f, forward.right.x);
+    EXPECT_NEAR(forward.left.x - 100.f, 164.f - forward.right.x, 0.1f);
+    // The diagonal mover slides along the wall instead of stopping
+    EXPECT_EQ(forward.diagonal.x, 300.f);
+    EXPECT_GT(forward.diagonal.y, 300.f);
+    EXPECT_EQ(forward.stats.agentConflicts, 1);
+    EXPECT_EQ(forward.stats.slid, 1);
+    EXPECT_EQ(forward.stats.moved, 3);
+}
+
+class LODSchedulerTest : public ::testing::Test {
+protected:
+    void addAgent(const sf::Vector2f& position) {
+        entities_.push_back(std::make_unique<MockEntity>(static_cast<entities::Entity::Id>(entities_.size() + 1),
+                                                         position));
+        agents_.push_back(std::make_unique<AIAgent>(entities_.back().get()));
+        agentPtrs_.push_back(agents_.back().get());
+    }
+    
+    std::vector<std::unique_ptr<MockEntity>> entities_;
+    std::vector<std::unique_ptr<AIAgent>> agents_;
+    std::vector<AIAgent*> agentPtrs_;
+};
+
+TEST_F(LODSchedulerTest, StaggersMidAgentsAndCarriesSkippedTime) {
+    LODConfig config;
+    config.nearDistance = 100.0f;
+    config.farDistance = 500.0f;
+    config.midUpdateInterval = 4;
+    LODScheduler scheduler(config);
+    
+    addAgent({10.0f, 0.0f});                                // Near
+    for (int i = 0; i < 4; ++i) addAgent({200.0f, 0.0f});   // Mid
+    addAgent({900.0f, 0.0f});                               // Far
+    
+    sf::Vector2f focus(0.0f, 0.0f);
+    std::vector<int> fullUpdates(agentPtrs_.size(), 0);
+    for (int frame = 0; frame < 8; ++frame) {
+        const auto& tasks = scheduler.schedule(agentPtrs_, &focus, 0.1f);
+        int midFull = 0;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            if (tasks[i].kind == LODScheduler::UpdateKind::Full) {
+                ++fullUpdates[i];
+                if (tasks[i].tier == LODTier::Mid) {
+                    ++midFull;
+                    if (frame >= 4) {
+                        EXPECT_NEAR(tasks[i].deltaTime, 0.4f, 1e-4f);
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(midFull, 1);  // Even share per frame
+        EXPECT_EQ(tasks[0].kind, LODScheduler::UpdateKind::Full);
+        EXPECT_EQ(tasks[5].kind, LODScheduler::UpdateKind::LowDetail);
+    }
+    for (int i = 1; i <= 4; ++i) EXPECT_EQ(fullUpdates[i], 2);
+}
+
+TEST_F(LODSchedulerTest, FrameBudgetRotatesOverdueAgents) {
+    LODConfig config;
+    config.maxFullUpdatesPerFrame = 2;
+    LODScheduler scheduler(config);
+    for (int i = 0; i < 3; ++i) addAgent({0.0f, 0.0f});
+    
+    std::vector<float> simulated(3, 0.0f);
+    for (int frame = 0; frame < 6; ++frame) {
+        const auto& tasks = scheduler.schedule(agentPtrs_, nullptr, 0.1f);
+        EXPECT_EQ(scheduler.getStats().fullUpdates, 2);
+        for (std::size_t i = 0; i < tasks.size(); ++i) simulated[i] += tasks[i].deltaTime;
+    }
+    // Nobody starves: every agent is at most one frame behind
+    for (float time : simulated) EXPECT_GE(time, 0.5f - 1e-4f);
+}
+
 class AIManagerTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -304,6 +1403,29 @@ TEST_F(AIManagerTest, EventBroadcasting) {
     EXPECT_EQ(metrics.totalAgents, 1);  // entity1 should be removed
 }
 
+TEST_F(AIManagerTest, EntityDeathReachesOnlyTargetHolders) {
+    MockEntity target(3, sf::Vector2f(150, 150));
+    manager_->addAgent(entity1_.get(), AIAgentConfig{});
+    manager_->addAgent(entity2_.get(), AIAgentConfig{});
+    AIAgent* holder = manager_->getAgent(entity1_.get());
+    AIAgent* bystander = manager_->getAgent(entity2_.get());
+    
+    holder->addTarget(&target, Priority::HIGH);
+    bystander->addTarget(entity1_.get(), Priority::MEDIUM);
+    const TargetIndex& index = manager_->getTargetIndex();
+    EXPECT_EQ(index.holderCount(&target), 1u);
+    EXPECT_EQ(index.targetCount(), 2u);
+    
+    manager_->onEntityDied(&target);
+    EXPECT_EQ(holder->getPrimaryTarget(), nullptr);
+    EXPECT_EQ(bystander->getPrimaryTarget(), entity1_.get());
+    EXPECT_EQ(index.holderCount(&target), 0u);
+    
+    // A removed agent takes its links with it
+    manager_->removeAgent(entity2_.get());
+    EXPECT_EQ(index.targetCount(), 0u);
+}
+
 TEST_F(AIManagerTest, Coordination) {
     AIAgentConfig config;
     manager_->addAgent(entity1_.get(), config);
@@ -331,6 +1453,24 @@ TEST_F(AIManagerTest, PerformanceMetrics) {
     EXPECT_EQ(metrics.totalPerceptionChecks, 0);
 }
 
+TEST_F(AIManagerTest, CachedPlayerFollowsEntityRemoval) {
+    entities::EntityManager entityManager;
+    entityManager.addEntity(std::make_unique<entities::Player>(1, sf::Vector2f(100.0f, 100.0f)));
+    manager_->updateAll(0.016f, &entityManager, nullptr);
+    EXPECT_EQ(manager_->getPlayer(), entityManager.getEntity(1));
+    
+    // Same entity count afterwards, so only the id check notices the swap
+    entityManager.addEntity(std::make_unique<entities::Player>(2, sf::Vector2f(200.0f, 200.0f)));
+    entityManager.removeEntity(1);
+    manager_->updateAll(0.016f, &entityManager, nullptr);
+    EXPECT_EQ(manager_->getPlayer(), entityManager.getEntity(2));
+    
+    entityManager.addEntity(std::make_unique<MockEntity>(3, sf::Vector2f(0.0f, 0.0f)));
+    entityManager.removeEntity(2);
+    manager_->updateAll(0.016f, &entityManager, nullptr);
+    EXPECT_EQ(manager_->getPlayer(), nullptr);
+}
+
 TEST_F(AIManagerTest, DebugInfo) {
     AIAgentConfig config;
     manager_->addAgent(entity1_.get(), config);
@@ -340,5 +1480,568 @@ TEST_F(AIManagerTest, DebugInfo) {
     EXPECT_GE(debugInfo.performance.totalAgents, 1);
 }
 
+TEST_F(AIManagerTest, AlertsReachOnlyAgentsInRadius) {
+    // 20x20 agents on a 100px lattice; a 150px alert must touch only nearby cells
+    std::vector<std::unique_ptr<MockEntity>> entities;
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            entities.push_back(std::make_unique<MockEntity>(static_cast<entities::Entity::Id>(100 + y * 20 + x),
+                                                            sf::Vector2f(x * 100.0f, y * 100.0f)));
+            manager_->addAgent(entities.back().get());
+        }
+    }
+    
+    auto inRange = manager_->getAgentsInRadius({1000.0f, 1000.0f}, 150.0f);
+    EXPECT_EQ(inRange.size(), 9u);  // Lattice points within 1.5 spacings
+    
+    manager_->alertAgentsInRadius({1000.0f, 1000.0f}, 150.0f, entities[10 * 20 + 10].get());
+    int alerted = 0;
+    for (const auto& entity : entities) {
+        if (manager_->getAgent(entity.get())->getCurrentState() == AIState::ALERT) ++alerted;
+    }
+    EXPECT_EQ(alerted, 8);  // Everyone in range except the source
+    EXPECT_LT(manager_->getAgentGrid().getStats().candidatesTested, 200);
+}
+
+TEST_F(AIManagerTest, SharedTargetsReachAgentsThroughBlackboardChanges) {
+    manager_->addAgent(entity1_.get());
+    manager_->addAgent(entity2_.get());
+    MockEntity target(3, sf::Vector2f(120, 100));
+    
+    // Published now, delivered by the next coordination update to agents in range
+    manager_->shareTargetInformation(&target, target.position());
+    EXPECT_EQ(manager_->getAgent(entity1_.get())->getPrimaryTarget(), nullptr);
+    manager_->updateAll(0.11f, nullptr, nullptr);
+    EXPECT_EQ(manager_->getAgent(entity1_.get())->getPrimaryTarget(), &target);
+    EXPECT_EQ(manager_->getAgent(entity2_.get())->getPrimaryTarget(), nullptr);
+    
+    // Nothing changes: re-reports are suppressed and no agent reads anything
+    auto metrics = manager_->getPerformanceMetrics();
+    EXPECT_EQ(metrics.blackboardWrites, 1);
+    EXPECT_EQ(metrics.blackboardDeliveries, 2);
+    for (int tick = 0; tick < 5; ++tick) {
+        manager_->updateAll(0.11f, nullptr, nullptr);
+    }
+    metrics = manager_->getPerformanceMetrics();
+    EXPECT_EQ(metrics.blackboardWrites, 1);
+    EXPECT_EQ(metrics.blackboardDeliveries, 2);
+    
+    manager_->onEntityDied(&target);
+    EXPECT_EQ(manager_->getTeamBlackboard().targetPosition(&target), nullptr);
+}
+
+TEST_F(AIManagerTest, StationaryTargetReachesAgentsWalkingIntoRange) {
+    manager_->addAgent(entity1_.get());
+    manager_->addAgent(entity2_.get());
+    MockEntity target(3, sf::Vector2f(120, 100));
+    manager_->shareTargetInformation(&target, target.position());
+    manager_->updateAll(0.11f, nullptr, nullptr);
+    AIAgent* walker = manager_->getAgent(entity2_.get());
+    EXPECT_EQ(walker->getPrimaryTarget(), nullptr);
+    
+    // The target keeps being reported where it is, so its entry never changes again
+    entity2_->setPosition(sf::Vector2f(150, 130));
+    for (int tick = 0; tick < 3; ++tick) {
+        manager_->shareTargetInformation(&target, target.position());
+        manager_->updateAll(0.11f, nullptr, nullptr);
+    }
+    EXPECT_EQ(walker->getPrimaryTarget(), &target);
+    EXPECT_EQ(manager_->getPerformanceMetrics().blackboardWrites, 1);
+    EXPECT_EQ(manager_->getPerformanceMetrics().blackboardHandoffs, 1);
+    
+    // Dropping it is final: standing still or walking on does not hand it back
+    walker->removeTarget(&target);
+    manager_->updateAll(0.11f, nullptr, nullptr);
+    entity2_->setPosition(sf::Vector2f(130, 120));
+    manager_->updateAll(0.11f, nullptr, nullptr);
+    EXPECT_EQ(walker->getPrimaryTarget(), nullptr);
+    EXPECT_EQ(manager_->getPerformanceMetrics().blackboardHandoffs, 1);
+    
+    // A real move of the target is new information and reaches it again
+    target.setPosition(sf::Vector2f(140, 100));
+    manager_->shareTargetInformation(&target, target.position());
+    manager_->updateAll(0.11f, nullptr, nullptr);
+    EXPECT_EQ(walker->getPrimaryTarget(), &target);
+}
+
+class TeamBlackboardTest : public ::testing::Test {
+protected:
+    using Slot = TeamBlackboard::Slot;
+    
+    std::vector<const TeamBlackboard::Entry*> changes_;
+};
+
+TEST_F(TeamBlackboardTest, ReadersOnlySeeTheirChangesSinceCursor) {
+    TeamBlackboardConfig config;
+    config.changeLogCapacity = 8;
+    TeamBlackboard board(config);
+    MockEntity player(1, {0, 0});
+    
+    board.postTargetPosition(&player, {100, 100}, 7);
+    board.postAlertZone({50, 50}, 80.0f);
+    TeamBlackboard::Mask targets = TeamBlackboard::maskOf(Slot::TargetPosition);
+    TeamBlackboard::Version cursor = board.changesSince(0, targets, changes_);
+    ASSERT_EQ(changes_.size(), 1u);
+    EXPECT_EQ(changes_[0]->entity, &player);
+    EXPECT_EQ(changes_[0]->owner, 7u);
+    
+    // A small move is not a change; two real moves arrive once, with the latest data
+    board.postTargetPosition(&player, {102, 101});
+    EXPECT_EQ(board.latestVersion(targets), changes_[0]->version);
+    board.postTargetPosition(&player, {200, 100});
+    board.postTargetPosition(&player, {300, 100});
+    board.postAlertZone({60, 60}, 80.0f);
+    cursor = board.changesSince(cursor, targets, changes_);
+    ASSERT_EQ(changes_.size(), 1u);
+    EXPECT_EQ(changes_[0]->position, sf::Vector2f(300, 100));
+    EXPECT_EQ(board.getStats().suppressed, 1);
+    EXPECT_EQ(board.changesSince(cursor, targets, changes_), cursor);
+    EXPECT_TRUE(changes_.empty());
+    
+    // Flank claims keep their spacing; releasing one is itself a change
+    EXPECT_TRUE(board.claimFlank(10, {400, 400}));
+    EXPECT_FALSE(board.claimFlank(11, {420, 400}));
+    EXPECT_TRUE(board.claimFlank(11, {500, 400}));
+    board.releaseFlank(10);
+    EXPECT_TRUE(board.claimFlank(12, {420, 400}));
+    
+    // Far behind the trimmed log: a full scan gives the same answer
+    for (int i = 0; i < 12; ++i) {
+        board.postAlertZone({static_cast<float>(i), 0}, 10.0f);
+    }
+    board.changesSince(0, TeamBlackboard::maskOf(Slot::FlankClaim), changes_);
+    EXPECT_EQ(board.getStats().fullScans, 1);
+    ASSERT_EQ(changes_.size(), 3u);
+    EXPECT_EQ(changes_[0]->key, 11u);       // Version order
+    EXPECT_EQ(changes_[1]->key, 10u);
+    EXPECT_FALSE(changes_[1]->active);      // Released
+    EXPECT_EQ(changes_[2]->key, 12u);
+    
+    // Lifetimes: targets and alert zones expire, claims stay. A repeat report
+    // of a target that has not moved does not keep it alive.
+    board.setTime(config.targetLifetime * 0.5f);
+    board.postTargetPosition(&player, board.targetPosition(&player)->position);
+    board.setTime(config.targetLifetime + 1.0f);
+    board.expire();
+    EXPECT_EQ(board.targetPosition(&player), nullptr);
+    board.collect(Slot::AlertZone, changes_);
+    EXPECT_TRUE(changes_.empty());
+    EXPECT_NE(board.flankClaim(12), nullptr);
+}
+
+class StateBucketsTest : public ::testing::Test {
+protected:
+    // Two identical packs: one updated agent by agent, one through the buckets
+    void SetUp() override {
+        for (int pack = 0; pack < 2; ++pack) {
+            queues_[pack].setNavGrid(&grid_);
+            for (int i = 0; i < 12; ++i) {
+                sf::Vector2f position(50.0f + i * 37.0f, 80.0f + (i % 3) * 45.0f);
+                entities_[pack].push_back(std::make_unique<MockEntity>(static_cast<entities::Entity::Id>(i + 1), position));
+                AIAgentConfig config;
+                config.profile = i % 2 ? BehaviorProfile::GUARD : BehaviorProfile::NEUTRAL;
+                config.speed = 60.0f + i * 5.0f;
+                agents_[pack].push_back(std::make_unique<AIAgent>(entities_[pack].back().get(), config));
+                AIAgent& agent = *agents_[pack].back();
+                agent.setPathRequestQueue(&queues_[pack]);
+                if (i % 3 == 0) continue;   // Stays idle
+                agent.setPatrolPoints({position + sf::Vector2f(90.0f, 0.0f), position + sf::Vector2f(90.0f, 70.0f)});
+                agent.changeState(AIState::PATROL, "Test");
+            }
+        }
+    }
+    
+    NavGrid grid_;
+    PathRequestQueue queues_[2];
+    std::vector<std::unique_ptr<MockEntity>> entities_[2];
+    std::vector<std::unique_ptr<AIAgent>> agents_[2];
+};
+
+TEST_F(StateBucketsTest, BatchedCommitMatchesPerAgentUpdate) {
+    AgentStateBuckets buckets;
+    const float dt = 1.0f / 60.0f;
+    int moved = 0;
+    int patrolling = 0;
+    for (int tick = 0; tick < 120; ++tick) {
+        for (auto& agent : agents_[0]) {
+            agent->update(dt, nullptr, nullptr);
+        }
+        
+        buckets.clear();
+        for (auto& agent : agents_[1]) {
+            agent->think(dt, nullptr, nullptr);
+            if (agent->applyDecision(dt)) buckets.add(agent.get(), dt);
+        }
+        std::size_t bucketed = 0;
+        for (std::size_t state = 0; state < AgentStateBuckets::kStateCount; ++state) {
+            for (AIAgent* agent : buckets.bucket(static_cast<AIState>(state))) {
+                EXPECT_EQ(agent->getCurrentState(), static_cast<AIState>(state));
+            }
+            bucketed += buckets.bucket(static_cast<AIState>(state)).size();
+        }
+        EXPECT_EQ(bucketed, agents_[1].size());
+        buckets.executeStates(nullptr);
+        buckets.integrateMovement();
+        moved += buckets.getStats().moved;
+        queues_[0].process();
+        queues_[1].process();
+        patrolling += buckets.getStats().agentsPerState[static_cast<std::size_t>(AIState::PATROL)];
+    }
+    
+    EXPECT_GT(patrolling, 0);
+    EXPECT_GT(moved, 0);
+    for (std::size_t i = 0; i < agents_[0].size(); ++i) {
+        EXPECT_EQ(entities_[0][i]->position(), entities_[1][i]->position());
+        EXPECT_EQ(agents_[0][i]->getCurrentState(), agents_[1][i]->getCurrentState());
+    }
+}
+
+class ParallelUpdateTest : public ::testing::Test {
+protected:
+    struct AgentSnapshot {
+        sf::Vector2f position;
+        AIState state;
+    };
+    
+    // Same scene under a given worker count: a player, a wall and a pack of
+    // mixed-profile agents; returns per-entity state after a few seconds
+    std::vector<AgentSnapshot> simulate(int workerThreads, int ticks) {
+        entities::EntityManager entityManager;
+        collisions::CollisionManager collisionManager;
+        entityManager.setCollisionManager(&collisionManager);
+        
+        entityManager.addEntity(std::make_unique<entities::Player>(1, sf::Vector2f(400.0f, 300.0f)));
+        entityManager.addEntity(std::make_unique<MockEntity>(2, sf::Vector2f(300.0f, 200.0f), sf::Vector2f(8, 200)));
+        entities::Entity* wall = entityManager.getEntity(2);
+        wall->setCollisionLayer(entities::Entity::Layer::Wall);
+        collisionManager.addCollider(wall, sf::FloatRect({300.0f, 200.0f}, {8.0f, 200.0f}));
+        
+        CoordinationConfig config;
+        config.workerThreads = workerThreads;
+        AIManager manager(config);
+        const BehaviorProfile profiles[] = {BehaviorProfile::AGGRESSIVE, BehaviorProfile::SCOUT,
+                                            BehaviorProfile::GUARD, BehaviorProfile::NEUTRAL};
+        for (int i = 0; i < 24; ++i) {
+            entities::Entity::Id id = static_cast<entities::Entity::Id>(10 + i);
+            sf::Vector2f position(100.0f + (i % 6) * 80.0f, 100.0f + (i / 6) * 90.0f);
+            entityManager.addEntity(std::make_unique<MockEntity>(id, position));
+            AIAgentConfig agentConfig;
+            agentConfig.profile = profiles[i % 4];
+            manager.addAgent(entityManager.getEntity(id), agentConfig);
+            manager.getAgent(entityManager.getEntity(id))->setPatrolPoints({position, position + sf::Vector2f(60.0f, 0.0f)});
+        }
+        
+        for (int tick = 0; tick < ticks; ++tick) {
+            manager.updateAll(1.0f / 60.0f, &entityManager, &collisionManager);
+        }
+        
+        std::vector<AgentSnapshot> snapshot;
+        for (int i = 0; i < 24; ++i) {
+            entities::Entity* entity = entityManager.getEntity(static_cast<entities::Entity::Id>(10 + i));
+            snapshot.push_back({entity->position(), manager.getAgent(entity)->getCurrentState()});
+        }
+        return snapshot;
+    }
+};
+
+TEST_F(ParallelUpdateTest, ThreadPoolCoversRangeOnce) {
+    core::ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto& hit : hits) hit = 0;
+    pool.parallelFor(hits.size(), [&hits](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) ++hits[i];
+    });
+    for (const auto& hit : hits) EXPECT_EQ(hit.load(), 1);
+    
+    EXPECT_THROW(pool.parallelFor(100, [](std::size_t begin, std::size_t) {
+        if (begin == 0) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+}
+
+TEST_F(ParallelUpdateTest, WorkerThreadsMatchSerialRun) {
+    auto serial = simulate(0, 120);
+    auto parallel = simulate(4, 120);
+    ASSERT_EQ(serial.size(), parallel.size());
+    bool anyMoved = false;
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].state, parallel[i].state);
+        EXPECT_EQ(serial[i].position.x, parallel[i].position.x);
+        EXPECT_EQ(serial[i].position.y, parallel[i].position.y);
+        anyMoved |= serial[i].state != AIState::IDLE;
+    }
+    EXPECT_TRUE(anyMoved);
+}
+
+class EnemyPipelineTest : public ::testing::Test {
+protected:
+    struct Outcome {
+        sf::Vector2f patroller;
+        sf::Vector2f hunter;
+        AIState hunterState;
+        EnemyManager::PipelineStats stats;
+    };
+    
+    // A patroller out of sight and a hunter next to the player, ticked the way
+    // a scene does: EntityManager::updateAll first, then the AI manager
+    Outcome simulate(int workerThreads, int ticks) {
+        entities::EntityManager entityManager;
+        collisions::CollisionManager collisionManager;
+        entityManager.setCollisionManager(&collisionManager);
+        entityManager.addEntity(std::make_unique<entities::Player>(1, sf::Vector2f(400.0f, 300.0f)));
+        entityManager.addEntity(std::make_unique<Enemy>(10, sf::Vector2f(100.0f, 100.0f), sf::Vector2f(32.0f, 32.0f), 60.0f,
+                                                        200.0f, 24.0f,
+                                                        std::vector<sf::Vector2f>{{100.0f, 100.0f}, {300.0f, 100.0f}}));
+        entityManager.addEntity(std::make_unique<Enemy>(11, sf::Vector2f(500.0f, 300.0f), sf::Vector2f(32.0f, 32.0f), 60.0f));
+        auto* patroller = static_cast<Enemy*>(entityManager.getEntity(10));
+        auto* hunter = static_cast<Enemy*>(entityManager.getEntity(11));
+        
+        CoordinationConfig config;
+        config.workerThreads = workerThreads;
+        AIManager manager(config);
+        manager.addEnemyPointer(patroller);
+        manager.addEnemyPointer(hunter);
+        
+        const float dt = 1.0f / 60.0f;
+        for (int tick = 0; tick < ticks; ++tick) {
+            entityManager.updateAll(dt);
+            manager.updateAll(dt, &entityManager, &collisionManager);
+        }
+        return Outcome{patroller->position(), hunter->position(), hunter->getCurrentState(),
+                       manager.getEnemyPipeline().getPipelineStats()};
+    }
+};
+
+TEST_F(EnemyPipelineTest, EnemiesRunOncePerFrameAndCommitMoves) {
+    const int ticks = 30;
+    Outcome outcome = simulate(0, ticks);
+    
+    // IDLE -> PATROL, skip the start point, then one committed step per frame
+    EXPECT_NEAR(outcome.patroller.x, 100.0f + (ticks - 2) * 1.0f, 0.01f);
+    EXPECT_EQ(outcome.patroller.y, 100.0f);
+    
+    // The cached player is the hunter's target without a per-enemy type lookup
+    EXPECT_LT(outcome.hunter.x, 500.0f);
+    EXPECT_TRUE(outcome.hunterState == AIState::CHASE || outcome.hunterState == AIState::ATTACK);
+    EXPECT_EQ(outcome.stats.frames, ticks);
+    EXPECT_EQ(outcome.stats.enemies, 2);
+    EXPECT_EQ(outcome.stats.sawPlayer, 1);
+}
+
+TEST_F(EnemyPipelineTest, ParallelSenseMatchesSerialRun) {
+    Outcome serial = simulate(0, 90);
+    Outcome parallel = simulate(3, 90);
+    EXPECT_EQ(serial.patroller, parallel.patroller);
+    EXPECT_EQ(serial.hunter, parallel.hunter);
+    EXPECT_EQ(serial.hunterState, parallel.hunterState);
+}
+
+class StressScenarioTest : public ::testing::Test {
+protected:
+    struct World {
+        entities::EntityManager entityManager;
+        collisions::CollisionManager collisionManager;
+        AIManager manager;
+        StressScenario scenario;
+        
+        explicit World(const StressScenarioConfig& config, const CoordinationConfig& coordination = CoordinationConfig{})
+            : manager(coordination), scenario(config) {
+            scenario.populate(entityManager, collisionManager, manager);
+        }
+    };
+    
+    static StressScenarioConfig config(std::uint32_t seed) {
+        StressScenarioConfig scenarioConfig;
+        scenarioConfig.seed = seed;
+        scenarioConfig.agentCount = 60;
+        return scenarioConfig;
+    }
+};
+
+TEST_F(StressScenarioTest, SameSeedBuildsSameScenario) {
+    World first(config(7));
+    World second(config(7));
+    World other(config(8));
+    
+    ASSERT_EQ(first.scenario.getStats().agents, 60);
+    EXPECT_GT(first.scenario.getStats().walls, 4);
+    EXPECT_EQ(first.entityManager.count(), second.entityManager.count());
+    EXPECT_EQ(first.scenario.getStats().profiles, second.scenario.getStats().profiles);
+    int profilesUsed = 0;
+    for (int count : first.scenario.getStats().profiles) profilesUsed += count > 0 ? 1 : 0;
+    EXPECT_GE(profilesUsed, 4);
+    
+    bool differs = false;
+    for (std::size_t i = 0; i < first.scenario.getAgents().size(); ++i) {
+        StressAgent* a = first.scenario.getAgents()[i];
+        StressAgent* b = second.scenario.getAgents()[i];
+        EXPECT_EQ(a->position(), b->position());
+        EXPECT_EQ(a->getProfile(), b->getProfile());
+        EXPECT_EQ(first.manager.getAgent(a)->getPatrolPoints(), second.manager.getAgent(b)->getPatrolPoints());
+        differs = differs || a->position() != other.scenario.getAgents()[i]->position();
+        
+        // Agents spawn on free cells: the baked nav grid agrees
+        sf::Vector2f center = a->position() + a->size() * 0.5f;
+        sf::Vector2i cell = first.manager.getNavGrid().worldToCell(center);
+        EXPECT_FALSE(first.manager.getNavGrid().isBlocked(cell.x, cell.y));
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST_F(StressScenarioTest, UpdateReportsStageTimings) {
+    World world(config(3));
+    for (int frame = 0; frame < 5; ++frame) {
+        world.manager.updateAll(1.0f / 60.0f, &world.entityManager, &world.collisionManager);
+    }
+    
+    auto metrics = world.manager.getPerformanceMetrics();
+    EXPECT_EQ(metrics.totalAgents, 60);
+    EXPECT_GT(metrics.lodFullUpdates + metrics.lodLowDetailUpdates + metrics.lodSkippedUpdates, 0);
+    EXPECT_GE(metrics.perceptionTime, 0.0f);
+    EXPECT_GE(metrics.decisionTime, 0.0f);
+    EXPECT_GE(metrics.behaviorTime, 0.0f);
+    EXPECT_GE(metrics.pathfindingTime, 0.0f);
+    EXPECT_GE(metrics.movementTime, 0.0f);
+    EXPECT_LE(metrics.perceptionTime + metrics.decisionTime + metrics.behaviorTime + metrics.pathfindingTime +
+              metrics.movementTime, metrics.coordinationUpdateTime + 0.01f);
+    EXPECT_GT(metrics.coordinationUpdateTime, 0.0f);
+}
+
+TEST_F(StressScenarioTest, ProfilerKeepsSlowestAgentTicks) {
+    CoordinationConfig coordination;
+    coordination.profiler.topK = 5;
+    coordination.profiler.windowFrames = 3;
+    coordination.profiler.spikeThresholdMs = 0.0f;    // Every tick counts as a spike
+    World world(config(5), coordination);
+    for (int frame = 0; frame < 10; ++frame) {
+        world.manager.updateAll(1.0f / 60.0f, &world.entityManager, &world.collisionManager);
+    }
+    
+    const AgentProfiler& profiler = world.manager.getAgentProfiler();
+    const auto& slowest = profiler.getSlowest();
+    ASSERT_FALSE(slowest.empty());
+    EXPECT_LE(slowest.size(), 5u);
+    EXPECT_EQ(profiler.getStats().frames, 10u);
+    EXPECT_EQ(static_cast<std::uint64_t>(profiler.getStats().spikes), profiler.getStats().samples);
+    for (std::size_t i = 0; i < slowest.size(); ++i) {
+        const auto& sample = slowest[i];
+        if (i > 0) {
+            EXPECT_GE(slowest[i - 1].totalMs, sample.totalMs);
+        }
+        EXPECT_GT(sample.frame, 7u);    // Inside the 3-frame window
+        float stages = sample.stageMs[0] + sample.stageMs[1] + sample.stageMs[2] + sample.stageMs[3];
+        EXPECT_NEAR(stages, sample.totalMs, 0.001f);
+        EXPECT_EQ(sample.stageMs[static_cast<std::size_t>(sample.slowestStage)],
+                  *std::max_element(sample.stageMs.begin(), sample.stageMs.end()));
+        for (std::size_t j = 0; j < i; ++j) EXPECT_NE(slowest[j].entityId, sample.entityId);
+    }
+    EXPECT_EQ(world.manager.getDebugInfo().slowestAgents.size(), slowest.size());
+    
+    auto report = nlohmann::json::parse(profiler.serialize());
+    ASSERT_EQ(report["slowest"].size(), slowest.size());
+    EXPECT_EQ(report["slowest"][0]["entity"].get<std::uint32_t>(), slowest[0].entityId);
+    EXPECT_EQ(report["slowest"][0]["reason"].get<std::string>(), AgentProfiler::describe(slowest[0]));
+}
+
+TEST_F(StressScenarioTest, SharedMemoryStatsMatchSerialRun) {
+    // Agents remember into the shared store while thinking in parallel; each
+    // block keeps its own counters, so the totals match a serial run. Fixed
+    // steps take the path queue off its wall-clock budget, so both runs
+    // search the same amount per frame.
+    CoordinationConfig coordination;
+    coordination.deterministic.enabled = true;
+    CoordinationConfig threaded = coordination;
+    threaded.workerThreads = 4;
+    World serial(config(13), coordination);
+    World parallel(config(13), threaded);
+    for (int frame = 0; frame < 120; ++frame) {
+        serial.manager.updateAll(1.0f / 60.0f, &serial.entityManager, &serial.collisionManager);
+        parallel.manager.updateAll(1.0f / 60.0f, &parallel.entityManager, &parallel.collisionManager);
+    }
+    
+    PerceptionMemory::Stats expected = serial.manager.getPerceptionMemory().getStats();
+    PerceptionMemory::Stats actual = parallel.manager.getPerceptionMemory().getStats();
+    EXPECT_GT(expected.remembered, 0);
+    EXPECT_EQ(expected.remembered, actual.remembered);
+    EXPECT_EQ(expected.refreshed, actual.refreshed);
+    EXPECT_EQ(expected.overwritten, actual.overwritten);
+}
+
+TEST_F(StressScenarioTest, FixedStepRunsHashTheSameState) {
+    CoordinationConfig coordination;
+    coordination.deterministic.enabled = true;
+    coordination.deterministic.hashHistory = 1000;
+    CoordinationConfig threaded = coordination;
+    threaded.workerThreads = 2;
+    
+    // Same ticks from uneven frames on one thread and even frames on two
+    World uneven(config(11), coordination);
+    World even(config(11), threaded);
+    World nudged(config(11), coordination);
+    const float frames[] = {0.010f, 0.030f, 0.010f};    // Three ticks per cycle
+    for (int cycle = 0; cycle < 30; ++cycle) {
+        for (float dt : frames) {
+            uneven.manager.updateAll(dt, &uneven.entityManager, &uneven.collisionManager);
+        }
+    }
+    const float tick = coordination.deterministic.fixedTimeStep;
+    for (int frame = 0; frame < 90; ++frame) {
+        even.manager.updateAll(tick, &even.entityManager, &even.collisionManager);
+        if (frame == 40) {
+            StressAgent* agent = nudged.scenario.getAgents()[0];
+            agent->setPosition(agent->position() + sf::Vector2f(5.0f, 0.0f));
+        }
+        nudged.manager.updateAll(tick, &nudged.entityManager, &nudged.collisionManager);
+    }
+    
+    const auto& reference = uneven.manager.getStateHashes();
+    ASSERT_EQ(reference.size(), 90u);
+    EXPECT_EQ(uneven.manager.getFixedStepClock().steps(), 90u);
+    EXPECT_EQ(reference.back().step, 90u);
+    EXPECT_NE(reference.front().hash, reference.back().hash);
+    EXPECT_EQ(firstDivergentStep(reference, even.manager.getStateHashes()), -1);
+    EXPECT_EQ(uneven.manager.getStateHash(), even.manager.getStateHash());
+    
+    // The first tick after the nudge is the first one to differ
+    EXPECT_EQ(firstDivergentStep(reference, nudged.manager.getStateHashes()), 41);
+}
+
+TEST(DeterministicStepTest, StateHashCoversPipelineEnemies) {
+    CoordinationConfig coordination;
+    coordination.deterministic.enabled = true;
+    AIManager reference(coordination);
+    AIManager nudged(coordination);
+    const std::vector<sf::Vector2f> patrol = {{100.f, 100.f}, {200.f, 100.f}};
+    Enemy referenceEnemy(1, {100.f, 100.f}, {32.f, 32.f}, 100.f, 200.f, 24.f, patrol);
+    Enemy nudgedEnemy(1, {100.f, 100.f}, {32.f, 32.f}, 100.f, 200.f, 24.f, patrol);
+    reference.addEnemyPointer(&referenceEnemy);
+    nudged.addEnemyPointer(&nudgedEnemy);
+    
+    const float tick = coordination.deterministic.fixedTimeStep;
+    for (int frame = 0; frame < 20; ++frame) {
+        reference.updateAll(tick, nullptr, nullptr);
+        if (frame == 10) nudgedEnemy.setPosition(nudgedEnemy.position() + sf::Vector2f(5.0f, 0.0f));
+        nudged.updateAll(tick, nullptr, nullptr);
+    }
+    
+    // No agents at all, so only the enemy's state can tell the runs apart
+    ASSERT_EQ(reference.getStateHashes().size(), 20u);
+    EXPECT_EQ(firstDivergentStep(reference.getStateHashes(), nudged.getStateHashes()), 11);
+}
+
+TEST(DeterministicStepTest, FixedStepClockCapsCatchUp) {
+    DeterministicConfig deterministic;
+    deterministic.fixedTimeStep = 0.02f;
+    deterministic.maxStepsPerUpdate = 3;
+    FixedStepClock clock(deterministic);
+    
+    EXPECT_EQ(clock.advance(0.02f), 1);
+    EXPECT_EQ(clock.advance(0.015f), 0);
+    EXPECT_EQ(clock.advance(0.015f), 1);     // 0.01 carried over
+    EXPECT_EQ(clock.advance(1.0f), 3);       // A hitch runs at most three ticks
+    EXPECT_GT(clock.droppedTime(), 0.9);
+    EXPECT_EQ(clock.advance(0.01f), 1);      // Only the sub-tick remainder survived
+    EXPECT_EQ(clock.steps(), 6u);
+}
+
 } // namespace test
 } // namespace ai
@@ -0,0 +1,435 @@
+// Pathfinding benchmark: deterministic synthetic maps, fixed query sets.
+// Not registered with CTest; run manually and diff the CSV between builds.
+//
+//   PathfindingBenchmark [--quick] [--repeats N] [--queries N] [--csv results.csv]
+//
+// For smoothPath the "expansions" column is the number of input waypoints.
+
+#include "ai/Pathfinding.h"
+#include "ai/NavGrid.h"
+#include "ai/NavMesh.h"
+#include "collisions/CollisionManager.h"
+#include "entities/Entity.h"
+#include "core/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Global allocation counter (every operator new in the process goes through here)
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr float kCellSize = 32.0f;
+constexpr std::uint32_t kSeed = 0xA55A1u;
+
+class BenchWall : public entities::Entity {
+public:
+    BenchWall(Id id, const sf::Vector2f& position, const sf::Vector2f& size)
+        : Entity(id, position, size) {
+        setCollisionLayer(Layer::Wall);
+    }
+    void update(float) override {}
+    void render(sf::RenderWindow&) override {}
+};
+
+// std::mt19937 output is fixed by the standard; distributions are not, so
+// derive integers with modulo to keep maps identical across toolchains
+int randomInt(std::mt19937& rng, int bound) {
+    return static_cast<int>(rng() % static_cast<std::uint32_t>(bound));
+}
+
+struct BenchMap {
+    std::string name;
+    int size = 0;
+    std::vector<std::uint8_t> walls; // size * size, 1 = wall
+    std::vector<std::pair<sf::Vector2i, sf::Vector2i>> queries;
+
+    bool isWall(int x, int y) const {
+        return x < 0 || y < 0 || x >= size || y >= size || walls[y * size + x] != 0;
+    }
+    void setWall(int x, int y, bool wall) {
+        if (x >= 0 && y >= 0 && x < size && y < size) walls[y * size + x] = wall ? 1 : 0;
+    }
+};
+
+BenchMap makeEmpty(const std::string& name, int size) {
+    BenchMap map;
+    map.name = name;
+    map.size = size;
+    map.walls.assign(static_cast<std::size_t>(size) * size, 0);
+    for (int i = 0; i < size; ++i) {
+        map.setWall(i, 0, true);
+        map.setWall(i, size - 1, true);
+        map.setWall(0, i, true);
+        map.setWall(size - 1, i, true);
+    }
+    return map;
+}
+
+// Border walls plus sparse single-cell pillars
+BenchMap generateOpenField(int size, std::mt19937& rng) {
+    BenchMap map = makeEmpty("open_field", size);
+    for (int y = 2; y < size - 2; ++y) {
+        for (int x = 2; x < size - 2; ++x) {
+            if (randomInt(rng, 100) < 3) map.setWall(x, y, true);
+        }
+    }
+    return map;
+}
+
+// 8x8 rooms with a two-cell door in every shared wall
+BenchMap generateRooms(int size, std::mt19937& rng) {
+    constexpr int kRoom = 8;
+    BenchMap map = makeEmpty("rooms", size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            if (x % kRoom == 0 || y % kRoom == 0) map.setWall(x, y, true);
+        }
+    }
+    for (int roomY = 0; roomY + kRoom < size; roomY += kRoom) {
+        for (int roomX = 0; roomX + kRoom < size; roomX += kRoom) {
+            // Door in the right wall and in the bottom wall of this room
+            int doorY = roomY + 1 + randomInt(rng, kRoom - 2);
+            int doorX = roomX + 1 + randomInt(rng, kRoom - 2);
+            if (roomX + kRoom < size - 1) {
+                map.setWall(roomX + kRoom, doorY, false);
+                map.setWall(roomX + kRoom, std::min(doorY + 1, roomY + kRoom - 1), false);
+            }
+            if (roomY + kRoom < size - 1) {
+                map.setWall(doorX, roomY + kRoom, false);
+                map.setWall(std::min(doorX + 1, roomX + kRoom - 1), roomY + kRoom, false);
+            }
+        }
+    }
+    return map;
+}
+
+// Perfect maze (iterative recursive backtracker on odd cells)
+BenchMap generateMaze(int size, std::mt19937& rng) {
+    BenchMap map = makeEmpty("maze", size);
+    std::fill(map.walls.begin(), map.walls.end(), 1);
+
+    std::vector<sf::Vector2i> stack{{1, 1}};
+    map.setWall(1, 1, false);
+    const sf::Vector2i directions[4] = {{2, 0}, {-2, 0}, {0, 2}, {0, -2}};
+    while (!stack.empty()) {
+        sf::Vector2i cell = stack.back();
+        int order[4] = {0, 1, 2, 3};
+        for (int i = 3; i > 0; --i) std::swap(order[i], order[randomInt(rng, i + 1)]);
+
+        bool carved = false;
+        for (int i : order) {
+            sf::Vector2i next = cell + directions[i];
+            if (next.x <= 0 || next.y <= 0 || next.x >= size - 1 || next.y >= size - 1) continue;
+            if (!map.isWall(next.x, next.y)) continue;
+            map.setWall(cell.x + directions[i].x / 2, cell.y + directions[i].y / 2, false);
+            map.setWall(next.x, next.y, false);
+            stack.push_back(next);
+            carved = true;
+            break;
+        }
+        if (!carved) stack.pop_back();
+    }
+    return map;
+}
+
+// Concentric rings with alternating openings: the route walks every ring
+BenchMap generateSpiral(int size) {
+    BenchMap map = makeEmpty("spiral", size);
+    for (int ring = 1; 2 * ring < size / 2 - 1; ++ring) {
+        int lo = 2 * ring;
+        int hi = size - 1 - 2 * ring;
+        if (hi - lo < 2) break;
+        for (int i = lo; i <= hi; ++i) {
+            map.setWall(i, lo, true);
+            map.setWall(i, hi, true);
+            map.setWall(lo, i, true);
+            map.setWall(hi, i, true);
+        }
+        if (ring % 2) {
+            map.setWall(lo + 1, lo, false);
+        } else {
+            map.setWall(hi - 1, hi, false);
+        }
+    }
+    return map;
+}
+
+sf::Vector2i randomFreeCell(const BenchMap& map, std::mt19937& rng) {
+    for (int attempt = 0; attempt < 10000; ++attempt) {
+        sf::Vector2i cell(randomInt(rng, map.size), randomInt(rng, map.size));
+        if (!map.isWall(cell.x, cell.y)) return cell;
+    }
+    return {1, 1};
+}
+
+void addQueries(BenchMap& map, std::mt19937& rng, int count) {
+    for (int i = 0; i < count; ++i) {
+        map.queries.emplace_back(randomFreeCell(map, rng), randomFreeCell(map, rng));
+    }
+}
+
+sf::Vector2f cellCenter(const sf::Vector2i& cell) {
+    return sf::Vector2f((cell.x + 0.5f) * kCellSize, (cell.y + 0.5f) * kCellSize);
+}
+
+// Level geometry: horizontal wall runs merged into one collider each
+struct BenchWorld {
+    std::vector<std::unique_ptr<BenchWall>> walls;
+    collisions::CollisionManager collisions;
+    ai::NavGrid grid;
+    ai::NavMesh mesh;
+
+    explicit BenchWorld(const BenchMap& map) {
+        core::Logger::instance().enableConsole(false);
+        entities::Entity::Id nextId = 1;
+        for (int y = 0; y < map.size; ++y) {
+            for (int x = 0; x < map.size;) {
+                if (!map.isWall(x, y)) { ++x; continue; }
+                int end = x;
+                while (end < map.size && map.isWall(end, y)) ++end;
+                sf::Vector2f position(x * kCellSize, y * kCellSize);
+                sf::Vector2f size((end - x) * kCellSize, kCellSize);
+                walls.push_back(std::make_unique<BenchWall>(nextId++, position, size));
+                collisions.addCollider(walls.back().get(), sf::FloatRect(position, size));
+                x = end;
+            }
+        }
+
+        sf::FloatRect bounds({0.f, 0.f}, {map.size * kCellSize, map.size * kCellSize});
+        ai::NavGridConfig gridConfig;
+        gridConfig.cellSize = kCellSize;
+        gridConfig.bounds = bounds;
+        grid.rebuild(&collisions, gridConfig);
+
+        ai::NavMeshConfig meshConfig;
+        meshConfig.bounds = bounds;
+        meshConfig.agentRadius = 8.0f;
+        mesh.build(&collisions, meshConfig);
+    }
+};
+
+struct Measurement {
+    int successes = 0;
+    long long expansions = 0;
+    double microseconds = 0.0;   // Sum over queries of the fastest repeat
+    std::size_t allocations = 0; // Sum over queries (first repeat)
+};
+
+struct QueryOutcome {
+    bool success = false;
+    int expansions = 0;
+};
+
+Measurement measure(const BenchMap& map, int repeats,
+                    const std::function<QueryOutcome(const sf::Vector2f&, const sf::Vector2f&)>& query) {
+    using clock = std::chrono::steady_clock;
+    Measurement m;
+    for (const auto& q : map.queries) {
+        sf::Vector2f start = cellCenter(q.first);
+        sf::Vector2f goal = cellCenter(q.second);
+
+        double best = 0.0;
+        for (int r = 0; r < repeats; ++r) {
+            std::size_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+            auto begin = clock::now();
+            QueryOutcome outcome = query(start, goal);
+            auto end = clock::now();
+            std::size_t allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+            double us = std::chrono::duration<double, std::micro>(end - begin).count();
+            if (r == 0) {
+                best = us;
+                m.successes += outcome.success ? 1 : 0;
+                m.expansions += outcome.expansions;
+                m.allocations += allocations;
+            } else {
+                best = std::min(best, us);
+            }
+        }
+        m.microseconds += best;
+    }
+    return m;
+}
+
+struct Row {
+    std::string map;
+    int size;
+    std::string method;
+    int queries;
+    Measurement m;
+};
+
+void runMap(const BenchMap& map, int repeats, std::vector<Row>& rows) {
+    BenchWorld world(map);
+    ai::PathfindingConfig config;
+    config.gridSize = kCellSize;
+    config.maxIterations = 1 << 20;
+    config.maxPathLength = map.size * kCellSize * 4.0f;
+    config.obstacleLayerMask = entities::kLayerMaskWall;
+
+    auto add = [&](const std::string& method, const Measurement& m) {
+        rows.push_back({map.name, map.size, method, static_cast<int>(map.queries.size()), m});
+    };
+
+    ai::PathfindingSystem colliderSearch(config);
+    add("findPath", measure(map, repeats, [&](const sf::Vector2f& a, const sf::Vector2f& b) {
+        auto result = colliderSearch.findPath(a, b, &world.collisions);
+        return QueryOutcome{result.success, result.iterations};
+    }));
+
+    add("findSimplePath", measure(map, repeats, [&](const sf::Vector2f& a, const sf::Vector2f& b) {
+        auto path = colliderSearch.findSimplePath(a, b, &world.collisions);
+        return QueryOutcome{path.size() >= 2, 0};
+    }));
+
+    // smoothPath over the dense grid route of each query (route built outside the timer)
+    ai::PathfindingConfig denseConfig = config;
+    denseConfig.anyAngle = false;
+    std::vector<std::vector<sf::Vector2f>> denseRoutes;
+    ai::GridPathSearch denseSearch;
+    for (const auto& q : map.queries) {
+        denseSearch.begin(world.grid, cellCenter(q.first), cellCenter(q.second), denseConfig);
+        while (!denseSearch.finished()) denseSearch.step(denseConfig.maxIterations);
+        std::vector<sf::Vector2f> route;
+        for (int cell : denseSearch.pathCells()) {
+            sf::Vector2i pos = world.grid.cellFromIndex(cell);
+            route.push_back(world.grid.cellToWorld(pos.x, pos.y));
+        }
+        denseRoutes.push_back(std::move(route));
+    }
+    std::size_t routeIndex = 0;
+    add("smoothPath", measure(map, repeats, [&](const sf::Vector2f&, const sf::Vector2f&) {
+        const auto& route = denseRoutes[routeIndex / repeats];
+        ++routeIndex;
+        auto smoothed = colliderSearch.smoothPath(route, &world.collisions);
+        return QueryOutcome{!smoothed.empty(), static_cast<int>(route.size())};
+    }));
+
+    ai::PathfindingSystem gridSearch(denseConfig);
+    add("grid_astar", measure(map, repeats, [&](const sf::Vector2f& a, const sf::Vector2f& b) {
+        auto result = gridSearch.findPath(a, b, world.grid);
+        return QueryOutcome{result.success, result.iterations};
+    }));
+
+    ai::PathfindingSystem thetaSearch(config);
+    add("grid_lazy_theta", measure(map, repeats, [&](const sf::Vector2f& a, const sf::Vector2f& b) {
+        auto result = thetaSearch.findPath(a, b, world.grid);
+        return QueryOutcome{result.success, result.iterations};
+    }));
+
+    add("navmesh", measure(map, repeats, [&](const sf::Vector2f& a, const sf::Vector2f& b) {
+        auto result = world.mesh.findPath(a, b);
+        return QueryOutcome{result.success, result.iterations};
+    }));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    int repeats = 3;
+    int queryCount = 16;
+    std::string csvPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            queryCount = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--repeats N] [--queries N] [--csv file]\n";
+            return 1;
+        }
+    }
+
+    std::vector<int> sizes = quick ? std::vector<int>{33} : std::vector<int>{33, 65, 129};
+    std::vector<Row> rows;
+    for (int size : sizes) {
+        // Each map gets its own stream so adding a generator never shifts the others
+        std::mt19937 fieldRng(kSeed + 1);
+        std::mt19937 roomsRng(kSeed + 2);
+        std::mt19937 mazeRng(kSeed + 3);
+        std::mt19937 spiralRng(kSeed + 4);
+
+        std::vector<BenchMap> maps;
+        maps.push_back(generateOpenField(size, fieldRng));
+        maps.push_back(generateRooms(size, roomsRng));
+        maps.push_back(generateMaze(size, mazeRng));
+        maps.push_back(generateSpiral(size));
+
+        addQueries(maps[0], fieldRng, queryCount);
+        addQueries(maps[1], roomsRng, queryCount);
+        addQueries(maps[2], mazeRng, queryCount);
+        // Spiral worst case first: outer corner to the center
+        maps[3].queries.emplace_back(sf::Vector2i(1, 1), sf::Vector2i(size / 2, size / 2));
+        addQueries(maps[3], spiralRng, queryCount - 1);
+
+        for (const auto& map : maps) {
+            runMap(map, repeats, rows);
+        }
+    }
+
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+    std::printf("Pathfinding benchmark (seed 0x%X, %d repeats, %s build)\n", kSeed, repeats, buildType);
+    std::printf("%-11s %5s %-16s %9s %14s %12s %14s\n",
+                "map", "size", "method", "ok", "expansions/q", "us/q", "allocs/q");
+    for (const auto& row : rows) {
+        double n = static_cast<double>(row.queries);
+        std::printf("%-11s %5d %-16s %4d/%-4d %14.1f %12.2f %14.1f\n",
+                    row.map.c_str(), row.size, row.method.c_str(), row.m.successes, row.queries,
+                    row.m.expansions / n, row.m.microseconds / n, row.m.allocations / n);
+    }
+
+    if (!csvPath.empty()) {
+        std::ofstream csv(csvPath);
+        if (!csv.good()) {
+            std::cerr << "cannot write " << csvPath << "\n";
+            return 1;
+        }
+        csv << "map,size,method,queries,successes,expansions_per_query,us_per_query,allocs_per_query\n";
+        for (const auto& row : rows) {
+            double n = static_cast<double>(row.queries);
+            csv << row.map << ',' << row.size << ',' << row.method << ',' << row.queries << ','
+                << row.m.successes << ',' << row.m.expansions / n << ',' << row.m.microseconds / n << ','
+                << row.m.allocations / n << '\n';
+        }
+    }
+    return 0;
+}